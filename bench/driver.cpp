@@ -0,0 +1,351 @@
+// Runs the microprograms of bench/programs natively and in the sandbox, and prints
+// one JSON object per line for every program and configuration.
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include <boost/program_options.hpp>
+
+#include <Cgroup.hpp>
+#include <Invoker.hpp>
+#include <InvokerConfig.hpp>
+#include <InvokerProfile.hpp>
+
+namespace po = boost::program_options;
+
+namespace {
+
+struct Benchmark {
+    const char *name;
+    // what one iteration is, for the throughput
+    const char *unit;
+    long iterations;
+};
+
+// exit has a single iteration: the run is all spawning
+const Benchmark BENCHMARKS[] = {
+    { "exit", "run", 1 },
+    { "getpid", "syscall", 100000 },
+    { "write", "syscall", 100000 },
+    { "open", "open", 10000 },
+    { "fork", "process", 500 },
+    { "threads", "thread", 1000 },
+};
+
+struct Mode {
+    // empty for a native run
+    std::string invoker;
+    std::string profile;
+    bool seccomp = true;
+};
+
+struct Sample {
+    double wall = 0;
+    double spawnLatency = -1;
+    std::string verdict;
+};
+
+struct Measurement {
+    std::vector<Sample> samples;
+    // of the fastest run
+    std::string verdict;
+
+    double best() const {
+        double best = -1;
+        for (const Sample &sample : samples) {
+            if (best < 0 || sample.wall < best) {
+                best = sample.wall;
+            }
+        }
+        return best;
+    }
+
+    double median() const {
+        std::vector<double> walls;
+        for (const Sample &sample : samples) {
+            walls.push_back(sample.wall);
+        }
+        std::sort(walls.begin(), walls.end());
+        return walls.empty() ? -1 : walls[walls.size() / 2];
+    }
+
+    // of the runs reporting one, quantile in [0, 1]
+    double spawnLatency(double quantile) const {
+        std::vector<double> latencies;
+        for (const Sample &sample : samples) {
+            if (sample.spawnLatency >= 0) {
+                latencies.push_back(sample.spawnLatency);
+            }
+        }
+        std::sort(latencies.begin(), latencies.end());
+        if (latencies.empty()) {
+            return -1;
+        }
+        return latencies[std::min(latencies.size() - 1, (size_t)(quantile * latencies.size()))];
+    }
+};
+
+double now() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+std::string jsonString(const std::string &text) {
+    std::string out = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+        }
+        out += c;
+    }
+    return out + "\"";
+}
+
+std::string jsonNumber(double value) {
+    if (value < 0) {
+        return "null";
+    }
+    std::ostringstream out;
+    out.precision(9);
+    out << value;
+    return out.str();
+}
+
+Sample runNative(const std::vector<std::string> &args, int devnull) {
+    std::vector<char*> argv;
+    for (const std::string &arg : args) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    Sample sample;
+    double started = now();
+    pid_t pid = fork();
+    if (pid < 0) {
+        throw std::runtime_error(std::string("fork() failed: ") + strerror(errno));
+    }
+    if (pid == 0) {
+        dup2(devnull, 0);
+        dup2(devnull, 1);
+        dup2(devnull, 2);
+        execv(argv[0], argv.data());
+        _exit(127);
+    }
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+    }
+    sample.wall = now() - started;
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        sample.verdict = "RE";
+    }
+    return sample;
+}
+
+std::string verdictOf(const InvokerResult &result) {
+    if (result.error != 0) {
+        return "error: " + result.errorMessage;
+    }
+    if (result.securityViolation) {
+        return "SV";
+    }
+    if (result.timeLimitExceeded) {
+        return "TL";
+    }
+    if (result.memoryLimitExceeded) {
+        return "ML";
+    }
+    if (result.wallLimitExceeded) {
+        return "RL";
+    }
+    return result.exitCode != 0 ? "RE" : "";
+}
+
+Measurement measure(const Mode &mode, const std::vector<std::string> &args, int runs,
+                    const std::string &cgroupRoot, int poolSize, int devnull) {
+    Measurement measurement;
+    if (mode.invoker.empty()) {
+        for (int i = 0; i < runs; ++i) {
+            measurement.samples.push_back(runNative(args, devnull));
+        }
+    } else {
+        InvokerConfig config(InvokerProfile::getProfile(mode.profile));
+        config.exe = args[0];
+        config.args = args;
+        config.stdin_fd = devnull;
+        config.stdout_fd = devnull;
+        config.stderr_fd = devnull;
+        config.seccomp = mode.seccomp;
+        config.wallLimit = 60;
+        config.poolSize = poolSize;
+        if (mode.invoker == "cgroup" || (mode.invoker != "ptrace" && config.maxProcesses() > 0)) {
+            // only a cgroup limits the processes of a program without a tracer
+            config.cgroupRoot = cgroupRoot;
+        }
+
+        // runs share the invoker, as the tests of a batch do
+        std::unique_ptr<Invoker> invoker(Invoker::makeInvoker(mode.invoker, "x86_64", config));
+        for (int i = 0; i < runs; ++i) {
+            Sample sample;
+            double started = now();
+            invoker->run();
+            sample.wall = now() - started;
+            sample.spawnLatency = invoker->getResult().spawnLatency;
+            sample.verdict = verdictOf(invoker->getResult());
+            measurement.samples.push_back(sample);
+        }
+    }
+
+    double best = measurement.best();
+    for (const Sample &sample : measurement.samples) {
+        if (sample.wall == best) {
+            measurement.verdict = sample.verdict;
+        }
+    }
+    for (const Sample &sample : measurement.samples) {
+        if (!sample.verdict.empty()) {
+            // a run that failed makes all of them worthless
+            measurement.verdict = sample.verdict;
+        }
+    }
+    return measurement;
+}
+
+}
+
+int main(int argc, char **argv) {
+    std::string programs = ".";
+    std::string openPath = "/usr/share/zoneinfo/America/Argentina/Buenos_Aires";
+    std::string cgroupRoot;
+    int runs = 5;
+    int poolSize = 0;
+    double scale = 1.0;
+    std::vector<std::string> profiles, invokers, only;
+
+    po::options_description desc("Allowed options");
+    desc.add_options()
+            ("help,h", "Show help message")
+            ("programs", po::value<std::string>(&programs), "Directory of the bench_* programs")
+            ("runs,n", po::value<int>(&runs), "Runs of every program in every configuration, the fastest counts")
+            ("scale", po::value<double>(&scale), "Multiply the iterations of every program by this")
+            ("benchmark,B", po::value<std::vector<std::string>>(&only), "Only run these programs")
+            ("profile,P", po::value<std::vector<std::string>>(&profiles),
+                    "Profiles to run the programs with (default: linux_nosecurity, linux_runtime)")
+            ("invoker,I", po::value<std::vector<std::string>>(&invokers),
+                    "Invokers to run the programs with (default: ptrace, seccomp, namespace, and cgroup if cgroup v2 is mounted)")
+            ("cgroup", po::value<std::string>(&cgroupRoot), "cgroup v2 directory for the cgroup invoker")
+            ("pool", po::value<int>(&poolSize), "Tracees the ptrace invoker keeps ready for its next runs")
+            ("open-path", po::value<std::string>(&openPath), "File the open benchmark opens");
+
+    po::variables_map vm;
+    try {
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+    } catch (po::error &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    if (vm.count("help") || runs <= 0 || scale <= 0 || poolSize < 0) {
+        std::cerr << "Usage: " << argv[0] << " [options]" << std::endl << std::endl << desc << std::endl;
+        return 1;
+    }
+
+    if (profiles.empty()) {
+        profiles = { "linux_nosecurity", "linux_runtime" };
+    }
+    if (cgroupRoot.empty()) {
+        cgroupRoot = Cgroup::defaultRoot();
+    }
+    if (invokers.empty()) {
+        invokers.push_back("ptrace");
+        invokers.push_back("seccomp");
+        invokers.push_back("namespace");
+        if (!cgroupRoot.empty()) {
+            invokers.push_back("cgroup");
+        }
+    }
+
+    std::vector<Mode> modes(1);
+    for (const std::string &invoker : invokers) {
+        for (const std::string &profile : profiles) {
+            Mode mode;
+            mode.invoker = invoker;
+            mode.profile = profile;
+            modes.push_back(mode);
+            if (invoker == "ptrace") {
+                // every syscall stopping in the tracer, the fallback without seccomp
+                mode.seccomp = false;
+                modes.push_back(mode);
+            }
+        }
+    }
+
+    int devnull = open("/dev/null", O_RDWR | O_CLOEXEC);
+    if (devnull < 0) {
+        std::cerr << "Failed to open /dev/null: " << strerror(errno) << std::endl;
+        return 1;
+    }
+
+    try {
+        for (const Benchmark &benchmark : BENCHMARKS) {
+            if (!only.empty() && std::find(only.begin(), only.end(), benchmark.name) == only.end()) {
+                continue;
+            }
+            long iterations = std::max(1L, (long)(benchmark.iterations * scale));
+            if (benchmark.iterations == 1) {
+                iterations = 1;
+            }
+            std::vector<std::string> args = { programs + "/bench_" + benchmark.name, std::to_string(iterations) };
+            if (std::string(benchmark.name) == "open") {
+                args.push_back(openPath);
+            }
+
+            double native = -1;
+            for (const Mode &mode : modes) {
+                Measurement measurement = measure(mode, args, runs, cgroupRoot, poolSize, devnull);
+                double best = measurement.best();
+                bool ok = measurement.verdict.empty();
+                if (mode.invoker.empty() && ok) {
+                    native = best;
+                }
+
+                std::cout << "{\"benchmark\": " << jsonString(benchmark.name)
+                          << ", \"invoker\": " << jsonString(mode.invoker.empty() ? "native" : mode.invoker)
+                          << ", \"profile\": " << (mode.invoker.empty() ? "null" : jsonString(mode.profile))
+                          << ", \"seccomp\": " << (mode.invoker.empty() ? "null" : mode.seccomp ? "true" : "false")
+                          << ", \"iterations\": " << iterations
+                          << ", \"unit\": " << jsonString(benchmark.unit)
+                          << ", \"runs\": " << runs
+                          << ", \"verdict\": " << (ok ? "null" : jsonString(measurement.verdict))
+                          << ", \"wall_best\": " << jsonNumber(ok ? best : -1)
+                          << ", \"wall_median\": " << jsonNumber(ok ? measurement.median() : -1)
+                          << ", \"throughput\": " << jsonNumber(ok && best > 0 ? iterations / best : -1)
+                          << ", \"overhead_per_iteration\": "
+                          << jsonNumber(ok && native >= 0 && !mode.invoker.empty()
+                                        ? std::max(0.0, best - native) / iterations : -1)
+                          << ", \"spawn_latency\": " << jsonNumber(ok ? measurement.spawnLatency(0.5) : -1)
+                          << ", \"spawn_latency_p90\": " << jsonNumber(ok ? measurement.spawnLatency(0.9) : -1)
+                          << ", \"spawn_latency_p99\": " << jsonNumber(ok ? measurement.spawnLatency(0.99) : -1)
+                          << "}" << std::endl;
+            }
+        }
+    } catch (std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    close(devnull);
+    return 0;
+}
@@ -0,0 +1,4 @@
+// Does nothing, for the spawn latency of a sandbox
+int main() {
+    return 0;
+}
@@ -0,0 +1,22 @@
+// Starts and reaps short-lived processes, each one is attached to and followed by the tracer
+#include <cstdlib>
+#include <unistd.h>
+#include <sys/wait.h>
+
+int main(int argc, char **argv) {
+    long iterations = argc > 1 ? atol(argv[1]) : 1000;
+    for (long i = 0; i < iterations; ++i) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            return 1;
+        }
+        if (pid == 0) {
+            _exit(0);
+        }
+        int status;
+        if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status)) {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,13 @@
+// The cheapest syscall in a loop: what a stop in the tracer costs on top of it
+#include <cstdlib>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+int main(int argc, char **argv) {
+    long iterations = argc > 1 ? atol(argv[1]) : 100000;
+    for (long i = 0; i < iterations; ++i) {
+        // glibc does not cache it, but be sure the kernel is entered
+        syscall(SYS_getpid);
+    }
+    return 0;
+}
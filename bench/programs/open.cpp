@@ -0,0 +1,17 @@
+// Opens a file by a long path over and over, every open is read and checked by the tracer
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+
+int main(int argc, char **argv) {
+    long iterations = argc > 1 ? atol(argv[1]) : 10000;
+    const char *path = argc > 2 ? argv[2] : "/usr/share/zoneinfo/America/Argentina/Buenos_Aires";
+    for (long i = 0; i < iterations; ++i) {
+        int fd = open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return 1;
+        }
+        close(fd);
+    }
+    return 0;
+}
@@ -0,0 +1,29 @@
+// Starts and joins threads in batches, each one is attached to and followed by the tracer
+#include <cstdlib>
+#include <pthread.h>
+
+namespace {
+
+void *work(void *arg) {
+    return arg;
+}
+
+}
+
+int main(int argc, char **argv) {
+    long iterations = argc > 1 ? atol(argv[1]) : 1000;
+    const long batch = 8;
+    pthread_t threads[batch];
+    for (long i = 0; i < iterations; i += batch) {
+        long count = iterations - i < batch ? iterations - i : batch;
+        for (long j = 0; j < count; ++j) {
+            if (pthread_create(&threads[j], nullptr, work, nullptr) != 0) {
+                return 1;
+            }
+        }
+        for (long j = 0; j < count; ++j) {
+            pthread_join(threads[j], nullptr);
+        }
+    }
+    return 0;
+}
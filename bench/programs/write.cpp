@@ -0,0 +1,13 @@
+// Unbuffered output one byte at a time, as naive solutions print
+#include <cstdlib>
+#include <unistd.h>
+
+int main(int argc, char **argv) {
+    long iterations = argc > 1 ? atol(argv[1]) : 100000;
+    for (long i = 0; i < iterations; ++i) {
+        if (write(1, "x", 1) != 1) {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include "BatchManifest.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+template<typename T>
+bool parseField(std::istringstream &line, T &value) {
+    std::string field;
+    if (!(line >> field) || field == "-") {
+        return true;
+    }
+    std::istringstream buf(field);
+    return (buf >> value) && buf.eof();
+}
+
+}
+
+BatchManifest BatchManifest::load(const std::string &filename) {
+    std::ifstream file(filename);
+    if (!file) {
+        throw std::invalid_argument("Failed to open manifest '" + filename + "'");
+    }
+
+    BatchManifest manifest;
+    std::string text;
+    int lineNumber = 0;
+    while (std::getline(file, text)) {
+        ++lineNumber;
+        std::istringstream line(text);
+        BatchTest test;
+
+        if (!(line >> test.input) || test.input[0] == '#') {
+            continue;
+        }
+
+        bool ok = static_cast<bool>(line >> test.output);
+        ok = ok && parseField(line, test.timeLimit);
+        ok = ok && parseField(line, test.memoryLimit);
+        ok = ok && parseField(line, test.wallLimit);
+
+        std::string extra;
+        if (!ok || (line >> extra)) {
+            std::stringstream buf;
+            buf << "Invalid test in manifest '" << filename << "' on line " << lineNumber;
+            throw std::invalid_argument(buf.str());
+        }
+
+        if (test.memoryLimit > 0) {
+            test.memoryLimit *= 1024 * 1024;
+        }
+
+        manifest.tests.push_back(test);
+    }
+
+    return manifest;
+}
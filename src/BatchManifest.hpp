@@ -0,0 +1,29 @@
+#ifndef INVOKE_BATCHMANIFEST_HPP
+#define INVOKE_BATCHMANIFEST_HPP
+
+#include <string>
+#include <vector>
+
+struct BatchTest {
+    std::string input;
+    std::string output;
+
+    // negative values mean "use the limit from the command line"
+    double timeLimit = -1;
+    long memoryLimit = -1;
+    double wallLimit = -1;
+};
+
+// Manifest is a text file with one test per line:
+//   <input> <output> [time-limit [memory-limit [wall-limit]]]
+// Memory limit is in megabytes, '-' keeps the default value of a field
+// and lines starting with '#' are ignored.
+class BatchManifest {
+public:
+    std::vector<BatchTest> tests;
+
+    static BatchManifest load(const std::string &filename);
+};
+
+
+#endif //INVOKE_BATCHMANIFEST_HPP
@@ -0,0 +1,166 @@
+#include "Cgroup.hpp"
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+namespace {
+
+std::string findMount() {
+    std::ifstream mounts("/proc/self/mounts");
+    std::string line;
+    while (std::getline(mounts, line)) {
+        std::istringstream buf(line);
+        std::string device, dir, type;
+        if (buf >> device >> dir >> type && type == "cgroup2") {
+            return dir;
+        }
+    }
+    return std::string();
+}
+
+void enableControllers(const std::string &dir) {
+    int fd = open((dir + "/cgroup.subtree_control").c_str(), O_WRONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return;
+    }
+    // one at a time, so that a missing controller does not disable the rest
+    for (const char *controller : { "+memory", "+pids", "+cpu" }) {
+        write(fd, controller, strlen(controller));
+    }
+    close(fd);
+}
+
+}
+
+std::string Cgroup::defaultRoot() {
+    std::string mount = findMount();
+    if (mount.empty()) {
+        return mount;
+    }
+    return mount + "/invoke";
+}
+
+bool Cgroup::writeFile(const std::string &name, const std::string &value) const {
+    int fd = open((path + "/" + name).c_str(), O_WRONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = write(fd, value.c_str(), value.size()) == (ssize_t)value.size();
+    int err = errno;
+    close(fd);
+    errno = err;
+    return ok;
+}
+
+long Cgroup::readKey(const std::string &name, const std::string &key) const {
+    std::ifstream file(path + "/" + name);
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream buf(line);
+        std::string k;
+        long value;
+        if (key.empty()) {
+            if (buf >> value) {
+                return value;
+            }
+        } else if (buf >> k >> value && k == key) {
+            return value;
+        }
+    }
+    return -1;
+}
+
+bool Cgroup::create(const std::string &root) {
+    static unsigned counter = 0;
+
+    if (mkdir(root.c_str(), 0755) == -1 && errno != EEXIST) {
+        return false;
+    }
+    std::string parent = root.substr(0, root.find_last_of('/'));
+    if (!parent.empty()) {
+        enableControllers(parent);
+    }
+    enableControllers(root);
+
+    std::string name = root + "/run-" + std::to_string(getpid()) + "-" + std::to_string(counter++);
+    if (mkdir(name.c_str(), 0755) == -1) {
+        return false;
+    }
+    path = name;
+
+    // swapping would hide memory usage from memory.max
+    writeFile("memory.swap.max", "0");
+    return true;
+}
+
+bool Cgroup::valid() const {
+    return !path.empty();
+}
+
+bool Cgroup::setMemoryLimit(long bytes) const {
+    return writeFile("memory.max", std::to_string(bytes));
+}
+
+bool Cgroup::setProcessLimit(long count) const {
+    return writeFile("pids.max", std::to_string(count));
+}
+
+bool Cgroup::setCpuLimit(double cpus) const {
+    const long period = 100000;
+    return writeFile("cpu.max", std::to_string((long)(cpus * period)) + " " + std::to_string(period));
+}
+
+bool Cgroup::attach(pid_t pid) const {
+    return writeFile("cgroup.procs", std::to_string(pid));
+}
+
+long Cgroup::memoryPeak() const {
+    return readKey("memory.peak", "");
+}
+
+long Cgroup::oomKills() const {
+    return readKey("memory.events", "oom_kill");
+}
+
+double Cgroup::cpuUsage() const {
+    long usage = readKey("cpu.stat", "usage_usec");
+    if (usage < 0) {
+        return -1;
+    }
+    return 1e-6 * usage;
+}
+
+void Cgroup::killAll() const {
+    if (!writeFile("cgroup.kill", "1")) {
+        // cgroup.kill appeared in Linux 5.14, fall back to killing one by one
+        std::ifstream procs(path + "/cgroup.procs");
+        pid_t pid;
+        while (procs >> pid) {
+            kill(pid, SIGKILL);
+        }
+    }
+}
+
+void Cgroup::destroy() {
+    if (path.empty()) {
+        return;
+    }
+
+    killAll();
+
+    // the killed processes leave the cgroup asynchronously
+    for (int attempt = 0; attempt < 1000; ++attempt) {
+        if (rmdir(path.c_str()) == 0 || errno != EBUSY) {
+            break;
+        }
+        usleep(100);
+    }
+    path.clear();
+}
@@ -0,0 +1,42 @@
+#ifndef INVOKE_CGROUP_HPP
+#define INVOKE_CGROUP_HPP
+
+#include <string>
+#include <sys/types.h>
+
+// A cgroup v2 created for a single run. Limits are enforced by the kernel and
+// usage covers every process of the run, not only the direct child.
+class Cgroup {
+private:
+    std::string path;
+
+    bool writeFile(const std::string &name, const std::string &value) const;
+    long readKey(const std::string &name, const std::string &key) const;
+
+public:
+    // <cgroup2 mount>/invoke, or an empty string when cgroup v2 is not mounted
+    static std::string defaultRoot();
+
+    // Create a fresh cgroup under root. Controllers are enabled on the way,
+    // so root has to be delegated to us and must not contain processes itself.
+    bool create(const std::string &root);
+    bool valid() const;
+
+    bool setMemoryLimit(long bytes) const;
+    bool setProcessLimit(long count) const;
+    bool setCpuLimit(double cpus) const;
+    bool attach(pid_t pid) const;
+
+    // -1 when the kernel does not report the value
+    long memoryPeak() const;
+    long oomKills() const;
+    double cpuUsage() const;
+
+    // Kill every process of the cgroup, the cgroup itself stays
+    void killAll() const;
+    // Kill whatever is left in the cgroup and remove it
+    void destroy();
+};
+
+
+#endif //INVOKE_CGROUP_HPP
@@ -0,0 +1,129 @@
+#include "CpuTopology.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#include <sched.h>
+#include <dirent.h>
+
+namespace {
+
+const std::string cpuRoot = "/sys/devices/system/cpu/";
+
+}
+
+int CpuTopology::readInt(const std::string &filename, int fallback) {
+    std::ifstream file(filename);
+    int value;
+    if (file >> value) {
+        return value;
+    }
+    return fallback;
+}
+
+int CpuTopology::findNode(int cpu) {
+    std::string dirname = cpuRoot + "cpu" + std::to_string(cpu);
+    DIR *dir = opendir(dirname.c_str());
+    if (!dir) {
+        return 0;
+    }
+
+    int node = 0;
+    while (dirent *entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        if (name.compare(0, 4, "node") == 0 && name.size() > 4) {
+            node = std::stoi(name.substr(4));
+            break;
+        }
+    }
+    closedir(dir);
+    return node;
+}
+
+std::vector<int> CpuTopology::parseList(const std::string &list) {
+    std::vector<int> res;
+    std::stringstream buf(list);
+    std::string range;
+    while (std::getline(buf, range, ',')) {
+        if (range.empty() || range == "\n") {
+            continue;
+        }
+        size_t dash = range.find('-');
+        int first = std::stoi(range.substr(0, dash));
+        int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+        for (int cpu = first; cpu <= last; ++cpu) {
+            res.push_back(cpu);
+        }
+    }
+    return res;
+}
+
+CpuTopology CpuTopology::detect() {
+    CpuTopology topology;
+
+    std::ifstream online(cpuRoot + "online");
+    std::string list;
+    std::getline(online, list);
+
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    bool haveMask = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+
+    for (int id : parseList(list)) {
+        if (haveMask && !CPU_ISSET(id, &allowed)) {
+            continue;
+        }
+        std::string topologyDir = cpuRoot + "cpu" + std::to_string(id) + "/topology/";
+        Cpu cpu;
+        cpu.id = id;
+        cpu.package = readInt(topologyDir + "physical_package_id", 0);
+        cpu.core = readInt(topologyDir + "core_id", id);
+        cpu.node = findNode(id);
+        topology.cpus.push_back(cpu);
+    }
+
+    return topology;
+}
+
+std::vector<CpuSlot> CpuTopology::layoutSlots(size_t count) const {
+    // node -> physical core -> logical CPUs, all sorted by id
+    std::map<int, std::map<std::pair<int, int>, std::vector<int>>> nodes;
+    for (const Cpu &cpu : cpus) {
+        nodes[cpu.node][{cpu.package, cpu.core}].push_back(cpu.id);
+    }
+
+    std::vector<CpuSlot> slots;
+    for (auto &node : nodes) {
+        std::vector<std::vector<int>> cores;
+        for (auto &core : node.second) {
+            std::sort(core.second.begin(), core.second.end());
+            cores.push_back(core.second);
+        }
+        std::sort(cores.begin(), cores.end());
+
+        // the first core of every node is left for housekeeping, unless it is the only one
+        int housekeeping = cores[0][0];
+        size_t firstCore = cores.size() > 1 ? 1 : 0;
+
+        for (size_t i = firstCore; i < cores.size() && slots.size() < count; ++i) {
+            CpuSlot slot;
+            slot.traceeCpu = cores[i][0];
+            slot.tracerCpu = cores[i].size() > 1 ? cores[i][1] : housekeeping;
+            slot.node = node.first;
+            slots.push_back(slot);
+        }
+    }
+
+    return slots;
+}
+
+bool pinToCpus(const std::vector<int> &cpus) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        CPU_SET(cpu, &set);
+    }
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+}
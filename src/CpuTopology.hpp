@@ -0,0 +1,41 @@
+#ifndef INVOKE_CPUTOPOLOGY_HPP
+#define INVOKE_CPUTOPOLOGY_HPP
+
+#include <string>
+#include <vector>
+
+struct CpuSlot {
+    int traceeCpu;
+    int tracerCpu;
+    int node;
+};
+
+// Logical CPUs this process may run on, as described by sysfs
+class CpuTopology {
+private:
+    struct Cpu {
+        int id;
+        int package;
+        int core;
+        int node;
+    };
+
+    std::vector<Cpu> cpus;
+
+    static int readInt(const std::string &filename, int fallback);
+    static int findNode(int cpu);
+
+public:
+    static CpuTopology detect();
+    static std::vector<int> parseList(const std::string &list);
+
+    // Lay out up to `count` slots: every tracee gets a physical core of its own, while
+    // its tracer runs on an SMT sibling of that core or on the housekeeping core of
+    // the same NUMA node. Slots are filled node by node.
+    std::vector<CpuSlot> layoutSlots(size_t count) const;
+};
+
+bool pinToCpus(const std::vector<int> &cpus);
+
+
+#endif //INVOKE_CPUTOPOLOGY_HPP
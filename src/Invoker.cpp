@@ -1,10 +1,19 @@
 #include <stdexcept>
 #include <invokers/ptrace/PtraceInvoker_x86_64.hpp>
+#include <invokers/cgroup/CgroupInvoker.hpp>
+#include <invokers/notify/NotifyInvoker.hpp>
+#include <invokers/namespace/NamespaceInvoker.hpp>
+#include <tables/linux_x86_64.hpp>
+#include <linux/audit.h>
 #include <sstream>
+#include <iostream>
 #include "Invoker.hpp"
 
 const std::vector<std::pair<std::string, std::vector<std::string>>> Invoker::availableInvokers = {
         { "ptrace", { "x86_64" } },
+        { "cgroup", { "x86_64" } },
+        { "seccomp", { "x86_64" } },
+        { "namespace", { "x86_64" } },
 };
 
 Invoker *Invoker::makeInvoker(
@@ -17,8 +26,90 @@ Invoker *Invoker::makeInvoker(
         }
     }
 
+    if (name == "cgroup") {
+        if (config.cgroupRoot.empty()) {
+            throw std::invalid_argument("Invoker 'cgroup' needs a cgroup v2 root directory.");
+        }
+        if (arch == "x86_64") {
+            if (config.profile.needsPathChecks()) {
+                // path checks need a tracer, keep ptrace just for the syscall filtering
+                if (config.log) {
+                    std::cerr << "Profile '" << config.profile.name << "' needs path checks, "
+                              << "running it with the ptrace invoker" << std::endl;
+                }
+                return new PtraceInvoker_x86_64(config);
+            }
+            return new CgroupInvoker(config, AUDIT_ARCH_X86_64, "x86_64", linux_x86_64_table);
+        }
+    }
+
+    if ((name == "seccomp" || name == "namespace") && config.maxProcesses() > 0 && config.cgroupRoot.empty()) {
+        // without a tracer, only a cgroup can count the processes
+        throw std::invalid_argument("Invoker '" + name + "' needs a cgroup v2 root directory to limit processes.");
+    }
+
+    if (name == "seccomp") {
+        if (arch == "x86_64") {
+            return new NotifyInvoker(config, AUDIT_ARCH_X86_64, "x86_64", linux_x86_64_table);
+        }
+    }
+
+    if (name == "namespace") {
+        if (arch == "x86_64") {
+            return new NamespaceInvoker(config, AUDIT_ARCH_X86_64, "x86_64", linux_x86_64_table);
+        }
+    }
+
     std::stringstream buf;
     buf << "Invoker '" << name << "' with architecture '" << arch << "' does not exist.";
 
     throw std::invalid_argument(buf.str());
 }
+
+void Invoker::printResults() const {
+    const InvokerResult &result = getResult();
+
+    if (result.error != 0) {
+        std::cerr << "error: '" << std::endl;
+        std::cerr << result.errorMessage << "'" << std::endl;
+    }
+    std::cerr << "exit_code: " << result.exitCode << std::endl;
+    std::cerr << "wall_clock: " << result.wallClock << std::endl;
+    std::cerr << "cpu_clock: " << result.cpuUsage << std::endl;
+    std::cerr << "memory_usage: " << result.memoryUsage << std::endl;
+    if (result.cpu >= 0) {
+        std::cerr << "cpu: " << result.cpu << std::endl;
+    }
+    if (result.spawnLatency >= 0) {
+        std::cerr << "spawn_latency: " << result.spawnLatency << std::endl;
+    }
+    if (result.threads.size() > 1) {
+        std::cerr << "threads: [";
+        for (const ThreadUsage &thread : result.threads) {
+            std::cerr << thread.tid << ":" << thread.cpuUsage << ",";
+        }
+        std::cerr << "]" << std::endl;
+    }
+    if (result.stats) {
+        result.stats->print(std::cerr);
+    }
+
+    std::cerr << "verdicts: [";
+    if (result.timeLimitExceeded) {
+        std::cerr << "TL,";
+    }
+
+    if (result.memoryLimitExceeded) {
+        std::cerr << "ML,";
+    }
+
+    if (result.wallLimitExceeded) {
+        std::cerr << "RL,";
+    }
+
+    if (result.securityViolation) {
+        std::cerr << "SV,";
+    }
+
+    std::cerr << "]" << std::endl;
+}
@@ -5,8 +5,10 @@
 
 class Invoker {
 public:
+    virtual ~Invoker() = default;
+
     virtual void run() = 0;
-    virtual void printResults() const = 0;
+    virtual void printResults() const;
     virtual const InvokerResult& getResult() const = 0;
 
     static const std::vector<std::pair<std::string, std::vector<std::string>>> availableInvokers;
@@ -1,6 +1,46 @@
 #include "InvokerConfig.hpp"
 
+#include <algorithm>
+
 InvokerConfig::InvokerConfig(const InvokerProfile &profile) :
     profile(profile) {
 
 }
+
+InvokerConfig::InvokerConfig(const InvokerConfig &other, const InvokerProfile &profile) :
+    timeLimit(other.timeLimit),
+    wallLimit(other.wallLimit),
+    memoryLimit(other.memoryLimit),
+    stdin_fd(other.stdin_fd),
+    stdout_fd(other.stdout_fd),
+    stderr_fd(other.stderr_fd),
+    cpu(other.cpu),
+    tracerCpu(other.tracerCpu),
+    cgroupRoot(other.cgroupRoot),
+    processLimit(other.processLimit),
+    cpuQuota(other.cpuQuota),
+    log(other.log),
+    seccomp(other.seccomp),
+    landlock(other.landlock),
+    stats(other.stats),
+    poolSize(other.poolSize),
+    forkServer(other.forkServer),
+    exe(other.exe),
+    workingDirectory(other.workingDirectory),
+    args(other.args),
+    envp(other.envp),
+    writeableFiles(other.writeableFiles),
+    inheritEnvironment(other.inheritEnvironment),
+    profile(profile) {
+
+}
+
+long InvokerConfig::maxProcesses() const {
+    long limit = processLimit >= 0 ? processLimit : profile.processLimit;
+    return std::max(limit, 0L);
+}
+
+bool InvokerResult::failed() const {
+    return error != 0 || exitCode != 0 ||
+           securityViolation || timeLimitExceeded || wallLimitExceeded || memoryLimitExceeded;
+}
@@ -1,13 +1,19 @@
 #ifndef INVOKE_INVOKERCONFIG_HPP
 #define INVOKE_INVOKERCONFIG_HPP
 
+#include <memory>
 #include <string>
 #include <vector>
+#include <sys/types.h>
 #include "InvokerProfile.hpp"
+#include "SyscallStats.hpp"
 
 class InvokerConfig {
 public:
     explicit InvokerConfig(const InvokerProfile &profile);
+    // everything of `other` but its profile, so new members have to be copied there as well
+    InvokerConfig(const InvokerConfig &other, const InvokerProfile &profile);
+    InvokerConfig(const InvokerConfig &other) = default;
 
     double timeLimit = -1;
     double wallLimit = -1;
@@ -17,7 +23,28 @@ public:
     int stdout_fd = 1;
     int stderr_fd = 2;
 
+    // logical CPUs to pin the tracee and the tracer to, -1 leaves them unpinned
+    int cpu = -1;
+    int tracerCpu = -1;
+
+    // when set, every run gets its own cgroup v2 under this directory
+    std::string cgroupRoot;
+    // 0 for no limit, negative for the limit of the profile, see maxProcesses()
+    long processLimit = -1;
+    double cpuQuota = -1;
+
     bool log = false;
+    bool seccomp = true;
+    // enforce the path permissions with Landlock where the kernel and the profile allow it,
+    // profiles that let the program share its memory always need it
+    bool landlock = false;
+    // count syscalls and time the tracer, see SyscallStats
+    bool stats = false;
+    // tracees the ptrace invoker keeps ready for its next runs, 0 spawns one per run
+    int poolSize = 0;
+    // start the program once, up to the checkpoint of the fork server handshake, and fork
+    // every run from there instead of spawning it, see PtraceInvoker
+    bool forkServer = false;
 
     std::string exe;
     std::string workingDirectory;
@@ -28,6 +55,14 @@ public:
 
     bool inheritEnvironment = false;
     const InvokerProfile &profile;
+
+    // the processes the program may run at once, 0 if there is no limit
+    long maxProcesses() const;
+};
+
+struct ThreadUsage {
+    pid_t tid;
+    double cpuUsage;
 };
 
 class InvokerResult {
@@ -39,11 +74,20 @@ public:
     double cpuUsage = 0.0;
     double wallClock = 0.0;
     long memoryUsage = 0;
+    int cpu = -1;
+    // seconds from spawning the tracee until it runs the program, or -1 if not measured
+    double spawnLatency = -1.0;
+    // CPU time of every thread that has exited, only filled in by tracing invokers
+    std::vector<ThreadUsage> threads;
+    // only with InvokerConfig::stats, and only filled in by tracing invokers
+    std::shared_ptr<SyscallStats> stats;
 
     bool securityViolation = false;
     bool timeLimitExceeded = false;
     bool wallLimitExceeded = false;
     bool memoryLimitExceeded = false;
+
+    bool failed() const;
 };
 
 
@@ -0,0 +1,466 @@
+#include "InvokerDaemon.hpp"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <csignal>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+namespace {
+
+// a request after parsing, unset numbers are negative
+struct JobRequest {
+    std::string id;
+    std::string exe;
+    std::string profile;
+    std::string workdir;
+    std::vector<std::string> args;
+    std::vector<std::string> env;
+    double timeLimit = -1;
+    long memoryLimit = -1;
+    double wallLimit = -1;
+    long processLimit = -1;
+    double cpuQuota = -1;
+    int stdinIndex = -1;
+    int stdoutIndex = -1;
+    int stderrIndex = -1;
+};
+
+double parseNumber(const std::string &key, const std::string &value) {
+    char *end;
+    double number = strtod(value.c_str(), &end);
+    if (value.empty() || *end != '\0') {
+        throw std::invalid_argument("Invalid value '" + value + "' for '" + key + "'");
+    }
+    return number;
+}
+
+void parseRequest(const std::string &text, JobRequest &request) {
+    std::istringstream in(text);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) {
+            throw std::invalid_argument("Malformed line '" + line + "'");
+        }
+        std::string key = line.substr(0, colon);
+        std::string value = line.substr(colon + 1);
+        if (!value.empty() && value[0] == ' ') {
+            value.erase(0, 1);
+        }
+
+        if (key == "id") {
+            request.id = value;
+        } else if (key == "exe") {
+            request.exe = value;
+        } else if (key == "arg") {
+            request.args.push_back(value);
+        } else if (key == "env") {
+            request.env.push_back(value);
+        } else if (key == "profile") {
+            request.profile = value;
+        } else if (key == "workdir") {
+            request.workdir = value;
+        } else if (key == "time-limit") {
+            request.timeLimit = parseNumber(key, value);
+        } else if (key == "memory-limit") {
+            request.memoryLimit = (long)parseNumber(key, value) * 1024 * 1024;
+        } else if (key == "wall-limit") {
+            request.wallLimit = parseNumber(key, value);
+        } else if (key == "process-limit") {
+            request.processLimit = (long)parseNumber(key, value);
+        } else if (key == "cpu-quota") {
+            request.cpuQuota = parseNumber(key, value);
+        } else if (key == "stdin") {
+            request.stdinIndex = (int)parseNumber(key, value);
+        } else if (key == "stdout") {
+            request.stdoutIndex = (int)parseNumber(key, value);
+        } else if (key == "stderr") {
+            request.stderrIndex = (int)parseNumber(key, value);
+        } else {
+            throw std::invalid_argument("Unknown key '" + key + "'");
+        }
+    }
+
+    if (request.args.empty()) {
+        throw std::invalid_argument("Request has no arguments");
+    }
+    if (request.exe.empty()) {
+        request.exe = request.args[0];
+    }
+}
+
+// own copy of a passed descriptor, so stdout and stderr may share one; -1 if not passed
+int takeFd(const std::vector<int> &fds, int index) {
+    if (index < 0) {
+        return -1;
+    }
+    if ((size_t)index >= fds.size()) {
+        throw std::invalid_argument("No descriptor with index " + std::to_string(index));
+    }
+    int fd = fcntl(fds[index], F_DUPFD_CLOEXEC, 3);
+    if (fd < 0) {
+        throw std::invalid_argument(std::string("Failed to duplicate descriptor: ") + strerror(errno));
+    }
+    return fd;
+}
+
+void closeFd(int fd) {
+    if (fd > 2) {
+        close(fd);
+    }
+}
+
+}
+
+InvokerDaemon::InvokerDaemon(const InvokerConfig &base, const std::string &arch, size_t slots) :
+    base(base), supervisor(arch, slots) {
+
+}
+
+InvokerDaemon::~InvokerDaemon() {
+    for (auto &client : clients) {
+        close(client.first);
+    }
+    if (signalfd != -1) {
+        close(signalfd);
+    }
+    if (listenfd != -1) {
+        close(listenfd);
+        unlink(path.c_str());
+    }
+}
+
+void InvokerDaemon::pin(const std::vector<CpuSlot> &layout) {
+    supervisor.pin(layout);
+}
+
+void InvokerDaemon::listen(const std::string &path) {
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        throw std::invalid_argument("Socket path '" + path + "' is too long");
+    }
+    strcpy(addr.sun_path, path.c_str());
+
+    // every descriptor of the daemon is close-on-exec, tracees only get what a job passes
+    listenfd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenfd < 0) {
+        throw std::invalid_argument(std::string("Failed to create socket: ") + strerror(errno));
+    }
+
+    unlink(path.c_str());
+    if (bind(listenfd, (sockaddr*)&addr, sizeof(addr)) == -1 || ::listen(listenfd, SOMAXCONN) == -1) {
+        int err = errno;
+        close(listenfd);
+        listenfd = -1;
+        throw std::invalid_argument("Failed to listen on '" + path + "': " + strerror(err));
+    }
+    this->path = path;
+}
+
+void InvokerDaemon::run() {
+    // SIGINT and SIGTERM stop accepting jobs, those already running are finished first
+    sigset_t mask, oldMask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGINT);
+    sigaddset(&mask, SIGTERM);
+    sigprocmask(SIG_BLOCK, &mask, &oldMask);
+    signalfd = ::signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+
+    supervisor.addSource(signalfd, [this]() { onSignal(); });
+    supervisor.addSource(listenfd, [this]() { onAccept(); });
+
+    supervisor.run([this](size_t id, const Invoker &invoker) {
+        return onComplete(id, invoker);
+    });
+
+    sigprocmask(SIG_SETMASK, &oldMask, NULL);
+}
+
+void InvokerDaemon::onSignal() {
+    signalfd_siginfo info;
+    while (read(signalfd, &info, sizeof(info)) > 0) {
+    }
+
+    if (base.log) {
+        std::cerr << "Shutting down, waiting for " << jobs.size() << " jobs" << std::endl;
+    }
+
+    supervisor.removeSource(signalfd);
+    supervisor.removeSource(listenfd);
+    close(listenfd);
+    listenfd = -1;
+    unlink(path.c_str());
+
+    // replies are still sent, but no more requests are read
+    stopping = true;
+    for (auto &client : clients) {
+        watch(client.first);
+    }
+}
+
+void InvokerDaemon::onAccept() {
+    for (;;) {
+        int fd = accept4(listenfd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            break;
+        }
+        clients[fd] = Client();
+        watch(fd);
+    }
+}
+
+void InvokerDaemon::onClient(int fd) {
+    flush(fd);
+    if (clients[fd].closed) {
+        release(fd);
+        return;
+    }
+    if (stopping) {
+        return;
+    }
+
+    std::vector<char> buffer(MAX_MESSAGE);
+    for (;;) {
+        char control[CMSG_SPACE(sizeof(int) * MAX_FDS)];
+        iovec iov = { buffer.data(), buffer.size() };
+        msghdr msg = {};
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+        // received descriptors must not leak into other tracees either
+        ssize_t size = recvmsg(fd, &msg, MSG_CMSG_CLOEXEC);
+        if (size < 0 && (errno == EAGAIN || errno == EINTR)) {
+            return;
+        }
+
+        std::vector<int> fds;
+        for (cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+            if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+                size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+                for (size_t i = 0; i < count; ++i) {
+                    int passed;
+                    memcpy(&passed, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+                    fds.push_back(passed);
+                }
+            }
+        }
+
+        bool keep = size > 0;
+        if (keep) {
+            if (msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC)) {
+                reply(fd, "error: " + std::to_string(EMSGSIZE) + "\nerror_message: Request is too large\n");
+            } else {
+                keep = onRequest(fd, std::string(buffer.data(), (size_t)size), fds);
+            }
+        }
+
+        for (int passed : fds) {
+            close(passed);
+        }
+
+        if (!keep) {
+            Client &client = clients[fd];
+            client.closed = true;
+            client.outgoing.clear();
+            watch(fd);
+            release(fd);
+            return;
+        }
+    }
+}
+
+bool InvokerDaemon::onRequest(int client, const std::string &text, const std::vector<int> &fds) {
+    JobRequest request;
+    const InvokerProfile *profile = &base.profile;
+    int stdinFd = -1, stdoutFd = -1, stderrFd = -1;
+    try {
+        parseRequest(text, request);
+        if (!request.profile.empty()) {
+            profile = &InvokerProfile::getProfile(request.profile);
+        }
+        stdinFd = takeFd(fds, request.stdinIndex);
+        stdoutFd = takeFd(fds, request.stdoutIndex);
+        stderrFd = takeFd(fds, request.stderrIndex);
+    } catch (std::invalid_argument &e) {
+        closeFd(stdinFd);
+        closeFd(stdoutFd);
+        if (base.log) {
+            std::cerr << "Rejected request: " << e.what() << std::endl;
+        }
+        reply(client, "id: " + request.id + "\nerror: " + std::to_string(EINVAL) +
+                      "\nerror_message: " + e.what() + "\n");
+        return true;
+    }
+
+    // the daemon's own command line holds for everything the request leaves out
+    InvokerConfig config(base, *profile);
+    if (request.timeLimit >= 0) {
+        config.timeLimit = request.timeLimit;
+    }
+    if (request.memoryLimit >= 0) {
+        config.memoryLimit = request.memoryLimit;
+    }
+    if (request.wallLimit >= 0) {
+        config.wallLimit = request.wallLimit;
+    }
+    if (request.processLimit >= 0) {
+        config.processLimit = request.processLimit;
+    }
+    if (request.cpuQuota >= 0) {
+        config.cpuQuota = request.cpuQuota;
+    }
+    if (!request.workdir.empty()) {
+        config.workingDirectory = request.workdir;
+    }
+    if (!request.env.empty()) {
+        config.envp = request.env;
+        config.inheritEnvironment = false;
+    }
+    config.exe = request.exe;
+    config.args = request.args;
+    config.stdin_fd = stdinFd;
+    config.stdout_fd = stdoutFd;
+    config.stderr_fd = stderrFd;
+
+    size_t id = nextJob++;
+    Job &job = jobs[id];
+    job.client = client;
+    job.id = request.id;
+    job.fds[0] = stdinFd;
+    job.fds[1] = stdoutFd;
+    job.fds[2] = stderrFd;
+    ++clients[client].pending;
+
+    // the supervisor keeps its own copy of the config
+    supervisor.submit(id, config);
+    return true;
+}
+
+bool InvokerDaemon::onComplete(size_t id, const Invoker &invoker) {
+    auto it = jobs.find(id);
+    if (it == jobs.end()) {
+        return true;
+    }
+
+    for (int fd : it->second.fds) {
+        closeFd(fd);
+    }
+
+    int client = it->second.client;
+    reply(client, formatResult(it->second.id, invoker.getResult()));
+    jobs.erase(it);
+
+    --clients[client].pending;
+    release(client);
+    return true;
+}
+
+void InvokerDaemon::reply(int client, const std::string &message) {
+    Client &c = clients[client];
+    if (c.closed) {
+        return;
+    }
+    // a client that does not read its replies must not stall everyone, so they wait here
+    c.outgoing.push_back(message);
+    flush(client);
+}
+
+void InvokerDaemon::flush(int client) {
+    Client &c = clients[client];
+    while (!c.outgoing.empty()) {
+        const std::string &message = c.outgoing.front();
+        if (send(client, message.data(), message.size(), MSG_NOSIGNAL | MSG_DONTWAIT) < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+                break;
+            }
+            // the client is gone, nobody is left to read them
+            c.closed = true;
+            c.outgoing.clear();
+            break;
+        }
+        c.outgoing.pop_front();
+    }
+    watch(client);
+}
+
+void InvokerDaemon::watch(int client) {
+    const Client &c = clients[client];
+    uint32_t events = 0;
+    if (!c.closed && !stopping) {
+        events |= EPOLLIN;
+    }
+    if (!c.outgoing.empty()) {
+        events |= EPOLLOUT;
+    }
+
+    if (events == 0) {
+        supervisor.removeSource(client);
+    } else {
+        supervisor.addSource(client, [this, client]() { onClient(client); }, events);
+    }
+}
+
+void InvokerDaemon::release(int client) {
+    // the descriptor stays open while replies are due, so it cannot be reused by another client
+    auto it = clients.find(client);
+    if (it != clients.end() && it->second.closed && it->second.pending == 0) {
+        close(client);
+        clients.erase(it);
+    }
+}
+
+std::string InvokerDaemon::formatResult(const std::string &id, const InvokerResult &result) {
+    std::ostringstream out;
+    out << "id: " << id << "\n";
+    out << "error: " << result.error << "\n";
+    if (result.error != 0) {
+        std::string message = result.errorMessage;
+        for (char &c : message) {
+            if (c == '\n') {
+                c = ' ';
+            }
+        }
+        out << "error_message: " << message << "\n";
+    }
+    out << "exit_code: " << result.exitCode << "\n";
+    out << "wall_clock: " << result.wallClock << "\n";
+    out << "cpu_clock: " << result.cpuUsage << "\n";
+    out << "memory_usage: " << result.memoryUsage << "\n";
+    if (result.spawnLatency >= 0) {
+        out << "spawn_latency: " << result.spawnLatency << "\n";
+    }
+
+    std::string verdicts;
+    if (result.timeLimitExceeded) {
+        verdicts += "TL,";
+    }
+    if (result.memoryLimitExceeded) {
+        verdicts += "ML,";
+    }
+    if (result.wallLimitExceeded) {
+        verdicts += "RL,";
+    }
+    if (result.securityViolation) {
+        verdicts += "SV,";
+    }
+    if (!verdicts.empty()) {
+        verdicts.pop_back();
+    }
+    out << "verdicts: " << verdicts << "\n";
+    return out.str();
+}
@@ -0,0 +1,89 @@
+#ifndef INVOKE_INVOKERDAEMON_HPP
+#define INVOKE_INVOKERDAEMON_HPP
+
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "InvokerConfig.hpp"
+#include "invokers/ptrace/PtraceSupervisor.hpp"
+
+// Serves jobs from clients connected to a Unix domain socket of type SOCK_SEQPACKET,
+// running up to `slots` of them at once. Every message is one request or one reply,
+// made of "key: value" lines. A request may contain
+//   id: <text>                 echoed back in the reply
+//   exe: <path>                defaults to the first argument
+//   arg: <text>                once per argument, starting with argv[0]
+//   env: <NAME=value>          once per variable, the program gets only these
+//   profile: <name>
+//   time-limit: <seconds>
+//   memory-limit: <megabytes>
+//   wall-limit: <seconds>
+//   process-limit: <count>
+//   cpu-quota: <cpus>
+//   workdir: <path>
+//   stdin: <index>             index of a descriptor passed along with SCM_RIGHTS,
+//   stdout: <index>            the program's stdin, stdout or stderr are closed
+//   stderr: <index>            if none is given
+// and everything else is taken from the daemon's own command line. The reply has
+//   id, error, error_message, exit_code, wall_clock, cpu_clock, memory_usage,
+//   spawn_latency and verdicts: a comma separated list of TL, ML, RL and SV.
+// Values run to the end of the line, so they cannot contain newlines.
+class InvokerDaemon {
+private:
+    struct Client {
+        // jobs whose replies are still to be sent
+        size_t pending = 0;
+        bool closed = false;
+        // replies the socket had no room for yet, oldest first
+        std::deque<std::string> outgoing;
+    };
+
+    struct Job {
+        int client;
+        std::string id;
+        // stdin, stdout and stderr of the program
+        int fds[3];
+    };
+
+    static const size_t MAX_MESSAGE = 65536;
+    static const size_t MAX_FDS = 8;
+
+    const InvokerConfig &base;
+    PtraceSupervisor supervisor;
+    std::string path;
+    int listenfd = -1;
+    int signalfd = -1;
+    std::unordered_map<int, Client> clients;
+    std::unordered_map<size_t, Job> jobs;
+    size_t nextJob = 0;
+    // no more requests are read, replies are still sent
+    bool stopping = false;
+
+    void onAccept();
+    void onClient(int fd);
+    void onSignal();
+    bool onRequest(int client, const std::string &request, const std::vector<int> &fds);
+    bool onComplete(size_t id, const Invoker &invoker);
+    void reply(int client, const std::string &message);
+    void flush(int client);
+    void watch(int client);
+    void release(int client);
+
+    static std::string formatResult(const std::string &id, const InvokerResult &result);
+
+public:
+    InvokerDaemon(const InvokerConfig &base, const std::string &arch, size_t slots);
+    ~InvokerDaemon();
+
+    void pin(const std::vector<CpuSlot> &layout);
+
+    // Bind the socket at `path`, replacing a stale one. Throws std::invalid_argument on failure.
+    void listen(const std::string &path);
+
+    // Serve clients until SIGINT or SIGTERM, then wait for the running jobs
+    void run();
+};
+
+
+#endif //INVOKE_INVOKERDAEMON_HPP
@@ -1,14 +1,66 @@
 #include <profiles/linux_native.hpp>
 #include <profiles/linux_nosecurity.hpp>
+#include <profiles/linux_runtime.hpp>
+#include <profiles/linux_python.hpp>
+#include <profiles/linux_java.hpp>
+#include <profiles/linux_go.hpp>
+#include <profiles/linux_node.hpp>
 #include <stdexcept>
 #include <sstream>
+#include <cstring>
 #include "InvokerProfile.hpp"
+#include "ProfileLoader.hpp"
 
 const std::vector<std::string> InvokerProfile::availableProfiles = {
     "linux_native",
-    "linux_nosecurity"
+    "linux_nosecurity",
+    "linux_runtime",
+    "linux_python",
+    "linux_java",
+    "linux_go",
+    "linux_node"
 };
 
+bool InvokerProfile::needsPathChecks() const {
+    auto isCheck = [](SyscallAction action) {
+        return action == SyscallAction::CheckPath || action == SyscallAction::CheckPathSecurity;
+    };
+
+    if (isCheck(defaultSyscallAction)) {
+        return true;
+    }
+    for (const SyscallPolicy &policy : syscalls) {
+        if (isCheck(policy.action)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool InvokerProfile::sharesMemory() const {
+    for (const char *name : { "clone", "clone3", "fork", "vfork" }) {
+        SyscallAction action = defaultSyscallAction;
+        for (const SyscallPolicy &policy : syscalls) {
+            if (strcmp(policy.syscall, name) == 0) {
+                action = policy.action;
+            }
+        }
+        if (action == SyscallAction::Allow) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const ProfileActions *InvokerProfile::actionsFor(const std::string &arch) const {
+    for (const ProfileActions &table : actions) {
+        if (arch == table.arch) {
+            return &table;
+        }
+    }
+    return nullptr;
+}
+
 const InvokerProfile &InvokerProfile::getProfile(std::string name) {
     if (name == "linux_native") {
         return linux_native_profile;
@@ -16,6 +68,24 @@ const InvokerProfile &InvokerProfile::getProfile(std::string name) {
     if (name == "linux_nosecurity") {
         return linux_nosecurity_profile;
     }
+    if (name == "linux_runtime") {
+        return linux_runtime_profile;
+    }
+    if (name == "linux_python") {
+        return linux_python_profile;
+    }
+    if (name == "linux_java") {
+        return linux_java_profile;
+    }
+    if (name == "linux_go") {
+        return linux_go_profile;
+    }
+    if (name == "linux_node") {
+        return linux_node_profile;
+    }
+    if (const InvokerProfile *loaded = ProfileLoader::load(name)) {
+        return *loaded;
+    }
     std::stringstream buf;
     buf << "Invalid profile name '" << name << "'";
     throw std::invalid_argument(buf.str());
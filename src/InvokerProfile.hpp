@@ -1,6 +1,7 @@
 #ifndef INVOKE_INVOKERPROFILE_HPP
 #define INVOKE_INVOKERPROFILE_HPP
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -21,22 +22,57 @@ enum class SyscallAction {
     Security,
 };
 
+class PathTrie;
+
 struct PathPermission {
-    std::string path;
+    const char *path;
     PathAccess access;
 };
 
 struct SyscallPolicy {
-    std::string syscall;
+    const char *syscall;
     SyscallAction action;
 };
 
+// Syscall actions of a profile resolved for one architecture, indexed by syscall number.
+// Numbers past the end of the array are Unspecified.
+struct ProfileActions {
+    const char *arch;
+    const SyscallAction *actions;
+    size_t count;
+};
+
+// View of a constant array, so that generated profiles are plain constant data
+template<typename T>
+struct ProfileList {
+    const T *items;
+    size_t count;
+
+    const T *begin() const { return items; }
+    const T *end() const { return items + count; }
+    size_t size() const { return count; }
+};
+
 struct InvokerProfile {
-    std::string name;
+    const char *name;
     SyscallAction defaultSyscallAction;
     PathAccess defaultPathAccess;
-    std::vector<SyscallPolicy> syscalls;
-    std::vector<PathPermission> paths;
+    ProfileList<SyscallPolicy> syscalls;
+    ProfileList<PathPermission> paths;
+    ProfileList<ProfileActions> actions;
+    // path permissions compiled along with a runtime profile, nullptr for built-in ones
+    const PathTrie *trie;
+    // processes the program may run at once unless the config sets a limit, 0 for no limit
+    long processLimit;
+
+    // whether some syscall can only be decided by looking at its path argument
+    bool needsPathChecks() const;
+    // whether the program can run alongside itself in the same memory: as threads, or as
+    // processes with a shared mapping, which anyone who may fork can set up
+    bool sharesMemory() const;
+
+    // precomputed actions for the architecture, nullptr if the profile has none
+    const ProfileActions *actionsFor(const std::string &arch) const;
 
     static const std::vector<std::string> availableProfiles;
 
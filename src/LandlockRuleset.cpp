@@ -0,0 +1,243 @@
+#include "LandlockRuleset.hpp"
+
+#include <cerrno>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/prctl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/landlock.h>
+#include <boost/filesystem/operations.hpp>
+#include "RawSyscall.hpp"
+
+// newer than the headers we may be built against
+#ifndef LANDLOCK_ACCESS_FS_REFER
+#define LANDLOCK_ACCESS_FS_REFER (1ULL << 13)
+#endif
+#ifndef LANDLOCK_ACCESS_FS_TRUNCATE
+#define LANDLOCK_ACCESS_FS_TRUNCATE (1ULL << 14)
+#endif
+
+namespace {
+
+// the only rights a rule on something other than a directory may carry
+const uint64_t FILE_ACCESS = LANDLOCK_ACCESS_FS_READ_FILE | LANDLOCK_ACCESS_FS_WRITE_FILE |
+                             LANDLOCK_ACCESS_FS_TRUNCATE;
+
+const uint64_t READ_ACCESS = LANDLOCK_ACCESS_FS_READ_FILE | LANDLOCK_ACCESS_FS_READ_DIR;
+
+// the path a permission applies to, without the slash that marks a directory tree
+std::string nodeOf(const std::string &path) {
+    size_t end = path.size();
+    while (end > 0 && path[end - 1] == '/') {
+        --end;
+    }
+    return path.substr(0, end);
+}
+
+// whether the tree at `ancestor` contains `node`
+bool contains(const std::string &ancestor, const std::string &node) {
+    return ancestor.empty() || node == ancestor ||
+           (node.size() > ancestor.size() && node.compare(0, ancestor.size(), ancestor) == 0 &&
+            node[ancestor.size()] == '/');
+}
+
+// whether some path gets its permission from both rules
+bool overlap(const std::string &node, bool exact, const std::string &other, bool otherExact) {
+    return node == other || (!exact && contains(node, other)) || (!otherExact && contains(other, node));
+}
+
+}
+
+bool LandlockRuleset::accessOf(PathAccess access, uint64_t &rights) const {
+    switch (access) {
+        case PathAccess::ReadWrite:
+            rights = handled;
+            return true;
+        case PathAccess::ReadOnly:
+            rights = READ_ACCESS;
+            return true;
+        case PathAccess::Denied:
+            rights = 0;
+            return true;
+        default:
+            // Security verdicts need the tracer
+            return false;
+    }
+}
+
+bool LandlockRuleset::build(const InvokerProfile &profile) {
+    profileRules.clear();
+    int version = abi();
+    if (version < 1) {
+        return false;
+    }
+
+    // execution is left to the syscall filter, like the tracer does
+    handled = LANDLOCK_ACCESS_FS_WRITE_FILE | LANDLOCK_ACCESS_FS_READ_FILE | LANDLOCK_ACCESS_FS_READ_DIR |
+              LANDLOCK_ACCESS_FS_REMOVE_DIR | LANDLOCK_ACCESS_FS_REMOVE_FILE |
+              LANDLOCK_ACCESS_FS_MAKE_CHAR | LANDLOCK_ACCESS_FS_MAKE_DIR | LANDLOCK_ACCESS_FS_MAKE_REG |
+              LANDLOCK_ACCESS_FS_MAKE_SOCK | LANDLOCK_ACCESS_FS_MAKE_FIFO | LANDLOCK_ACCESS_FS_MAKE_BLOCK |
+              LANDLOCK_ACCESS_FS_MAKE_SYM;
+    if (version >= 2) {
+        handled |= LANDLOCK_ACCESS_FS_REFER;
+    }
+    if (version >= 3) {
+        handled |= LANDLOCK_ACCESS_FS_TRUNCATE;
+    }
+
+    uint64_t defaultAccess;
+    if (!accessOf(profile.defaultPathAccess, defaultAccess)) {
+        return false;
+    }
+
+    std::vector<Rule> rules;
+    for (const PathPermission &permission : profile.paths) {
+        Rule rule;
+        std::string path = permission.path;
+        rule.exact = path.empty() || path.back() != '/';
+        rule.path = nodeOf(path);
+        if (!accessOf(permission.access, rule.access)) {
+            return false;
+        }
+        if ((defaultAccess & ~rule.access) != 0) {
+            // the default applies everywhere, no rule can take it away
+            return false;
+        }
+        for (const Rule &earlier : rules) {
+            if ((earlier.access & ~rule.access) != 0 && overlap(earlier.path, earlier.exact, rule.path, rule.exact)) {
+                return false;
+            }
+        }
+        rules.push_back(rule);
+    }
+
+    if (defaultAccess != 0) {
+        Rule root;
+        root.path = "";
+        root.access = defaultAccess;
+        root.exact = false;
+        rules.insert(rules.begin(), root);
+    }
+    profileRules.swap(rules);
+    return true;
+}
+
+bool LandlockRuleset::prepare(const boost::filesystem::path &cwd, const std::string &exe,
+                              const std::vector<std::string> &writeableFiles) {
+    std::string directory = nodeOf(cwd.string());
+    for (const Rule &rule : profileRules) {
+        // files of the working directory are read only, whatever the profile says
+        bool above = !rule.exact && contains(rule.path, directory);
+        bool inside = contains(directory, rule.path) && rule.path != directory &&
+                      rule.path.find('/', directory.size() + 1) == std::string::npos;
+        if ((above || inside) && (rule.access & ~READ_ACCESS) != 0) {
+            return false;
+        }
+    }
+
+    rules = profileRules;
+
+    // listing the working directory also lets the program list the directories below it
+    Rule listing;
+    listing.path = directory;
+    listing.access = LANDLOCK_ACCESS_FS_READ_DIR;
+    listing.exact = false;
+    rules.push_back(listing);
+
+    // the tracer never looked at execve(), but Landlock wants the program readable
+    Rule program;
+    program.path = boost::filesystem::path(exe).is_absolute() ? exe : (cwd / exe).string();
+    program.access = LANDLOCK_ACCESS_FS_READ_FILE;
+    program.exact = true;
+    rules.push_back(program);
+
+    boost::system::error_code err;
+    boost::filesystem::directory_iterator it(cwd, err), end;
+    size_t files = 0;
+    for (; !err && it != end; it.increment(err)) {
+        if (boost::filesystem::is_directory(it->status())) {
+            continue;
+        }
+        if (++files > MAX_DIRECTORY_FILES) {
+            return false;
+        }
+        Rule file;
+        file.path = it->path().string();
+        file.access = LANDLOCK_ACCESS_FS_READ_FILE;
+        file.exact = true;
+        for (const std::string &writeable : writeableFiles) {
+            if (it->path().filename() == writeable) {
+                file.access = handled & FILE_ACCESS;
+            }
+        }
+        rules.push_back(file);
+    }
+    if (err) {
+        return false;
+    }
+
+    for (const std::string &writeable : writeableFiles) {
+        if (!boost::filesystem::is_regular_file(cwd / writeable, err)) {
+            // creating it would take a right to create any file in the directory
+            return false;
+        }
+    }
+    return true;
+}
+
+int LandlockRuleset::restrictSelf() const {
+    landlock_ruleset_attr attr = {};
+    attr.handled_access_fs = handled;
+    long ruleset = rawSyscall(SYS_landlock_create_ruleset, (long)&attr, sizeof(attr), 0);
+    if (ruleset < 0) {
+        return (int)-ruleset;
+    }
+
+    for (const Rule &rule : rules) {
+        long fd = rawSyscall(SYS_openat, AT_FDCWD, (long)(rule.path.empty() ? "/" : rule.path.c_str()),
+                             O_PATH | O_CLOEXEC);
+        if (fd < 0) {
+            // nothing to allow on a path that does not exist
+            continue;
+        }
+
+        landlock_path_beneath_attr beneath = {};
+        beneath.allowed_access = rule.access;
+        beneath.parent_fd = (int)fd;
+        struct stat st;
+        bool add = rawSyscall(SYS_fstat, fd, (long)&st) == 0;
+        if (add && !S_ISDIR(st.st_mode)) {
+            beneath.allowed_access &= FILE_ACCESS;
+        } else if (rule.exact) {
+            // a rule on a directory would cover everything below it as well
+            add = false;
+        }
+
+        long error = 0;
+        if (add && beneath.allowed_access != 0) {
+            error = rawSyscall(SYS_landlock_add_rule, ruleset, LANDLOCK_RULE_PATH_BENEATH, (long)&beneath, 0);
+        }
+        rawSyscall(SYS_close, fd);
+        if (error < 0) {
+            rawSyscall(SYS_close, ruleset);
+            return (int)-error;
+        }
+    }
+
+    long error = rawSyscall(SYS_prctl, PR_SET_NO_NEW_PRIVS, 1, 0, 0, 0);
+    if (error == 0) {
+        error = rawSyscall(SYS_landlock_restrict_self, ruleset, 0);
+    }
+    rawSyscall(SYS_close, ruleset);
+    return (int)-error;
+}
+
+int LandlockRuleset::abi() {
+    static int version = []() {
+        long version = syscall(SYS_landlock_create_ruleset, NULL, 0, LANDLOCK_CREATE_RULESET_VERSION);
+        return version < 0 ? 0 : (int)version;
+    }();
+    return version;
+}
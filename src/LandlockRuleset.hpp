@@ -0,0 +1,57 @@
+#ifndef INVOKE_LANDLOCKRULESET_HPP
+#define INVOKE_LANDLOCKRULESET_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <boost/filesystem/path.hpp>
+#include "InvokerProfile.hpp"
+
+// Path permissions of a profile as a Landlock ruleset, so that the kernel decides
+// opens on its own and path syscalls need not stop in the tracer.
+//
+// Landlock grants the union of the rules on a path and its ancestors while the
+// profile lets the permission listed last win, so only profiles where a later
+// permission never takes access away from an earlier one can be expressed.
+// Landlock does not mediate stat(), access() or readlink(), those succeed on any path.
+class LandlockRuleset {
+private:
+    struct Rule {
+        std::string path;
+        uint64_t access;
+        // only for exactly this path, not a directory tree
+        bool exact;
+    };
+
+    // at most this many files of the working directory get a rule of their own
+    static const size_t MAX_DIRECTORY_FILES = 256;
+
+    uint64_t handled = 0;
+    std::vector<Rule> profileRules;
+    // those of the profile and of the working directory, as restrictSelf() adds them
+    std::vector<Rule> rules;
+
+    // false for accesses only the tracer can decide
+    bool accessOf(PathAccess access, uint64_t &rights) const;
+
+public:
+    // Returns false if Landlock is not available or cannot express the permissions
+    // of the profile, e.g. Security ones or a later permission narrowing an earlier one.
+    bool build(const InvokerProfile &profile);
+
+    // Add the files of the working directory, which the profile lets the program read
+    // whatever its permissions say, and the program itself, which execve() has to read.
+    // Returns false if they cannot be expressed.
+    bool prepare(const boost::filesystem::path &cwd, const std::string &exe,
+                 const std::vector<std::string> &writeableFiles);
+
+    // Must be called in the tracee before the seccomp filter is installed. Does not
+    // allocate or touch errno, returns 0 or the errno of the step that failed.
+    int restrictSelf() const;
+
+    // Landlock ABI version of the kernel, 0 without Landlock
+    static int abi();
+};
+
+
+#endif //INVOKE_LANDLOCKRULESET_HPP
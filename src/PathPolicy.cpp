@@ -0,0 +1,69 @@
+#include "PathPolicy.hpp"
+
+#include <cerrno>
+
+const std::vector<const char*> PathPolicy::atSyscalls = {
+        "openat", "newfstatat", "fstatat64", "statx", "faccessat", "faccessat2", "readlinkat",
+};
+
+const std::vector<std::pair<const char*, int>> PathPolicy::emptyPathSyscalls = {
+        { "newfstatat", 3 }, { "fstatat64", 3 }, { "statx", 2 },
+};
+
+void PathPolicy::build(const InvokerProfile &profile) {
+    if (profile.trie) {
+        // compiled when the profile was loaded
+        lookup = profile.trie;
+    } else {
+        trie.build(profile.paths, profile.defaultPathAccess);
+        lookup = &trie;
+    }
+}
+
+void PathPolicy::setWorkingDirectory(const boost::filesystem::path &cwd,
+                                     const std::vector<std::string> &writeableFiles) {
+    this->cwd = cwd;
+    this->writeableFiles = writeableFiles;
+}
+
+const boost::filesystem::path &PathPolicy::workingDirectory() const {
+    return cwd;
+}
+
+PathAccess PathPolicy::check(const boost::filesystem::path &path) const {
+    if (path == cwd) {
+        // runtimes resolve the script they run against it
+        return PathAccess::ReadOnly;
+    }
+    if (path.parent_path() == cwd) {
+        auto filename = path.filename();
+        for (const std::string &file : writeableFiles) {
+            if (filename == file) {
+                return PathAccess::ReadWrite;
+            }
+        }
+        return PathAccess::ReadOnly;
+    }
+
+    return lookup->lookup(path);
+}
+
+int PathPolicy::verdict(PathAccess access, bool write, bool &security) const {
+    switch (access) {
+        case PathAccess::ReadWrite:
+            return 0;
+        case PathAccess::ReadOnly:
+            return write ? EACCES : 0;
+        case PathAccess::ReadOnlySecurity:
+            if (!write) {
+                return 0;
+            }
+            security = true;
+            return EACCES;
+        case PathAccess::Security:
+            security = true;
+            return EACCES;
+        default:
+            return EACCES;
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef INVOKE_PATHPOLICY_HPP
+#define INVOKE_PATHPOLICY_HPP
+
+#include <string>
+#include <vector>
+#include <boost/filesystem/path.hpp>
+#include "InvokerProfile.hpp"
+#include "PathTrie.hpp"
+
+// How the invokers that see path syscalls one at a time decide on them: the working
+// directory and the files right in it are readable, everything else is up to the profile.
+class PathPolicy {
+private:
+    PathTrie trie;
+    const PathTrie *lookup = nullptr;
+    boost::filesystem::path cwd;
+    std::vector<std::string> writeableFiles;
+
+public:
+    // syscalls that take a directory descriptor before their path
+    static const std::vector<const char*> atSyscalls;
+    // those of them that work on the descriptor itself given an empty path and
+    // AT_EMPTY_PATH, with the index of the argument holding their flags
+    static const std::vector<std::pair<const char*, int>> emptyPathSyscalls;
+
+    void build(const InvokerProfile &profile);
+
+    // absolute and canonical, relative paths of the program start there
+    void setWorkingDirectory(const boost::filesystem::path &cwd, const std::vector<std::string> &writeableFiles);
+    const boost::filesystem::path &workingDirectory() const;
+
+    // the path must be absolute and lexically normal
+    PathAccess check(const boost::filesystem::path &path) const;
+
+    // Returns 0 if a syscall may go on with `access` to its path, or the errno to fail it with.
+    // Read-only paths only refuse writes. Sets `security` if failing is a violation.
+    int verdict(PathAccess access, bool write, bool &security) const;
+};
+
+
+#endif //INVOKE_PATHPOLICY_HPP
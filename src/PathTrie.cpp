@@ -0,0 +1,171 @@
+#include "PathTrie.hpp"
+
+#include <cstring>
+#include <deque>
+#include <map>
+
+namespace {
+
+struct BuildNode {
+    std::map<std::string, int> children;
+    int directory = -1;
+    int file = -1;
+};
+
+int buildChild(std::vector<BuildNode> &tree, int node, const std::string &name) {
+    auto it = tree[node].children.find(name);
+    if (it != tree[node].children.end()) {
+        return it->second;
+    }
+    int next = (int)tree.size();
+    tree[node].children[name] = next;
+    tree.emplace_back();
+    return next;
+}
+
+}
+
+void PathTrie::build(const ProfileList<PathPermission> &paths, PathAccess defaultAccess) {
+    this->defaultAccess = defaultAccess;
+    std::vector<BuildNode> tree(1);
+    ownAccesses.clear();
+
+    for (const PathPermission &permission : paths) {
+        size_t length = strlen(permission.path);
+        if (length == 0) continue;
+        int index = (int)ownAccesses.size();
+        ownAccesses.push_back(permission.access);
+
+        boost::filesystem::path cur(permission.path);
+        bool directory = permission.path[length - 1] == '/';
+        if (directory && cur.filename() == ".") {
+            cur.remove_filename();
+        }
+
+        int node = 0;
+        for (const boost::filesystem::path &element : cur) {
+            node = buildChild(tree, node, element.native());
+        }
+
+        if (directory) {
+            tree[node].directory = index;
+        } else {
+            tree[node].file = index;
+        }
+    }
+
+    // breadth first, so the children of every node get consecutive edges
+    ownNodes.assign(tree.size(), Node());
+    ownEdges.clear();
+    ownNames.clear();
+    std::vector<uint32_t> flatIndex(tree.size(), 0);
+    std::deque<int> pending(1, 0);
+    uint32_t assigned = 1;
+    while (!pending.empty()) {
+        int current = pending.front();
+        pending.pop_front();
+
+        Node &node = ownNodes[flatIndex[current]];
+        node.firstEdge = (uint32_t)ownEdges.size();
+        node.edgeCount = (uint32_t)tree[current].children.size();
+        node.directory = tree[current].directory;
+        node.file = tree[current].file;
+
+        // std::map keeps the names sorted the way findChild() searches them
+        for (auto &child : tree[current].children) {
+            flatIndex[child.second] = assigned++;
+            ownEdges.push_back({ (uint32_t)ownNames.size(), (uint32_t)child.first.size(), flatIndex[child.second] });
+            ownNames += child.first;
+            pending.push_back(child.second);
+        }
+    }
+
+    nodes = ownNodes.data();
+    nodeCount = ownNodes.size();
+    edges = ownEdges.data();
+    names = ownNames.data();
+    accesses = ownAccesses.data();
+}
+
+bool PathTrie::attach(const Node *nodes, size_t nodeCount, const Edge *edges, size_t edgeCount,
+                      const char *names, size_t namesSize, const PathAccess *accesses, size_t accessCount,
+                      PathAccess defaultAccess) {
+    if (nodeCount == 0) {
+        return false;
+    }
+    for (size_t i = 0; i < nodeCount; ++i) {
+        const Node &node = nodes[i];
+        if (node.firstEdge > edgeCount || node.edgeCount > edgeCount - node.firstEdge ||
+            node.directory >= (int64_t)accessCount || node.file >= (int64_t)accessCount) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < edgeCount; ++i) {
+        const Edge &edge = edges[i];
+        if (edge.node >= nodeCount || edge.name > namesSize || edge.length > namesSize - edge.name) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < accessCount; ++i) {
+        if (accesses[i] < PathAccess::ReadWrite || accesses[i] > PathAccess::Security) {
+            return false;
+        }
+    }
+
+    ownNodes.clear();
+    ownEdges.clear();
+    ownNames.clear();
+    ownAccesses.clear();
+    this->nodes = nodes;
+    this->nodeCount = nodeCount;
+    this->edges = edges;
+    this->names = names;
+    this->accesses = accesses;
+    this->defaultAccess = defaultAccess;
+    return true;
+}
+
+int PathTrie::findChild(const Node &node, const std::string &name) const {
+    // binary search in the same order as std::string::compare()
+    uint32_t low = node.firstEdge, high = node.firstEdge + node.edgeCount;
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        const Edge &edge = edges[middle];
+        int order = std::char_traits<char>::compare(names + edge.name, name.data(),
+                                                    std::min<size_t>(edge.length, name.size()));
+        if (order == 0) {
+            order = edge.length < name.size() ? -1 : (edge.length > name.size() ? 1 : 0);
+        }
+        if (order == 0) {
+            return (int)edge.node;
+        }
+        if (order < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return -1;
+}
+
+PathAccess PathTrie::lookup(const boost::filesystem::path &path) const {
+    int best = nodeCount == 0 ? -1 : nodes[0].directory;
+    int node = 0;
+
+    for (auto it = path.begin(); it != path.end() && nodeCount != 0; ++it) {
+        node = findChild(nodes[node], it->native());
+        if (node < 0) {
+            break;
+        }
+        best = std::max(best, nodes[node].directory);
+    }
+
+    if (node > 0) {
+        best = std::max(best, nodes[node].file);
+    }
+
+    if (best < 0) {
+        return defaultAccess;
+    }
+    return accesses[best];
+}
@@ -0,0 +1,70 @@
+#ifndef INVOKE_PATHTRIE_HPP
+#define INVOKE_PATHTRIE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <boost/filesystem/path.hpp>
+#include "InvokerProfile.hpp"
+
+// Path permissions of a profile keyed by path component, so that a lookup costs
+// one step per component of the path no matter how many permissions there are.
+// As with a linear scan, the permission listed last wins.
+//
+// The trie is kept in flat arrays without pointers, so a compiled profile can carry
+// it in its cache file and attach() it right from the mapped file.
+class PathTrie {
+public:
+    struct Node {
+        // children are edges [firstEdge, firstEdge + edgeCount), sorted by name
+        uint32_t firstEdge;
+        uint32_t edgeCount;
+        // index of the last permission for this directory and everything below it
+        int32_t directory;
+        // index of the last permission for exactly this path
+        int32_t file;
+    };
+
+    struct Edge {
+        // offset and length of the path component in the names
+        uint32_t name;
+        uint32_t length;
+        uint32_t node;
+    };
+
+private:
+    std::vector<Node> ownNodes;
+    std::vector<Edge> ownEdges;
+    std::string ownNames;
+    std::vector<PathAccess> ownAccesses;
+
+    const Node *nodes = nullptr;
+    size_t nodeCount = 0;
+    const Edge *edges = nullptr;
+    const char *names = nullptr;
+    const PathAccess *accesses = nullptr;
+    PathAccess defaultAccess = PathAccess::Denied;
+
+    int findChild(const Node &node, const std::string &name) const;
+
+public:
+    void build(const ProfileList<PathPermission> &paths, PathAccess defaultAccess);
+
+    // Use arrays laid out by build() that live elsewhere. Returns false without
+    // attaching if they are inconsistent, so a damaged cache cannot crash lookups.
+    bool attach(const Node *nodes, size_t nodeCount, const Edge *edges, size_t edgeCount,
+                const char *names, size_t namesSize, const PathAccess *accesses, size_t accessCount,
+                PathAccess defaultAccess);
+
+    PathAccess lookup(const boost::filesystem::path &path) const;
+
+    // the arrays of a built trie, to be stored and attached later
+    const std::vector<Node> &nodeArray() const { return ownNodes; }
+    const std::vector<Edge> &edgeArray() const { return ownEdges; }
+    const std::string &nameArray() const { return ownNames; }
+    const std::vector<PathAccess> &accessArray() const { return ownAccesses; }
+};
+
+
+#endif //INVOKE_PATHTRIE_HPP
@@ -0,0 +1,680 @@
+#include "ProfileLoader.hpp"
+#include "PathTrie.hpp"
+#include "tables/linux_i386.hpp"
+#include "tables/linux_x86_64.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+namespace {
+
+// architectures to resolve syscall actions for, as generate.py does for built-in profiles
+struct ProfileArch {
+    const char *name;
+    const SyscallTable *table;
+};
+
+const size_t ARCH_COUNT = 2;
+const ProfileArch ARCHS[ARCH_COUNT] = {
+    { "i386", &linux_i386_table },
+    { "x86_64", &linux_x86_64_table },
+};
+
+// Layout of a compiled profile. Every section starts 8-byte aligned, names are
+// offsets of NUL-terminated strings in the strings section.
+const char IMAGE_MAGIC[8] = { 'I', 'N', 'V', 'P', 'R', 'O', 'F', '\0' };
+const uint32_t IMAGE_VERSION = 3;
+
+enum ImageSection {
+    SECTION_STRINGS,
+    SECTION_SYSCALLS,
+    SECTION_PATHS,
+    SECTION_TRIE_NODES,
+    SECTION_TRIE_EDGES,
+    SECTION_TRIE_NAMES,
+    SECTION_TRIE_ACCESSES,
+    // followed by the actions of every architecture
+    SECTION_ACTIONS,
+    SECTION_COUNT = SECTION_ACTIONS + ARCH_COUNT,
+};
+
+struct ImageRange {
+    uint64_t offset;
+    uint64_t size;
+};
+
+struct ImageHeader {
+    char magic[8];
+    uint32_t version;
+    // of the syscall tables compiled into invoke, numbers change with them
+    uint32_t fingerprint;
+    // of the JSON file the image was compiled from
+    uint64_t sourceSize;
+    int64_t sourceTime;
+    // name of the extended profile in the strings, NO_PARENT if there is none
+    uint32_t parent;
+    uint32_t reserved;
+    // digest() of the extended profile the image was merged with
+    uint64_t parentDigest;
+    int32_t defaultSyscallAction;
+    int32_t defaultPathAccess;
+    int64_t processLimit;
+    ImageRange sections[SECTION_COUNT];
+};
+
+const uint32_t NO_PARENT = UINT32_MAX;
+
+struct ImageEntry {
+    uint32_t name;
+    int32_t value;
+};
+
+static_assert(sizeof(SyscallAction) == sizeof(int32_t), "actions are stored as 32-bit values");
+static_assert(sizeof(PathAccess) == sizeof(int32_t), "accesses are stored as 32-bit values");
+
+// a profile as written in its JSON file, merged with the profile it extends
+struct SourceProfile {
+    std::string extends;
+    uint64_t parentDigest = 0;
+    bool hasSyscallAction = false;
+    SyscallAction defaultSyscallAction = SyscallAction::Security;
+    bool hasPathAccess = false;
+    PathAccess defaultPathAccess = PathAccess::Security;
+    bool hasProcessLimit = false;
+    long processLimit = 0;
+    std::vector<std::pair<std::string, SyscallAction>> syscalls;
+    std::vector<std::pair<std::string, PathAccess>> paths;
+};
+
+struct LoadedProfile {
+    std::string name;
+    // the image, mapped from the cache or compiled in memory
+    void *mapping = MAP_FAILED;
+    size_t mappingSize = 0;
+    std::string buffer;
+
+    std::vector<SyscallPolicy> syscalls;
+    std::vector<PathPermission> paths;
+    std::vector<ProfileActions> actions;
+    PathTrie trie;
+    InvokerProfile profile;
+
+    ~LoadedProfile() {
+        if (mapping != MAP_FAILED) {
+            munmap(mapping, mappingSize);
+        }
+    }
+};
+
+std::mutex registryLock;
+std::string profileDirectory;
+std::string cacheDirectory;
+std::map<std::string, std::unique_ptr<LoadedProfile>> registry;
+
+std::string profileError(const std::string &name, const std::string &message) {
+    return "Profile '" + name + "': " + message;
+}
+
+bool validName(const std::string &name) {
+    if (name.empty() || name[0] == '.') {
+        return false;
+    }
+    for (char c : name) {
+        if (!isalnum((unsigned char)c) && c != '_' && c != '-' && c != '.') {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t tablesFingerprint() {
+    // FNV-1a over every syscall name in order
+    uint32_t hash = 2166136261u;
+    auto mix = [&hash](const char *text) {
+        for (; *text; ++text) {
+            hash = (hash ^ (uint8_t)*text) * 16777619u;
+        }
+        hash = (hash ^ 0xff) * 16777619u;
+    };
+    for (const ProfileArch &arch : ARCHS) {
+        mix(arch.name);
+        for (int i = 0; i < arch.table->size; ++i) {
+            mix(arch.table->names[i] ? arch.table->names[i] : "");
+        }
+    }
+    return hash;
+}
+
+SyscallAction parseSyscallAction(const std::string &name, const std::string &value) {
+    static const std::map<std::string, SyscallAction> actions = {
+        { "Allow", SyscallAction::Allow },
+        { "CheckPath", SyscallAction::CheckPath },
+        { "CheckPathSecurity", SyscallAction::CheckPathSecurity },
+        { "Deny", SyscallAction::Deny },
+        { "Security", SyscallAction::Security },
+    };
+    auto it = actions.find(value);
+    if (it == actions.end()) {
+        throw std::invalid_argument(profileError(name, "unknown syscall action '" + value + "'"));
+    }
+    return it->second;
+}
+
+PathAccess parsePathAccess(const std::string &name, const std::string &value) {
+    static const std::map<std::string, PathAccess> accesses = {
+        { "ReadWrite", PathAccess::ReadWrite },
+        { "ReadOnly", PathAccess::ReadOnly },
+        { "ReadOnlySecurity", PathAccess::ReadOnlySecurity },
+        { "Denied", PathAccess::Denied },
+        { "Security", PathAccess::Security },
+    };
+    auto it = accesses.find(value);
+    if (it == accesses.end()) {
+        throw std::invalid_argument(profileError(name, "unknown path access '" + value + "'"));
+    }
+    return it->second;
+}
+
+// the strings of a JSON array
+std::vector<std::string> parseList(const std::string &name, const boost::property_tree::ptree &list,
+                                   const std::string &key) {
+    std::vector<std::string> items;
+    for (auto &item : list) {
+        if (!item.first.empty() || !item.second.empty()) {
+            throw std::invalid_argument(profileError(name, "'" + key + "' must be a list of strings"));
+        }
+        items.push_back(item.second.data());
+    }
+    if (items.empty() && !list.data().empty()) {
+        throw std::invalid_argument(profileError(name, "'" + key + "' must be a list of strings"));
+    }
+    return items;
+}
+
+SourceProfile parseSource(const std::string &name, const std::string &filename) {
+    boost::property_tree::ptree tree;
+    try {
+        boost::property_tree::read_json(filename, tree);
+    } catch (boost::property_tree::json_parser_error &e) {
+        throw std::invalid_argument(profileError(name, e.what()));
+    }
+
+    SourceProfile source;
+    for (auto &section : tree) {
+        if (section.first == "extends") {
+            if (!section.second.empty() || section.second.data().empty()) {
+                throw std::invalid_argument(profileError(name, "'extends' must be the name of a profile"));
+            }
+            source.extends = section.second.data();
+        } else if (section.first == "processLimit") {
+            char *end;
+            const std::string &value = section.second.data();
+            source.processLimit = strtol(value.c_str(), &end, 10);
+            if (!section.second.empty() || value.empty() || *end != '\0' || source.processLimit < 0) {
+                throw std::invalid_argument(profileError(name, "'processLimit' must be a number of processes"));
+            }
+            source.hasProcessLimit = true;
+        } else if (section.first == "syscalls") {
+            for (auto &entry : section.second) {
+                if (entry.first == "default") {
+                    source.hasSyscallAction = true;
+                    source.defaultSyscallAction = parseSyscallAction(name, entry.second.data());
+                    continue;
+                }
+                SyscallAction action = parseSyscallAction(name, entry.first);
+                for (const std::string &syscall : parseList(name, entry.second, entry.first)) {
+                    source.syscalls.emplace_back(syscall, action);
+                }
+            }
+        } else if (section.first == "paths") {
+            for (auto &entry : section.second) {
+                if (entry.first == "default") {
+                    source.hasPathAccess = true;
+                    source.defaultPathAccess = parsePathAccess(name, entry.second.data());
+                    continue;
+                }
+                PathAccess access = parsePathAccess(name, entry.first);
+                for (const std::string &path : parseList(name, entry.second, entry.first)) {
+                    source.paths.emplace_back(path, access);
+                }
+            }
+        } else {
+            throw std::invalid_argument(profileError(name, "unknown section '" + section.first + "'"));
+        }
+    }
+
+    // a misspelt syscall would silently get the default action
+    std::vector<std::string> unknown;
+    for (auto &syscall : source.syscalls) {
+        bool known = false;
+        for (const ProfileArch &arch : ARCHS) {
+            known = known || arch.table->find(syscall.first.c_str()) >= 0;
+        }
+        if (!known) {
+            unknown.push_back("'" + syscall.first + "'");
+        }
+    }
+    if (!unknown.empty()) {
+        std::string list;
+        for (const std::string &syscall : unknown) {
+            list += (list.empty() ? "" : ", ") + syscall;
+        }
+        throw std::invalid_argument(profileError(name, "unknown syscalls " + list));
+    }
+    return source;
+}
+
+// Identifies the merged content of a profile, so that images of profiles extending it
+// can tell whether they are stale.
+uint64_t digest(const InvokerProfile &profile) {
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const char *data, size_t size) {
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ (uint8_t)data[i]) * 1099511628211ull;
+        }
+    };
+    auto mixValue = [&mix](int32_t value) {
+        mix(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+
+    mixValue((int32_t)profile.defaultSyscallAction);
+    mixValue((int32_t)profile.defaultPathAccess);
+    mixValue((int32_t)profile.processLimit);
+    for (const SyscallPolicy &policy : profile.syscalls) {
+        mix(policy.syscall, strlen(policy.syscall) + 1);
+        mixValue((int32_t)policy.action);
+    }
+    mixValue(-1);
+    for (const PathPermission &permission : profile.paths) {
+        mix(permission.path, strlen(permission.path) + 1);
+        mixValue((int32_t)permission.access);
+    }
+    return hash;
+}
+
+// Put the entries of source after those of the profile it extends, an entry of the same
+// syscall or path overrides the inherited one.
+template<typename T, typename Value>
+void mergeEntries(std::vector<std::pair<std::string, Value>> &entries, const ProfileList<T> &inherited,
+                  const char *T::*name, Value T::*value) {
+    std::set<std::string> overridden;
+    for (auto &entry : entries) {
+        overridden.insert(entry.first);
+    }
+    std::vector<std::pair<std::string, Value>> merged;
+    for (const T &item : inherited) {
+        if (!overridden.count(item.*name)) {
+            merged.emplace_back(item.*name, item.*value);
+        }
+    }
+    merged.insert(merged.end(), entries.begin(), entries.end());
+    entries.swap(merged);
+}
+
+void mergeParent(SourceProfile &source, const InvokerProfile &parent) {
+    source.parentDigest = digest(parent);
+    if (!source.hasSyscallAction) {
+        source.defaultSyscallAction = parent.defaultSyscallAction;
+    }
+    if (!source.hasPathAccess) {
+        source.defaultPathAccess = parent.defaultPathAccess;
+    }
+    if (!source.hasProcessLimit) {
+        source.processLimit = parent.processLimit;
+    }
+    mergeEntries(source.syscalls, parent.syscalls, &SyscallPolicy::syscall, &SyscallPolicy::action);
+    mergeEntries(source.paths, parent.paths, &PathPermission::path, &PathPermission::access);
+}
+
+template<typename T>
+void appendSection(std::string &image, ImageHeader &header, ImageSection section, const T *data, size_t count) {
+    image.resize((image.size() + 7) & ~(size_t)7, '\0');
+    header.sections[section].offset = image.size();
+    header.sections[section].size = count * sizeof(T);
+    image.append(reinterpret_cast<const char*>(data), count * sizeof(T));
+}
+
+std::string compile(const SourceProfile &source, const struct stat &info) {
+    ImageHeader header = {};
+    memcpy(header.magic, IMAGE_MAGIC, sizeof(header.magic));
+    header.version = IMAGE_VERSION;
+    header.fingerprint = tablesFingerprint();
+    header.sourceSize = (uint64_t)info.st_size;
+    header.sourceTime = (int64_t)info.st_mtim.tv_sec * 1000000000 + info.st_mtim.tv_nsec;
+    header.parent = NO_PARENT;
+    header.parentDigest = source.parentDigest;
+    header.defaultSyscallAction = (int32_t)source.defaultSyscallAction;
+    header.defaultPathAccess = (int32_t)source.defaultPathAccess;
+    header.processLimit = source.processLimit;
+
+    std::string strings;
+    auto intern = [&strings](const std::string &text) {
+        uint32_t offset = (uint32_t)strings.size();
+        strings += text;
+        strings += '\0';
+        return offset;
+    };
+
+    if (!source.extends.empty()) {
+        header.parent = intern(source.extends);
+    }
+
+    std::vector<ImageEntry> syscalls, paths;
+    for (auto &syscall : source.syscalls) {
+        syscalls.push_back({ intern(syscall.first), (int32_t)syscall.second });
+    }
+    std::vector<PathPermission> permissions;
+    for (auto &path : source.paths) {
+        paths.push_back({ intern(path.first), (int32_t)path.second });
+        permissions.push_back({ path.first.c_str(), path.second });
+    }
+
+    PathTrie trie;
+    trie.build({ permissions.data(), permissions.size() }, source.defaultPathAccess);
+
+    std::string image(sizeof(header), '\0');
+    appendSection(image, header, SECTION_STRINGS, strings.data(), strings.size());
+    appendSection(image, header, SECTION_SYSCALLS, syscalls.data(), syscalls.size());
+    appendSection(image, header, SECTION_PATHS, paths.data(), paths.size());
+    appendSection(image, header, SECTION_TRIE_NODES, trie.nodeArray().data(), trie.nodeArray().size());
+    appendSection(image, header, SECTION_TRIE_EDGES, trie.edgeArray().data(), trie.edgeArray().size());
+    appendSection(image, header, SECTION_TRIE_NAMES, trie.nameArray().data(), trie.nameArray().size());
+    appendSection(image, header, SECTION_TRIE_ACCESSES, trie.accessArray().data(), trie.accessArray().size());
+
+    for (size_t arch = 0; arch < ARCH_COUNT; ++arch) {
+        std::vector<SyscallAction> actions;
+        for (auto &syscall : source.syscalls) {
+            int number = ARCHS[arch].table->find(syscall.first.c_str());
+            if (number < 0) {
+                continue;
+            }
+            if ((size_t)number >= actions.size()) {
+                actions.resize((size_t)number + 1, SyscallAction::Unspecified);
+            }
+            actions[number] = syscall.second;
+        }
+        appendSection(image, header, (ImageSection)(SECTION_ACTIONS + arch), actions.data(), actions.size());
+    }
+
+    image.replace(0, sizeof(header), reinterpret_cast<const char*>(&header), sizeof(header));
+    return image;
+}
+
+template<typename T>
+const T *sectionData(const char *image, const ImageHeader &header, ImageSection section, size_t &count) {
+    count = header.sections[section].size / sizeof(T);
+    return reinterpret_cast<const T*>(image + header.sections[section].offset);
+}
+
+// Point the profile at an image. Fails if the image was compiled from another source
+// or by another invoke, or if it is damaged.
+bool attach(LoadedProfile &loaded, const char *image, size_t size, const struct stat &source,
+            const std::function<const InvokerProfile*(const std::string&)> &findParent) {
+    if (size < sizeof(ImageHeader)) {
+        return false;
+    }
+    ImageHeader header;
+    memcpy(&header, image, sizeof(header));
+    if (memcmp(header.magic, IMAGE_MAGIC, sizeof(header.magic)) != 0 || header.version != IMAGE_VERSION ||
+        header.fingerprint != tablesFingerprint() || header.sourceSize != (uint64_t)source.st_size ||
+        header.sourceTime != (int64_t)source.st_mtim.tv_sec * 1000000000 + source.st_mtim.tv_nsec) {
+        return false;
+    }
+
+    for (const ImageRange &range : header.sections) {
+        if (range.offset % 8 != 0 || range.offset > size || range.size > size - range.offset) {
+            return false;
+        }
+    }
+    if (header.defaultSyscallAction < (int32_t)SyscallAction::Unspecified ||
+        header.defaultSyscallAction > (int32_t)SyscallAction::Security ||
+        header.defaultPathAccess < (int32_t)PathAccess::ReadWrite ||
+        header.defaultPathAccess > (int32_t)PathAccess::Security || header.processLimit < 0) {
+        return false;
+    }
+
+    size_t stringsSize = header.sections[SECTION_STRINGS].size;
+    const char *strings = image + header.sections[SECTION_STRINGS].offset;
+    if (stringsSize > 0 && strings[stringsSize - 1] != '\0') {
+        return false;
+    }
+
+    if (header.parent != NO_PARENT) {
+        // changes to the extended profile must show in this one
+        const InvokerProfile *parent = header.parent < stringsSize ? findParent(strings + header.parent) : nullptr;
+        if (!parent || digest(*parent) != header.parentDigest) {
+            return false;
+        }
+    }
+
+    size_t count;
+    const ImageEntry *syscalls = sectionData<ImageEntry>(image, header, SECTION_SYSCALLS, count);
+    loaded.syscalls.clear();
+    for (size_t i = 0; i < count; ++i) {
+        if (syscalls[i].name >= stringsSize || syscalls[i].value <= (int32_t)SyscallAction::Unspecified ||
+            syscalls[i].value > (int32_t)SyscallAction::Security) {
+            return false;
+        }
+        loaded.syscalls.push_back({ strings + syscalls[i].name, (SyscallAction)syscalls[i].value });
+    }
+
+    const ImageEntry *paths = sectionData<ImageEntry>(image, header, SECTION_PATHS, count);
+    loaded.paths.clear();
+    for (size_t i = 0; i < count; ++i) {
+        if (paths[i].name >= stringsSize || paths[i].value < (int32_t)PathAccess::ReadWrite ||
+            paths[i].value > (int32_t)PathAccess::Security) {
+            return false;
+        }
+        loaded.paths.push_back({ strings + paths[i].name, (PathAccess)paths[i].value });
+    }
+
+    loaded.actions.clear();
+    for (size_t arch = 0; arch < ARCH_COUNT; ++arch) {
+        const int32_t *values = sectionData<int32_t>(image, header, (ImageSection)(SECTION_ACTIONS + arch), count);
+        for (size_t i = 0; i < count; ++i) {
+            if (values[i] < (int32_t)SyscallAction::Unspecified || values[i] > (int32_t)SyscallAction::Security) {
+                return false;
+            }
+        }
+        // used in place, this is the part that grows with the syscall tables
+        loaded.actions.push_back({ ARCHS[arch].name, reinterpret_cast<const SyscallAction*>(values), count });
+    }
+
+    size_t nodeCount, edgeCount, accessCount;
+    const PathTrie::Node *nodes = sectionData<PathTrie::Node>(image, header, SECTION_TRIE_NODES, nodeCount);
+    const PathTrie::Edge *edges = sectionData<PathTrie::Edge>(image, header, SECTION_TRIE_EDGES, edgeCount);
+    const PathAccess *accesses = sectionData<PathAccess>(image, header, SECTION_TRIE_ACCESSES, accessCount);
+    const char *names = image + header.sections[SECTION_TRIE_NAMES].offset;
+    if (!loaded.trie.attach(nodes, nodeCount, edges, edgeCount, names, header.sections[SECTION_TRIE_NAMES].size,
+                            accesses, accessCount,
+                            (PathAccess)header.defaultPathAccess)) {
+        return false;
+    }
+
+    loaded.profile = {
+        loaded.name.c_str(),
+        (SyscallAction)header.defaultSyscallAction,
+        (PathAccess)header.defaultPathAccess,
+        { loaded.syscalls.data(), loaded.syscalls.size() },
+        { loaded.paths.data(), loaded.paths.size() },
+        { loaded.actions.data(), loaded.actions.size() },
+        &loaded.trie,
+        (long)header.processLimit,
+    };
+    return true;
+}
+
+bool mapCache(LoadedProfile &loaded, const std::string &filename, const struct stat &source,
+              const std::function<const InvokerProfile*(const std::string&)> &findParent) {
+    int fd = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    void *mapping = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        mapping = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    if (!attach(loaded, static_cast<const char*>(mapping), (size_t)info.st_size, source, findParent)) {
+        munmap(mapping, (size_t)info.st_size);
+        return false;
+    }
+    loaded.mapping = mapping;
+    loaded.mappingSize = (size_t)info.st_size;
+    return true;
+}
+
+bool writeCache(const std::string &filename, const std::string &image) {
+    if (cacheDirectory.empty()) {
+        return false;
+    }
+    mkdir(cacheDirectory.c_str(), 0755);
+
+    // renamed into place, so concurrent loads never map a partial file
+    std::string temporary = filename + "." + std::to_string(getpid());
+    int fd = open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = write(fd, image.data(), image.size()) == (ssize_t)image.size();
+    ok = close(fd) == 0 && ok;
+    if (!ok || rename(temporary.c_str(), filename.c_str()) != 0) {
+        unlink(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+const InvokerProfile *loadProfile(const std::string &name, std::vector<std::string> chain);
+
+// the profile a profile extends, loaded profiles may extend built-in ones as well as each other
+const InvokerProfile *findParent(const std::string &name, const std::vector<std::string> &chain) {
+    const std::vector<std::string> &builtin = InvokerProfile::availableProfiles;
+    if (std::find(builtin.begin(), builtin.end(), name) != builtin.end()) {
+        return &InvokerProfile::getProfile(name);
+    }
+    if (std::find(chain.begin(), chain.end(), name) != chain.end()) {
+        std::string cycle;
+        for (const std::string &link : chain) {
+            cycle += link + " -> ";
+        }
+        throw std::invalid_argument(profileError(name, "extends itself (" + cycle + name + ")"));
+    }
+    return loadProfile(name, chain);
+}
+
+const InvokerProfile *loadProfile(const std::string &name, std::vector<std::string> chain) {
+    auto it = registry.find(name);
+    if (it != registry.end()) {
+        return &it->second->profile;
+    }
+
+    // names come from requests of daemon clients as well, they must stay in the directory
+    if (profileDirectory.empty() || !validName(name)) {
+        return nullptr;
+    }
+
+    std::string filename = profileDirectory + "/" + name + ".json";
+    struct stat source;
+    if (stat(filename.c_str(), &source) != 0) {
+        return nullptr;
+    }
+
+    chain.push_back(name);
+    auto parent = [&chain](const std::string &parentName) {
+        return findParent(parentName, chain);
+    };
+
+    std::unique_ptr<LoadedProfile> loaded(new LoadedProfile());
+    loaded->name = name;
+
+    std::string cacheFilename = cacheDirectory + "/" + name + ".bin";
+    if (cacheDirectory.empty() || !mapCache(*loaded, cacheFilename, source, parent)) {
+        SourceProfile parsed = parseSource(name, filename);
+        if (!parsed.extends.empty()) {
+            const InvokerProfile *extended = parent(parsed.extends);
+            if (!extended) {
+                throw std::invalid_argument(profileError(name, "extends unknown profile '" + parsed.extends + "'"));
+            }
+            mergeParent(parsed, *extended);
+        }
+
+        std::string image = compile(parsed, source);
+        if (!writeCache(cacheFilename, image) || !mapCache(*loaded, cacheFilename, source, parent)) {
+            // no usable cache, keep the image in memory
+            loaded->buffer = std::move(image);
+            if (!attach(*loaded, loaded->buffer.data(), loaded->buffer.size(), source, parent)) {
+                throw std::invalid_argument(profileError(name, "failed to compile"));
+            }
+        }
+    }
+
+    const InvokerProfile *profile = &loaded->profile;
+    registry[name] = std::move(loaded);
+    return profile;
+}
+
+}
+
+void ProfileLoader::setDirectory(const std::string &directory, const std::string &cache) {
+    std::lock_guard<std::mutex> guard(registryLock);
+    profileDirectory = directory;
+    cacheDirectory = cache.empty() && !directory.empty() ? directory + "/.cache" : cache;
+}
+
+const InvokerProfile *ProfileLoader::load(const std::string &name) {
+    std::lock_guard<std::mutex> guard(registryLock);
+    return loadProfile(name, std::vector<std::string>());
+}
+
+std::vector<std::string> ProfileLoader::available() {
+    std::string directory;
+    {
+        std::lock_guard<std::mutex> guard(registryLock);
+        directory = profileDirectory;
+    }
+
+    std::vector<std::string> names;
+    DIR *dir = directory.empty() ? nullptr : opendir(directory.c_str());
+    if (!dir) {
+        return names;
+    }
+    while (dirent *entry = readdir(dir)) {
+        std::string filename = entry->d_name;
+        const std::string suffix = ".json";
+        if (filename.size() > suffix.size() &&
+            filename.compare(filename.size() - suffix.size(), suffix.size(), suffix) == 0) {
+            std::string name = filename.substr(0, filename.size() - suffix.size());
+            if (validName(name)) {
+                names.push_back(name);
+            }
+        }
+    }
+    closedir(dir);
+    std::sort(names.begin(), names.end());
+    return names;
+}
@@ -0,0 +1,32 @@
+#ifndef INVOKE_PROFILELOADER_HPP
+#define INVOKE_PROFILELOADER_HPP
+
+#include <string>
+#include <vector>
+#include "InvokerProfile.hpp"
+
+// Profiles read at runtime from <directory>/<name>.json, in the same format as the
+// sources of the built-in ones. Each is compiled once into an image holding the
+// resolved syscall actions of every architecture and the path trie, which is cached
+// as <cache>/<name>.bin and mapped on later loads, so only a few small lists are
+// rebuilt. The cache is recompiled whenever the JSON file or invoke change.
+//
+// A profile may name another one, built-in or loaded, in "extends". It is merged into
+// the image, syscalls and paths listed again override the inherited entry, the
+// defaults and processLimit are inherited unless given. Images are recompiled when the profile they
+// extend changes as well.
+class ProfileLoader {
+public:
+    // the cache defaults to <directory>/.cache, without a usable cache profiles are compiled on every load
+    static void setDirectory(const std::string &directory, const std::string &cache = "");
+
+    // Loaded profiles stay for the lifetime of the process. Returns nullptr if there is
+    // no such file and throws std::invalid_argument if the profile is invalid.
+    static const InvokerProfile *load(const std::string &name);
+
+    // names of the profiles in the directory
+    static std::vector<std::string> available();
+};
+
+
+#endif //INVOKE_PROFILELOADER_HPP
@@ -0,0 +1,26 @@
+#ifndef INVOKE_RAWSYSCALL_HPP
+#define INVOKE_RAWSYSCALL_HPP
+
+// A syscall that leaves errno alone: returns the result, or -errno on failure.
+//
+// errno, like everything thread-local, lives in the TLS of whoever called clone(), so a
+// child cloned with CLONE_VM that calls into the C library would change errno under our
+// feet. Such children make their syscalls with this instead.
+inline long rawSyscall(long nr, long a1 = 0, long a2 = 0, long a3 = 0, long a4 = 0, long a5 = 0, long a6 = 0) {
+#if defined(__x86_64__)
+    long ret;
+    register long r10 __asm__("r10") = a4;
+    register long r8 __asm__("r8") = a5;
+    register long r9 __asm__("r9") = a6;
+    __asm__ volatile("syscall"
+                     : "=a"(ret)
+                     : "a"(nr), "D"(a1), "S"(a2), "d"(a3), "r"(r10), "r"(r8), "r"(r9)
+                     : "rcx", "r11", "memory");
+    return ret;
+#else
+#error "rawSyscall() is only written for x86_64"
+#endif
+}
+
+
+#endif //INVOKE_RAWSYSCALL_HPP
@@ -0,0 +1,161 @@
+#include "SeccompFilter.hpp"
+
+#include <cerrno>
+#include <cstddef>
+
+#include <sched.h>
+#include <unistd.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <linux/audit.h>
+#include <linux/seccomp.h>
+#include "RawSyscall.hpp"
+
+namespace {
+
+// CLONE_NEWTIME is missing, for clone() that bit is part of the exit signal
+const uint64_t CLONE_NAMESPACES = CLONE_NEWNS | CLONE_NEWCGROUP | CLONE_NEWUTS | CLONE_NEWIPC |
+                                  CLONE_NEWUSER | CLONE_NEWPID | CLONE_NEWNET;
+
+// the lower half of an argument on little-endian machines, all the kernel looks at of flags and of a pid_t
+uint32_t argumentLow(int index) {
+    return (uint32_t)(offsetof(seccomp_data, args) + index * sizeof(uint64_t));
+}
+
+}
+
+void SeccompFilter::ArgumentChecks::find(const SyscallTable &table) {
+    clone = table.find("clone");
+    clone3 = table.find("clone3");
+    prlimit64 = table.find("prlimit64");
+}
+
+int SeccompFilter::ArgumentChecks::error(long syscall, const uint64_t args[6]) const {
+    if (syscall < 0) {
+        return 0;
+    }
+    if (syscall == clone && ((uint32_t)args[0] & CLONE_NAMESPACES) != 0) {
+        return EPERM;
+    }
+    if (syscall == clone3) {
+        return ENOSYS;
+    }
+    if (syscall == prlimit64 && (int32_t)args[0] != 0) {
+        return EPERM;
+    }
+    return 0;
+}
+
+uint32_t SeccompFilter::actionToReturn(SyscallAction action) const {
+    switch (action) {
+        case SyscallAction::Allow:
+            return SECCOMP_RET_ALLOW;
+        case SyscallAction::Deny:
+            return SECCOMP_RET_ERRNO | (EPERM & SECCOMP_RET_DATA);
+        case SyscallAction::CheckPath:
+        case SyscallAction::CheckPathSecurity:
+            if (decider == Decider::Supervisor) {
+                return SECCOMP_RET_USER_NOTIF;
+            }
+            // fall through
+        default:
+            return decider == Decider::Tracer ? SECCOMP_RET_TRACE : SECCOMP_RET_KILL_PROCESS;
+    }
+}
+
+void SeccompFilter::build(uint32_t arch, const SyscallTable &table, const SyscallAction *actions, size_t count,
+                          size_t limit, SyscallAction defaultAction, Decider decider) {
+    program.clear();
+    this->decider = decider;
+    uint32_t undecided = actionToReturn(SyscallAction::Security);
+
+    ArgumentChecks checks;
+    checks.find(table);
+
+    uint32_t defaultReturn = actionToReturn(defaultAction);
+
+    // syscalls of a foreign architecture always need a decision
+    program.push_back(BPF_STMT(BPF_LD | BPF_W | BPF_ABS, offsetof(seccomp_data, arch)));
+    program.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, arch, 1, 0));
+    program.push_back(BPF_STMT(BPF_RET | BPF_K, undecided));
+
+    program.push_back(BPF_STMT(BPF_LD | BPF_W | BPF_ABS, offsetof(seccomp_data, nr)));
+    for (size_t syscall = 0; syscall < count; ++syscall) {
+        if (actions[syscall] == SyscallAction::Unspecified) {
+            continue;
+        }
+        if (actions[syscall] == SyscallAction::Allow &&
+            ((long)syscall == checks.clone || (long)syscall == checks.clone3 || (long)syscall == checks.prlimit64)) {
+            buildChecks(checks, (uint32_t)syscall);
+            continue;
+        }
+        uint32_t ret = actionToReturn(actions[syscall]);
+        if (ret == defaultReturn) {
+            continue;
+        }
+        program.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, (uint32_t)syscall, 0, 1));
+        program.push_back(BPF_STMT(BPF_RET | BPF_K, ret));
+    }
+
+    // numbers outside of the table, x32 syscalls among them, have no action anyone could decide on
+    program.push_back(BPF_JUMP(BPF_JMP | BPF_JGE | BPF_K, (uint32_t)limit, 0, 1));
+    program.push_back(BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_KILL_PROCESS));
+    program.push_back(BPF_STMT(BPF_RET | BPF_K, defaultReturn));
+}
+
+void SeccompFilter::buildChecks(const ArgumentChecks &checks, uint32_t syscall) {
+    const uint32_t allow = SECCOMP_RET_ALLOW;
+    const uint32_t eperm = SECCOMP_RET_ERRNO | (EPERM & SECCOMP_RET_DATA);
+
+    if (syscall == checks.clone3) {
+        program.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, syscall, 0, 1));
+        program.push_back(BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ERRNO | (ENOSYS & SECCOMP_RET_DATA)));
+        return;
+    }
+
+    // the argument replaces the number only where the syscall matched, the rest compare it as before
+    program.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, syscall, 0, 4));
+    program.push_back(BPF_STMT(BPF_LD | BPF_W | BPF_ABS, argumentLow(0)));
+    if (syscall == checks.clone) {
+        program.push_back(BPF_JUMP(BPF_JMP | BPF_JSET | BPF_K, (uint32_t)CLONE_NAMESPACES, 0, 1));
+    } else {
+        program.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 1, 0));
+    }
+    program.push_back(BPF_STMT(BPF_RET | BPF_K, eperm));
+    program.push_back(BPF_STMT(BPF_RET | BPF_K, allow));
+}
+
+long SeccompFilter::load(unsigned int flags) const {
+    sock_fprog prog = {
+            (unsigned short)program.size(),
+            const_cast<sock_filter*>(program.data()),
+    };
+
+    long error = rawSyscall(SYS_prctl, PR_SET_NO_NEW_PRIVS, 1, 0, 0, 0);
+    if (error < 0) {
+        return error;
+    }
+
+    return rawSyscall(SYS_seccomp, SECCOMP_SET_MODE_FILTER, flags, (long)&prog);
+}
+
+int SeccompFilter::install() const {
+    return (int)-load(0);
+}
+
+int SeccompFilter::installListener() const {
+    long fd = load(SECCOMP_FILTER_FLAG_NEW_LISTENER);
+    if (fd < 0) {
+        errno = (int)-fd;
+        return -1;
+    }
+    return (int)fd;
+}
+
+bool SeccompFilter::empty() const {
+    return program.empty();
+}
+
+bool SeccompFilter::available() {
+    return prctl(PR_GET_SECCOMP, 0, 0, 0, 0) >= 0;
+}
@@ -0,0 +1,66 @@
+#ifndef INVOKE_SECCOMPFILTER_HPP
+#define INVOKE_SECCOMPFILTER_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <linux/filter.h>
+#include "InvokerProfile.hpp"
+#include "SyscallTable.hpp"
+
+class SeccompFilter {
+public:
+    // who gets the syscalls that need a decision
+    enum class Decider {
+        Tracer,
+        // path checks are sent to the holder of the listener, everything else kills
+        Supervisor,
+        // nobody, they kill the process with SIGSYS
+        None,
+    };
+
+    // Syscalls that are checked on their arguments even where the profile allows them,
+    // by the filter or by a tracer that sees every syscall: clone() may not create
+    // namespaces, clone3() fails with ENOSYS, so that the C library falls back to clone(),
+    // whose flags are no pointer, and prlimit64() may only change the caller's own limits.
+    struct ArgumentChecks {
+        long clone = -1;
+        long clone3 = -1;
+        long prlimit64 = -1;
+
+        void find(const SyscallTable &table);
+        // 0 to let an allowed syscall through, otherwise the errno to fail it with
+        int error(long syscall, const uint64_t args[6]) const;
+    };
+
+private:
+    std::vector<sock_filter> program;
+
+    Decider decider = Decider::Tracer;
+
+    uint32_t actionToReturn(SyscallAction action) const;
+    void buildChecks(const ArgumentChecks &checks, uint32_t syscall);
+    // leaves errno alone, returns -errno on failure
+    long load(unsigned int flags) const;
+
+public:
+    // Compile per-syscall actions into a BPF program. Allow never leaves the kernel, but
+    // see ArgumentChecks, Deny fails with EPERM and everything that needs a decision goes
+    // to the decider. Numbers past `count` get the default action, those past `limit`
+    // kill the process.
+    void build(uint32_t arch, const SyscallTable &table, const SyscallAction *actions, size_t count, size_t limit,
+               SyscallAction defaultAction, Decider decider = Decider::Tracer);
+
+    // Must be called in the tracee right before execve(). Returns 0 or the errno, and
+    // leaves errno alone for a tracee that shares it with the tracer.
+    int install() const;
+    // Same for Decider::Supervisor, returns the close-on-exec listener descriptor or -1
+    int installListener() const;
+
+    bool empty() const;
+
+    static bool available();
+};
+
+
+#endif //INVOKE_SECCOMPFILTER_HPP
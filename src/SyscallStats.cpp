@@ -0,0 +1,51 @@
+#include "SyscallStats.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+double SyscallStats::overhead() const {
+    return tracerTime + (roundTrip > 0 ? roundTrip * (double)stops : 0);
+}
+
+void SyscallStats::print(std::ostream &out) const {
+    out << "tracer_stops: " << stops << std::endl;
+    out << "tracer_time: " << tracerTime << std::endl;
+    out << "tracer_read_time: " << readTime << std::endl;
+    out << "tracer_check_time: " << checkTime << std::endl;
+    out << "ptrace_overhead: " << overhead() << std::endl;
+
+    struct Entry {
+        const Arch *arch;
+        int syscall;
+    };
+    std::vector<Entry> entries;
+    for (const Arch &arch : archs) {
+        if (!arch.name) {
+            continue;
+        }
+        for (int i = 0; i < SYSCALL_MAX; ++i) {
+            if (arch.syscalls[i].entered != 0) {
+                entries.push_back({ &arch, i });
+            }
+        }
+    }
+
+    // the syscalls worth moving to Allow come first
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) {
+        return a.arch->syscalls[a.syscall].time > b.arch->syscalls[b.syscall].time;
+    });
+
+    out << "syscalls: [" << std::endl;
+    for (const Entry &entry : entries) {
+        const Counters &counters = entry.arch->syscalls[entry.syscall];
+        const char *name = entry.arch->table ? entry.arch->table->name(entry.syscall) : nullptr;
+        out << "    " << entry.arch->name << " " << (name ? name : std::to_string(entry.syscall))
+            << ": entered " << counters.entered
+            << ", allowed " << counters.allowed
+            << ", denied " << counters.denied
+            << ", checked " << counters.checked
+            << ", time " << counters.time << std::endl;
+    }
+    out << "]" << std::endl;
+}
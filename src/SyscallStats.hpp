@@ -0,0 +1,51 @@
+#ifndef INVOKE_SYSCALLSTATS_HPP
+#define INVOKE_SYSCALLSTATS_HPP
+
+#include <cstdint>
+#include <ostream>
+#include "SyscallTable.hpp"
+
+// What the tracer did during a run with InvokerConfig::stats. With a seccomp filter only
+// the syscalls it hands to the tracer stop there, so only those are counted.
+struct SyscallStats {
+    // same bound as the actions a tracer builds from a profile
+    static const int SYSCALL_MAX = 4096;
+
+    struct Counters {
+        uint64_t entered = 0;
+        uint64_t allowed = 0;
+        uint64_t denied = 0;
+        // of those entered, how many had their path checked
+        uint64_t checked = 0;
+        // spent deciding on the syscall
+        double time = 0;
+    };
+
+    struct Arch {
+        const char *name = nullptr;
+        const SyscallTable *table = nullptr;
+        Counters syscalls[SYSCALL_MAX];
+    };
+
+    // the native architecture and the compat one of its tracees
+    Arch archs[2];
+
+    // stops of the tracees, syscalls and everything else
+    uint64_t stops = 0;
+    // from a stop being reported until the tracee was resumed, the tracee waits all of it
+    double tracerTime = 0;
+    // of that, reading paths out of the tracee and looking them up in the profile
+    double readTime = 0;
+    double checkTime = 0;
+    // shortest time from resuming a tracee until it stopped again, roughly what
+    // the kernel and the scheduler add to every stop
+    double roundTrip = -1;
+
+    // estimate of the wall time the tracer added to the run
+    double overhead() const;
+
+    void print(std::ostream &out) const;
+};
+
+
+#endif //INVOKE_SYSCALLSTATS_HPP
@@ -1,9 +1,44 @@
 #ifndef INVOKE_SYSCALLTABLE_HPP
 #define INVOKE_SYSCALLTABLE_HPP
 
-#include <map>
-#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 
-typedef std::map<std::string, int> SyscallTable;
+// FNV-style hash, keep in sync with fnv_hash() in tables/generate.py
+inline uint32_t syscallNameHash(uint32_t seed, const char *name) {
+    uint32_t h = seed ? seed : 0x01000193u;
+    for (; *name; ++name) {
+        h = (h * 0x01000193u) ^ (unsigned char)*name;
+    }
+    return h;
+}
+
+// Generated by tables/generate.py: a dense number -> name array and a
+// minimal perfect hash for name -> number. All of it is constant data,
+// nothing is built at startup.
+struct SyscallTable {
+    const char *const *names;
+    int size;
+    const int32_t *hashDisplacements;
+    const int16_t *hashSlots;
+    uint32_t hashSize;
+
+    // -1 if the syscall does not exist in this table
+    int find(const char *name) const {
+        int32_t d = hashDisplacements[syscallNameHash(0, name) % hashSize];
+        uint32_t slot = d < 0 ? (uint32_t)(-d - 1) : syscallNameHash((uint32_t)d, name) % hashSize;
+        int number = hashSlots[slot];
+        return strcmp(names[number], name) == 0 ? number : -1;
+    }
+
+    // nullptr if there is no syscall with this number
+    const char *name(long number) const {
+        if (number < 0 || number >= size) {
+            return nullptr;
+        }
+        return names[number];
+    }
+};
 
 #endif //INVOKE_SYSCALLTABLE_HPP
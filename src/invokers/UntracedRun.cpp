@@ -0,0 +1,308 @@
+#include "UntracedRun.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#include <unistd.h>
+#include <poll.h>
+#include <sched.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <sys/timerfd.h>
+#include <sys/wait.h>
+#include <sys/time.h>
+#include <ctime>
+
+namespace {
+
+void armTimer(int fd, double seconds) {
+    double whole;
+    double fraction = modf(seconds, &whole);
+    itimerspec spec = {};
+    spec.it_value.tv_sec = (time_t)whole;
+    spec.it_value.tv_nsec = (long)(fraction * 1e9);
+    timerfd_settime(fd, 0, &spec, NULL);
+}
+
+}
+
+UntracedRun::UntracedRun(const InvokerConfig &config, InvokerResult &result) :
+    config(config), result(result) {
+
+}
+
+UntracedRun::~UntracedRun() {
+    closeCpuTimer();
+}
+
+void UntracedRun::fail(int error, const std::string &message) {
+    result.error = error;
+    result.errorMessage = message;
+    if (config.log) {
+        std::cerr << result.errorMessage << std::endl;
+    }
+}
+
+bool UntracedRun::setupCgroup(long extraProcesses) {
+    // before we pin ourselves to the tracer's CPU
+    cpuParallelism = 1;
+    cpu_set_t affinity;
+    if (config.cpu < 0 && sched_getaffinity(0, sizeof(affinity), &affinity) == 0) {
+        cpuParallelism = std::max(CPU_COUNT(&affinity), 1);
+    }
+    if (config.cpuQuota > 0) {
+        cpuParallelism = std::max(std::min(cpuParallelism, (int)ceil(config.cpuQuota)), 1);
+    }
+
+    bool ok = cgroup.create(config.cgroupRoot);
+    if (ok && config.memoryLimit > 0) {
+        ok = cgroup.setMemoryLimit(config.memoryLimit);
+    }
+    if (ok && config.maxProcesses() > 0) {
+        ok = cgroup.setProcessLimit(config.maxProcesses() + extraProcesses);
+    }
+    if (ok && config.cpuQuota > 0) {
+        ok = cgroup.setCpuLimit(config.cpuQuota);
+    }
+
+    if (!ok) {
+        fail(errno, std::string("Failed to set up cgroup: ") + strerror(errno));
+        cgroup.destroy();
+    }
+    return ok;
+}
+
+void UntracedRun::prepareExec() {
+    cargs.clear();
+    cargs.reserve(config.args.size() + 1);
+    for (const std::string &s : config.args) {
+        cargs.push_back(const_cast<char*>(s.c_str()));
+    }
+    cargs.push_back(NULL);
+
+    cenvp.clear();
+    if (!config.inheritEnvironment) {
+        cenvp.reserve(config.envp.size() + 1);
+        for (const std::string &s : config.envp) {
+            cenvp.push_back(const_cast<char*>(s.c_str()));
+        }
+        cenvp.push_back(NULL);
+    }
+}
+
+int UntracedRun::startCpuTimer() {
+    closeCpuTimer();
+    lastCpuCheck = 0.0;
+    if (config.timeLimit <= 0 || !cgroup.valid() || cgroup.cpuUsage() < 0) {
+        return -1;
+    }
+
+    cpuTimer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (cpuTimer >= 0) {
+        armTimer(cpuTimer, cpuCheckDelay());
+    }
+    return cpuTimer;
+}
+
+double UntracedRun::cpuCheckDelay() const {
+    // the cgroup can not use up the rest of the limit faster than on all of its CPUs at once
+    double remaining = config.timeLimit - lastCpuCheck;
+    return std::max(remaining / cpuParallelism, 0.001);
+}
+
+bool UntracedRun::onCpuTimer() {
+    uint64_t expirations;
+    read(cpuTimer, &expirations, sizeof(expirations));
+
+    lastCpuCheck = std::max(cgroup.cpuUsage(), lastCpuCheck);
+    if (lastCpuCheck < config.timeLimit) {
+        armTimer(cpuTimer, cpuCheckDelay());
+        return false;
+    }
+
+    if (config.log) {
+        std::cerr << "Program used up " << lastCpuCheck << "s of CPU time. Time Limit Exceeded" << std::endl;
+    }
+    result.timeLimitExceeded = true;
+    cgroup.killAll();
+    return true;
+}
+
+int UntracedRun::getCpuTimer() const {
+    return cpuTimer;
+}
+
+void UntracedRun::closeCpuTimer() {
+    if (cpuTimer >= 0) {
+        close(cpuTimer);
+        cpuTimer = -1;
+    }
+}
+
+bool UntracedRun::waitChild(pid_t pid, int &status, rusage &ru) {
+    int pidfd = (int)syscall(SYS_pidfd_open, pid, 0);
+
+    // without a pidfd the limits are only checked after the fact
+    if (pidfd >= 0 && (config.wallLimit > 0 || cpuTimer >= 0)) {
+        double deadline = getTime() + config.wallLimit;
+        pollfd fds[2] = {
+                { pidfd, POLLIN, 0 },
+                { cpuTimer, POLLIN, 0 },
+        };
+        for (;;) {
+            int timeout = -1;
+            if (config.wallLimit > 0) {
+                double left = deadline - getTime();
+                if (left <= 0) {
+                    if (config.log) {
+                        std::cerr << "Wall Time Limit exceeded" << std::endl;
+                    }
+                    result.wallLimitExceeded = true;
+                    syscall(SYS_pidfd_send_signal, pidfd, SIGKILL, NULL, 0);
+                    break;
+                }
+                timeout = (int)ceil(left * 1e3);
+            }
+
+            int ready = poll(fds, 2, timeout);
+            if (ready < 0 && errno != EINTR) {
+                break;
+            }
+            if (ready <= 0) {
+                continue;
+            }
+            if (fds[0].revents & POLLIN) {
+                break;
+            }
+            if ((fds[1].revents & POLLIN) && onCpuTimer()) {
+                break;
+            }
+        }
+    }
+
+    if (pidfd >= 0) {
+        close(pidfd);
+    }
+
+    return wait4(pid, &status, 0, &ru) == pid;
+}
+
+void UntracedRun::collect(int status, const rusage &ru) {
+    closeCpuTimer();
+
+    result.cpuUsage = cgroup.valid() ? cgroup.cpuUsage() : -1;
+    if (result.cpuUsage < 0) {
+        result.cpuUsage = tvToSeconds(ru.ru_utime) + tvToSeconds(ru.ru_stime);
+    }
+
+    result.memoryUsage = cgroup.valid() ? cgroup.memoryPeak() : -1;
+    if (result.memoryUsage < 0) {
+        result.memoryUsage = ru.ru_maxrss * 1024L;
+    }
+
+    if (cgroup.valid() && cgroup.oomKills() > 0) {
+        result.memoryLimitExceeded = true;
+    }
+
+    if (WIFEXITED(status)) {
+        result.exitCode = WEXITSTATUS(status);
+        if (config.log) {
+            std::cerr << "Program died with exit code " << result.exitCode << std::endl;
+        }
+    } else if (WIFSIGNALED(status)) {
+        result.exitCode = -WTERMSIG(status);
+        if (config.log) {
+            std::cerr << "Program died with signal " << -result.exitCode << std::endl;
+        }
+        if (WTERMSIG(status) == SIGXCPU) {
+            result.timeLimitExceeded = true;
+        }
+        if (WTERMSIG(status) == SIGSYS) {
+            // killed by the seccomp filter
+            result.securityViolation = true;
+        }
+    }
+
+    cgroup.destroy();
+
+    if (config.timeLimit > 0 && result.cpuUsage >= config.timeLimit) {
+        result.timeLimitExceeded = true;
+    }
+
+    if (config.memoryLimit > 0 && result.memoryUsage >= config.memoryLimit) {
+        result.memoryLimitExceeded = true;
+    }
+
+    if (config.wallLimit > 0 && result.wallClock >= config.wallLimit) {
+        result.wallLimitExceeded = true;
+    }
+}
+
+bool UntracedRun::redirectFiles() const {
+    if (!dupFile(STDIN_FILENO, config.stdin_fd) ||
+        !dupFile(STDOUT_FILENO, config.stdout_fd) ||
+        !dupFile(STDERR_FILENO, config.stderr_fd)) {
+        return false;
+    }
+    // one descriptor may serve several of them, so the originals go only now
+    for (int fd : { config.stdin_fd, config.stdout_fd, config.stderr_fd }) {
+        if (fd > STDERR_FILENO) {
+            close(fd);
+        }
+    }
+    return true;
+}
+
+void UntracedRun::setLimits(bool hardCpuLimit) const {
+    if (config.timeLimit > 0) {
+        // no one catches SIGXCPU here, it simply kills the program
+        auto cpu = (rlim_t)ceil(config.timeLimit);
+        setLimit(RLIMIT_CPU, cpu, hardCpuLimit ? cpu : cpu + 1);
+    }
+
+    if (config.memoryLimit > 0 && config.cgroupRoot.empty()) {
+        auto mem = (rlim_t)config.memoryLimit;
+        mem *= 2; // we need it to detect memory limits
+        setLimit(RLIMIT_AS, mem, mem);
+    }
+}
+
+int UntracedRun::exec() const {
+    if (config.inheritEnvironment) {
+        execv(config.exe.c_str(), cargs.data());
+    } else {
+        execve(config.exe.c_str(), cargs.data(), cenvp.data());
+    }
+    return errno;
+}
+
+bool UntracedRun::dupFile(int prev, int next) {
+    if (next < 0) {
+        return close(prev) == 0;
+    }
+    if (prev != next) {
+        return dup2(next, prev) >= 0;
+    }
+    return true;
+}
+
+void UntracedRun::setLimit(__rlimit_resource limit, rlim_t soft, rlim_t hard) {
+    rlimit lim = {
+            soft,
+            hard,
+    };
+    setrlimit(limit, &lim);
+}
+
+double UntracedRun::getTime() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+double UntracedRun::tvToSeconds(timeval tv) {
+    return 1.0 * tv.tv_sec + 1e-6 * tv.tv_usec;
+}
@@ -0,0 +1,64 @@
+#ifndef INVOKE_UNTRACEDRUN_HPP
+#define INVOKE_UNTRACEDRUN_HPP
+
+
+#include <string>
+#include <vector>
+#include <Cgroup.hpp>
+#include <InvokerConfig.hpp>
+#include <sys/resource.h>
+
+// What the invokers without a tracer share: the cgroup of a run, the child's way from
+// fork() to execve() and the verdicts once the program is gone.
+class UntracedRun {
+private:
+    const InvokerConfig &config;
+    InvokerResult &result;
+
+    std::vector<char*> cargs;
+    std::vector<char*> cenvp;
+
+    int cpuParallelism = 1;
+    int cpuTimer = -1;
+    double lastCpuCheck = 0.0;
+
+    double cpuCheckDelay() const;
+    void closeCpuTimer();
+
+public:
+    Cgroup cgroup;
+
+    UntracedRun(const InvokerConfig &config, InvokerResult &result);
+    ~UntracedRun();
+
+    void fail(int error, const std::string &message);
+    // extraProcesses are ours, e.g. a parent outside the program's pid namespace
+    bool setupCgroup(long extraProcesses = 0);
+    // before fork(), so that the child does not allocate
+    void prepareExec();
+    // A timerfd to check the CPU time of the whole cgroup, which unlike RLIMIT_CPU covers
+    // the children of the program as well; -1 without a time limit or a cgroup
+    int startCpuTimer();
+    // once the timer is readable, true if the time limit is used up and the cgroup killed
+    bool onCpuTimer();
+    int getCpuTimer() const;
+    // kills the child at the wall and CPU limits, unless there is no pidfd
+    bool waitChild(pid_t pid, int &status, rusage &ru);
+    // usage and verdicts of the program that ended with status, destroys the cgroup
+    void collect(int status, const rusage &ru);
+
+    // In the child: stdin, stdout and stderr of config, false with errno set on failure
+    bool redirectFiles() const;
+    // hardCpuLimit for a program that does not die of SIGXCPU
+    void setLimits(bool hardCpuLimit) const;
+    // returns only if execve() failed, with its errno
+    int exec() const;
+
+    static bool dupFile(int prev, int next);
+    static void setLimit(__rlimit_resource limit, rlim_t soft, rlim_t hard);
+    static double getTime();
+    static double tvToSeconds(timeval tv);
+};
+
+
+#endif //INVOKE_UNTRACEDRUN_HPP
@@ -0,0 +1,169 @@
+#include "CgroupInvoker.hpp"
+
+#include <cstring>
+#include <vector>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <CpuTopology.hpp>
+
+CgroupInvoker::CgroupInvoker(const InvokerConfig &config, uint32_t arch, const char *archName,
+                             const SyscallTable &table) :
+    config(config), arch(arch), archName(archName), table(table), untraced(config, result) {
+
+}
+
+void CgroupInvoker::run() {
+    result = InvokerResult();
+    result.cpu = config.cpu;
+
+    if (!prepared) {
+        buildSeccompFilter();
+        prepared = true;
+    }
+
+    if (!untraced.setupCgroup()) {
+        return;
+    }
+    untraced.prepareExec();
+
+    int fdUp[2], fdDown[2];
+    pipe2(fdUp, O_CLOEXEC);
+    pipe2(fdDown, O_CLOEXEC);
+
+    pid_t pid = fork();
+
+    if (pid < 0) {
+        untraced.fail(errno, std::string("Failed to fork: ") + strerror(errno));
+        close(fdUp[0]);
+        close(fdUp[1]);
+        close(fdDown[0]);
+        close(fdDown[1]);
+        untraced.cgroup.destroy();
+        return;
+    }
+
+    if (pid == 0) {
+        child(fdDown, fdUp);
+    }
+
+    close(fdDown[0]);
+    close(fdUp[1]);
+
+    if (config.tracerCpu >= 0) {
+        pinToCpus({ config.tracerCpu });
+    }
+
+    // the child waits for us before exec, so it is accounted from the first instruction
+    if (!untraced.cgroup.attach(pid)) {
+        untraced.fail(errno, std::string("Failed to move child into cgroup: ") + strerror(errno));
+        kill(pid, SIGKILL);
+        waitpid(pid, NULL, 0);
+        close(fdUp[0]);
+        close(fdDown[1]);
+        untraced.cgroup.destroy();
+        return;
+    }
+
+    int err = 0;
+    double start = UntracedRun::getTime();
+    write(fdDown[1], &err, sizeof(err));
+    close(fdDown[1]);
+
+    untraced.startCpuTimer();
+
+    int status = 0;
+    rusage ru;
+    untraced.waitChild(pid, status, ru);
+    result.wallClock = UntracedRun::getTime() - start;
+
+    if (read(fdUp[0], &err, sizeof(err)) > 0) {
+        close(fdUp[0]);
+        untraced.cgroup.destroy();
+        untraced.fail(err, std::string("execve() failed: ") + strerror(err));
+        return;
+    }
+    close(fdUp[0]);
+
+    untraced.collect(status, ru);
+
+    if (config.log) {
+        printResults();
+    }
+}
+
+void CgroupInvoker::child(int downPipe[2], int upPipe[2]) {
+    close(downPipe[1]);
+    close(upPipe[0]);
+
+    int rpipe = downPipe[0];
+    int wpipe = upPipe[1];
+
+    int lock;
+    read(rpipe, &lock, sizeof(lock));
+    close(rpipe);
+
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigprocmask(SIG_SETMASK, &mask, NULL);
+
+    if (config.cpu >= 0) {
+        pinToCpus({ config.cpu });
+    }
+
+    int err = 0;
+    if ((!config.workingDirectory.empty() && chdir(config.workingDirectory.c_str()) == -1) ||
+        !untraced.redirectFiles()) {
+
+        err = errno;
+        write(wpipe, &err, sizeof(err));
+        exit(1);
+    }
+
+    untraced.setLimits(false);
+
+    if (useSeccomp && (err = seccompFilter.install()) != 0) {
+        write(wpipe, &err, sizeof(err));
+        exit(1);
+    }
+
+    err = untraced.exec();
+    write(wpipe, &err, sizeof(err));
+    exit(1);
+}
+
+void CgroupInvoker::buildSeccompFilter() {
+    const InvokerProfile &profile = config.profile;
+
+    std::vector<SyscallAction> actions;
+    const ProfileActions *precomputed = profile.actionsFor(archName);
+    if (precomputed) {
+        actions.assign(precomputed->actions, precomputed->actions + precomputed->count);
+    } else {
+        actions.assign(table.size, SyscallAction::Unspecified);
+        for (const SyscallPolicy &policy : profile.syscalls) {
+            int syscall = table.find(policy.syscall);
+            if (syscall >= 0) {
+                actions[syscall] = policy.action;
+            }
+        }
+    }
+
+    bool allowAll = profile.defaultSyscallAction == SyscallAction::Allow;
+    for (SyscallAction action : actions) {
+        allowAll = allowAll && (action == SyscallAction::Allow || action == SyscallAction::Unspecified);
+    }
+
+    // nothing to filter, spare the program from no_new_privs
+    useSeccomp = !allowAll && SeccompFilter::available();
+    if (useSeccomp) {
+        seccompFilter.build(arch, table, actions.data(), actions.size(), table.size, profile.defaultSyscallAction,
+                            SeccompFilter::Decider::None);
+    }
+}
+
+const InvokerResult &CgroupInvoker::getResult() const {
+    return result;
+}
@@ -0,0 +1,36 @@
+#ifndef INVOKE_CGROUPINVOKER_HPP
+#define INVOKE_CGROUPINVOKER_HPP
+
+
+#include <Invoker.hpp>
+#include <SeccompFilter.hpp>
+#include <SyscallTable.hpp>
+#include <invokers/UntracedRun.hpp>
+
+// Runs the program without a tracer: limits and accounting come from a cgroup v2,
+// syscalls are filtered by seccomp alone. Profiles that need path checks can't be
+// enforced this way, Invoker::makeInvoker runs them with the ptrace invoker instead.
+class CgroupInvoker : public Invoker {
+private:
+    const InvokerConfig &config;
+    InvokerResult result;
+
+    uint32_t arch;
+    const char *archName;
+    const SyscallTable &table;
+    bool prepared = false;
+    bool useSeccomp = false;
+    SeccompFilter seccompFilter;
+    UntracedRun untraced;
+
+    void child(int downPipe[2], int upPipe[2]);
+    void buildSeccompFilter();
+
+public:
+    CgroupInvoker(const InvokerConfig &config, uint32_t arch, const char *archName, const SyscallTable &table);
+    void run() override;
+    const InvokerResult& getResult() const override;
+};
+
+
+#endif //INVOKE_CGROUPINVOKER_HPP
@@ -0,0 +1,329 @@
+#include "NamespaceInvoker.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <cstring>
+#include <vector>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <signal.h>
+#include <sys/mount.h>
+#include <sys/prctl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <sys/time.h>
+#include <linux/capability.h>
+#include <linux/securebits.h>
+#include <ctime>
+#include <CpuTopology.hpp>
+
+namespace {
+
+// what the children tell us when they can't get to the program
+struct Failure {
+    enum Step : int {
+        Enter,
+        Exec,
+    } step;
+    int error;
+};
+
+}
+
+NamespaceInvoker::NamespaceInvoker(const InvokerConfig &config, uint32_t arch, const char *archName,
+                                   const SyscallTable &table) :
+    config(config), arch(arch), archName(archName), table(table), untraced(config, result) {
+
+}
+
+void NamespaceInvoker::run() {
+    result = InvokerResult();
+    result.cpu = config.cpu;
+
+    if (!prepared) {
+        int err = root.build(config.profile);
+        if (err != 0) {
+            untraced.fail(err, std::string("Failed to build the sandbox root: ") + strerror(err));
+            return;
+        }
+        procTarget = root.path() + "/proc";
+        buildSeccompFilter();
+        prepared = true;
+    }
+
+    if (!resolvePaths()) {
+        return;
+    }
+
+    // one more process for our child outside the program's pid namespace
+    if (!config.cgroupRoot.empty() && !untraced.setupCgroup(1)) {
+        return;
+    }
+    untraced.prepareExec();
+
+    int fdUp[2], fdDown[2];
+    pipe2(fdUp, O_CLOEXEC);
+    pipe2(fdDown, O_CLOEXEC);
+
+    pid_t pid = fork();
+
+    if (pid < 0) {
+        untraced.fail(errno, std::string("Failed to fork: ") + strerror(errno));
+        close(fdUp[0]);
+        close(fdUp[1]);
+        close(fdDown[0]);
+        close(fdDown[1]);
+        untraced.cgroup.destroy();
+        return;
+    }
+
+    if (pid == 0) {
+        child(fdDown, fdUp);
+    }
+
+    close(fdDown[0]);
+    close(fdUp[1]);
+
+    if (config.tracerCpu >= 0) {
+        pinToCpus({ config.tracerCpu });
+    }
+
+    // the child waits for us before it forks the program, so both are accounted
+    if (untraced.cgroup.valid() && !untraced.cgroup.attach(pid)) {
+        untraced.fail(errno, std::string("Failed to move child into cgroup: ") + strerror(errno));
+        kill(pid, SIGKILL);
+        waitpid(pid, NULL, 0);
+        close(fdUp[0]);
+        close(fdDown[1]);
+        untraced.cgroup.destroy();
+        return;
+    }
+
+    int lock = 0;
+    double start = UntracedRun::getTime();
+    write(fdDown[1], &lock, sizeof(lock));
+    close(fdDown[1]);
+
+    untraced.startCpuTimer();
+
+    int status = 0;
+    rusage ru = {};
+    untraced.waitChild(pid, status, ru);
+    result.wallClock = UntracedRun::getTime() - start;
+
+    Failure failed = { Failure::Exec, 0 };
+    if (read(fdUp[0], &failed, sizeof(failed)) == sizeof(failed)) {
+        close(fdUp[0]);
+        untraced.cgroup.destroy();
+        if (failed.step == Failure::Enter) {
+            untraced.fail(failed.error, std::string("Failed to enter the sandbox: ") + strerror(failed.error));
+        } else {
+            untraced.fail(failed.error, std::string("execve() failed: ") + strerror(failed.error));
+        }
+        return;
+    }
+    close(fdUp[0]);
+
+    untraced.collect(status, ru);
+
+    if (config.log) {
+        printResults();
+    }
+}
+
+bool NamespaceInvoker::resolvePaths() {
+    boost::system::error_code err;
+    boost::filesystem::path directory = config.workingDirectory.empty() ?
+                                        boost::filesystem::current_path(err) :
+                                        boost::filesystem::canonical(config.workingDirectory, err);
+    if (err) {
+        untraced.fail(err.value(), "Failed to resolve the working directory: " + err.message());
+        return false;
+    }
+    cwd = directory.string();
+    cwdTarget = root.path() + cwd;
+
+    // execve() does not search PATH, a relative program starts in the working directory
+    boost::filesystem::path program(config.exe);
+    if (!program.is_absolute()) {
+        program = directory / program;
+    }
+    exe = program.lexically_normal().string();
+
+    exeTarget.clear();
+    if (exe.compare(0, cwd.size() + 1, cwd + "/") != 0) {
+        exeTarget = root.path() + exe;
+    }
+    return true;
+}
+
+void NamespaceInvoker::child(int downPipe[2], int upPipe[2]) {
+    close(downPipe[1]);
+    close(upPipe[0]);
+
+    int rpipe = downPipe[0];
+    int wpipe = upPipe[1];
+
+    int lock;
+    read(rpipe, &lock, sizeof(lock));
+    close(rpipe);
+
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigprocmask(SIG_SETMASK, &mask, NULL);
+
+    if (config.cpu >= 0) {
+        pinToCpus({ config.cpu });
+    }
+
+    Failure failed = { Failure::Enter, 0 };
+    if (setns(root.userNamespace(), CLONE_NEWUSER) == -1 ||
+        setns(root.mountNamespace(), CLONE_NEWNS) == -1 ||
+        unshare(CLONE_NEWNS | CLONE_NEWPID | CLONE_NEWNET | CLONE_NEWIPC) == -1) {
+        failed.error = errno;
+    }
+
+    // only this run's copy of the mount namespace sees these
+    if (failed.error == 0) {
+        failed.error = NamespaceRoot::bind(cwd.c_str(), cwdTarget.c_str(), false);
+    }
+    struct stat st;
+    if (failed.error == 0 && !exeTarget.empty() && stat(exeTarget.c_str(), &st) == -1 && stat(exe.c_str(), &st) == 0) {
+        // the profile need not list the program, like the tracers, which let its execve() through
+        failed.error = NamespaceRoot::bind(exe.c_str(), exeTarget.c_str(), true);
+    }
+    if (failed.error == 0 && root.ownsRoot()) {
+        failed.error = NamespaceRoot::makeReadOnly(root.path().c_str(), false);
+    }
+
+    pid_t pid = failed.error == 0 ? fork() : -1;
+    if (pid == 0) {
+        program(wpipe);
+    }
+    if (pid < 0) {
+        if (failed.error == 0) {
+            failed.error = errno;
+        }
+        write(wpipe, &failed, sizeof(failed));
+        _exit(1);
+    }
+    close(wpipe);
+
+    // we are outside the program's pid namespace and pass on how it ended
+    int status = 0;
+    while (waitpid(pid, &status, 0) == -1 && errno == EINTR) {
+    }
+    if (WIFSIGNALED(status)) {
+        UntracedRun::setLimit(RLIMIT_CORE, 0, 0);
+        signal(WTERMSIG(status), SIG_DFL);
+        raise(WTERMSIG(status));
+    }
+    _exit(WIFEXITED(status) ? WEXITSTATUS(status) : 1);
+}
+
+void NamespaceInvoker::program(int errorPipe) {
+    // the wall limit kills our parent
+    prctl(PR_SET_PDEATHSIG, SIGKILL, 0, 0, 0);
+
+    Failure failed = { Failure::Enter, 0 };
+    if ((root.mountsProc() &&
+         mount("proc", procTarget.c_str(), "proc", MS_NOSUID | MS_NODEV | MS_NOEXEC | MS_RDONLY, NULL) == -1) ||
+        chdir(root.path().c_str()) == -1 ||
+        syscall(SYS_pivot_root, ".", ".") == -1 ||
+        umount2(".", MNT_DETACH) == -1 ||
+        chdir(cwd.c_str()) == -1 ||
+        !untraced.redirectFiles()) {
+
+        failed.error = errno;
+        write(errorPipe, &failed, sizeof(failed));
+        _exit(1);
+    }
+    // pid 1 ignores SIGXCPU, so the hard limit is the one that kills it
+    untraced.setLimits(true);
+
+    failed.error = dropCapabilities();
+    if (failed.error == 0 && useSeccomp) {
+        failed.error = seccompFilter.install();
+    }
+    if (failed.error != 0) {
+        write(errorPipe, &failed, sizeof(failed));
+        _exit(1);
+    }
+
+    failed.step = Failure::Exec;
+    failed.error = untraced.exec();
+    write(errorPipe, &failed, sizeof(failed));
+    _exit(1);
+}
+
+int NamespaceInvoker::dropCapabilities() {
+    // uid 0 of the namespace gets nothing back on execve()
+    if (prctl(PR_SET_SECUREBITS, SECBIT_NOROOT | SECBIT_NOROOT_LOCKED, 0, 0, 0) == -1) {
+        return errno;
+    }
+    for (int cap = 0; prctl(PR_CAPBSET_READ, cap, 0, 0, 0) >= 0; ++cap) {
+        if (prctl(PR_CAPBSET_DROP, cap, 0, 0, 0) == -1) {
+            return errno;
+        }
+    }
+    prctl(PR_CAP_AMBIENT, PR_CAP_AMBIENT_CLEAR_ALL, 0, 0, 0);
+
+    __user_cap_header_struct header = { _LINUX_CAPABILITY_VERSION_3, 0 };
+    __user_cap_data_struct data[_LINUX_CAPABILITY_U32S_3] = {};
+    if (syscall(SYS_capset, &header, data) == -1) {
+        return errno;
+    }
+    return prctl(PR_SET_NO_NEW_PRIVS, 1, 0, 0, 0) == -1 ? errno : 0;
+}
+
+void NamespaceInvoker::buildSeccompFilter() {
+    const InvokerProfile &profile = config.profile;
+
+    std::vector<SyscallAction> actions;
+    const ProfileActions *precomputed = profile.actionsFor(archName);
+    if (precomputed) {
+        actions.assign(precomputed->actions, precomputed->actions + precomputed->count);
+    } else {
+        actions.assign(table.size, SyscallAction::Unspecified);
+        for (const SyscallPolicy &policy : profile.syscalls) {
+            int syscall = table.find(policy.syscall);
+            if (syscall >= 0) {
+                actions[syscall] = policy.action;
+            }
+        }
+    }
+
+    // the root is the path check
+    std::replace(actions.begin(), actions.end(), SyscallAction::CheckPath, SyscallAction::Allow);
+    std::replace(actions.begin(), actions.end(), SyscallAction::CheckPathSecurity, SyscallAction::Allow);
+    SyscallAction defaultAction = profile.defaultSyscallAction;
+    if (defaultAction == SyscallAction::CheckPath || defaultAction == SyscallAction::CheckPathSecurity) {
+        defaultAction = SyscallAction::Allow;
+    }
+
+    // the filter is in place before our own execve(), so it can't be told from the program's
+    int execve = table.find("execve");
+    if (execve >= 0 && (size_t)execve < actions.size()) {
+        actions[execve] = SyscallAction::Allow;
+    }
+
+    bool allowAll = defaultAction == SyscallAction::Allow;
+    for (SyscallAction action : actions) {
+        allowAll = allowAll && (action == SyscallAction::Allow || action == SyscallAction::Unspecified);
+    }
+
+    useSeccomp = !allowAll && SeccompFilter::available();
+    if (useSeccomp) {
+        seccompFilter.build(arch, table, actions.data(), actions.size(), table.size, defaultAction,
+                            SeccompFilter::Decider::None);
+    }
+}
+
+const InvokerResult &NamespaceInvoker::getResult() const {
+    return result;
+}
@@ -0,0 +1,59 @@
+#ifndef INVOKE_NAMESPACEINVOKER_HPP
+#define INVOKE_NAMESPACEINVOKER_HPP
+
+
+#include <string>
+#include <Invoker.hpp>
+#include <SeccompFilter.hpp>
+#include <SyscallTable.hpp>
+#include <invokers/UntracedRun.hpp>
+#include <invokers/namespace/NamespaceRoot.hpp>
+
+// Runs the program without a tracer in new mount, pid, network and IPC namespaces, with
+// a root that holds only the paths of the profile and the working directory. Path checks
+// are left to what the program can see, the rest of the profile is a seccomp filter.
+//
+// The root is mounted once, see NamespaceRoot. A run joins its namespaces, copies the
+// mount namespace to bind the working directory into it and forks the program, which
+// becomes pid 1 of its namespace: signals it doesn't handle are ignored unless they come
+// from the kernel for a fault, so RLIMIT_CPU only stops it with the hard limit.
+//
+// Limits and accounting come from a cgroup v2 if InvokerConfig::cgroupRoot is set, whose
+// CPU time we check on a timer. Otherwise they come from rlimits and the child's rusage,
+// and every process the program forks has a CPU limit of its own.
+class NamespaceInvoker : public Invoker {
+private:
+    const InvokerConfig &config;
+    InvokerResult result;
+
+    uint32_t arch;
+    const char *archName;
+    const SyscallTable &table;
+    bool prepared = false;
+    bool useSeccomp = false;
+    SeccompFilter seccompFilter;
+    NamespaceRoot root;
+    UntracedRun untraced;
+
+    // worked out before fork(), so that the children don't allocate
+    std::string cwd;
+    std::string cwdTarget;
+    std::string exe;
+    // empty if the program is in the working directory
+    std::string exeTarget;
+    std::string procTarget;
+
+    bool resolvePaths();
+    void child(int downPipe[2], int upPipe[2]);
+    void program(int errorPipe);
+    void buildSeccompFilter();
+    static int dropCapabilities();
+
+public:
+    NamespaceInvoker(const InvokerConfig &config, uint32_t arch, const char *archName, const SyscallTable &table);
+    void run() override;
+    const InvokerResult& getResult() const override;
+};
+
+
+#endif //INVOKE_NAMESPACEINVOKER_HPP
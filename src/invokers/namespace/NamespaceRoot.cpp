@@ -0,0 +1,384 @@
+#include "NamespaceRoot.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mount.h>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+
+#ifndef AT_RECURSIVE
+#define AT_RECURSIVE 0x8000
+#endif
+
+namespace {
+
+// the path a permission applies to, without the slash that marks a directory tree
+std::string nodeOf(const std::string &path) {
+    size_t end = path.size();
+    while (end > 0 && path[end - 1] == '/') {
+        --end;
+    }
+    return path.substr(0, end);
+}
+
+// whether the tree at `ancestor` contains `node`
+bool contains(const std::string &ancestor, const std::string &node) {
+    return ancestor.empty() || node == ancestor ||
+           (node.size() > ancestor.size() && node.compare(0, ancestor.size(), ancestor) == 0 &&
+            node[ancestor.size()] == '/');
+}
+
+// what a mount can express
+PathAccess mountable(PathAccess access) {
+    switch (access) {
+        case PathAccess::ReadOnlySecurity:
+            return PathAccess::ReadOnly;
+        case PathAccess::Security:
+            return PathAccess::Denied;
+        default:
+            return access;
+    }
+}
+
+size_t depth(const std::string &node) {
+    return (size_t)std::count(node.begin(), node.end(), '/');
+}
+
+bool writeFile(const char *path, const std::string &value) {
+    int fd = open(path, O_WRONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = write(fd, value.data(), value.size()) == (ssize_t)value.size();
+    close(fd);
+    return ok;
+}
+
+}
+
+NamespaceRoot::~NamespaceRoot() {
+    release();
+}
+
+void NamespaceRoot::release() {
+    for (int *fd : { &userns, &mntns }) {
+        if (*fd >= 0) {
+            close(*fd);
+            *fd = -1;
+        }
+    }
+    if (!root.empty()) {
+        // only ever a mount point in the namespaces we just let go
+        rmdir(root.c_str());
+        root.clear();
+    }
+}
+
+void NamespaceRoot::plan(const InvokerProfile &profile) {
+    base = mountable(profile.defaultPathAccess);
+    proc = false;
+    mounts.clear();
+
+    std::vector<Mount> entries;
+    for (const PathPermission &permission : profile.paths) {
+        Mount entry;
+        std::string path = permission.path;
+        entry.exact = path.empty() || path.back() != '/';
+        entry.path = nodeOf(path);
+        entry.access = mountable(permission.access);
+        entries.push_back(entry);
+    }
+
+    std::vector<Mount> kept;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const Mount &entry = entries[i];
+        bool overridden = false;
+        for (size_t j = i + 1; j < entries.size() && !overridden; ++j) {
+            overridden = entries[j].path == entry.path || (!entries[j].exact && contains(entries[j].path, entry.path));
+        }
+        if (overridden) {
+            continue;
+        }
+        if (entry.path.empty()) {
+            if (!entry.exact) {
+                base = entry.access;
+            }
+            continue;
+        }
+        if (contains("/proc", entry.path)) {
+            // the program gets a proc of its own pid namespace, all of it or nothing
+            proc = proc || entry.access != PathAccess::Denied;
+            continue;
+        }
+        kept.push_back(entry);
+    }
+
+    // parents first, so that their children are mounted on top of them
+    std::stable_sort(kept.begin(), kept.end(), [](const Mount &a, const Mount &b) {
+        return depth(a.path) < depth(b.path);
+    });
+    for (Mount &entry : kept) {
+        PathAccess inherited = base;
+        for (const Mount &mount : mounts) {
+            if (!mount.exact && contains(mount.path, entry.path)) {
+                inherited = mount.access;
+            }
+        }
+        if (entry.access == inherited) {
+            continue;
+        }
+        entry.target = root + entry.path;
+        mounts.push_back(entry);
+    }
+}
+
+int NamespaceRoot::build(const InvokerProfile &profile) {
+    release();
+
+    char dir[] = "/tmp/invoke-root-XXXXXX";
+    if (!mkdtemp(dir)) {
+        return errno;
+    }
+    root = dir;
+    plan(profile);
+
+    uidMap = std::to_string(geteuid()) + " " + std::to_string(geteuid()) + " 1\n";
+    gidMap = std::to_string(getegid()) + " " + std::to_string(getegid()) + " 1\n";
+
+    int fdUp[2], fdDown[2];
+    if (pipe2(fdUp, O_CLOEXEC) == -1) {
+        return errno;
+    }
+    if (pipe2(fdDown, O_CLOEXEC) == -1) {
+        int err = errno;
+        close(fdUp[0]);
+        close(fdUp[1]);
+        return err;
+    }
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        int err = errno;
+        for (int fd : { fdUp[0], fdUp[1], fdDown[0], fdDown[1] }) {
+            close(fd);
+        }
+        return err;
+    }
+
+    if (pid == 0) {
+        close(fdUp[0]);
+        close(fdDown[1]);
+        int err = 0;
+        if (unshare(CLONE_NEWUSER | CLONE_NEWNS) == -1 ||
+            !writeFile("/proc/self/setgroups", "deny") ||
+            !writeFile("/proc/self/uid_map", uidMap) ||
+            !writeFile("/proc/self/gid_map", gidMap)) {
+            err = errno;
+        } else {
+            err = populate();
+        }
+        write(fdUp[1], &err, sizeof(err));
+        // the namespaces must still exist when they are opened
+        char done;
+        read(fdDown[0], &done, sizeof(done));
+        _exit(0);
+    }
+
+    close(fdUp[1]);
+    close(fdDown[0]);
+
+    int err = EIO;
+    if (read(fdUp[0], &err, sizeof(err)) == sizeof(err) && err == 0) {
+        std::string ns = "/proc/" + std::to_string(pid) + "/ns/";
+        userns = open((ns + "user").c_str(), O_RDONLY | O_CLOEXEC);
+        mntns = open((ns + "mnt").c_str(), O_RDONLY | O_CLOEXEC);
+        if (userns < 0 || mntns < 0) {
+            err = errno;
+        }
+    }
+    close(fdUp[0]);
+    close(fdDown[1]);
+    waitpid(pid, NULL, 0);
+
+    if (err != 0) {
+        release();
+    }
+    return err;
+}
+
+int NamespaceRoot::populate() const {
+    // nothing we mount may leak back to the host
+    if (mount(NULL, "/", NULL, MS_REC | MS_PRIVATE, NULL) == -1) {
+        return errno;
+    }
+
+    if (base == PathAccess::Denied) {
+        if (mount("tmpfs", root.c_str(), "tmpfs", MS_NOSUID | MS_NODEV, "mode=0755") == -1) {
+            return errno;
+        }
+    } else {
+        int err = bind("/", root.c_str(), base == PathAccess::ReadOnly);
+        if (err != 0) {
+            return err;
+        }
+    }
+
+    for (const Mount &entry : mounts) {
+        struct stat st;
+        if (stat(entry.path.c_str(), &st) == -1) {
+            // nothing to show
+            continue;
+        }
+        bool directory = S_ISDIR(st.st_mode);
+
+        int err = 0;
+        if (entry.access == PathAccess::Denied) {
+            // it is within something visible, there is no mount point to make
+            if (!directory) {
+                // a device on a mount without devices can't be opened at all
+                err = mount("/dev/null", entry.target.c_str(), NULL, MS_BIND, NULL) == -1 ?
+                      errno : makeReadOnly(entry.target.c_str(), false, true);
+            } else if (!entry.exact &&
+                       mount("tmpfs", entry.target.c_str(), "tmpfs", MS_NOSUID | MS_NODEV | MS_RDONLY, "mode=0555") == -1) {
+                err = errno;
+            }
+        } else if (directory && entry.exact) {
+            // the directory, not what is in it
+            err = makeDirectories(entry.target.c_str());
+        } else {
+            err = bind(entry.path.c_str(), entry.target.c_str(), entry.access == PathAccess::ReadOnly);
+        }
+        if (err != 0) {
+            return err;
+        }
+    }
+
+    if (proc && base == PathAccess::Denied) {
+        char target[PATH_MAX];
+        snprintf(target, sizeof(target), "%s/proc", root.c_str());
+        return makeDirectories(target);
+    }
+    return 0;
+}
+
+bool NamespaceRoot::built() const {
+    return userns >= 0 && mntns >= 0;
+}
+
+int NamespaceRoot::userNamespace() const {
+    return userns;
+}
+
+int NamespaceRoot::mountNamespace() const {
+    return mntns;
+}
+
+const std::string &NamespaceRoot::path() const {
+    return root;
+}
+
+bool NamespaceRoot::mountsProc() const {
+    return proc;
+}
+
+bool NamespaceRoot::ownsRoot() const {
+    return base == PathAccess::Denied;
+}
+
+int NamespaceRoot::makeDirectories(const char *path) {
+    char buf[PATH_MAX];
+    size_t length = strlen(path);
+    if (length >= sizeof(buf)) {
+        return ENAMETOOLONG;
+    }
+    memcpy(buf, path, length + 1);
+
+    for (size_t i = 1; i <= length; ++i) {
+        if (buf[i] != '/' && buf[i] != '\0') {
+            continue;
+        }
+        char c = buf[i];
+        buf[i] = '\0';
+        if (mkdir(buf, 0755) == -1 && errno != EEXIST) {
+            return errno;
+        }
+        buf[i] = c;
+    }
+    return 0;
+}
+
+int NamespaceRoot::bind(const char *source, const char *target, bool readOnly) {
+    struct stat st;
+    if (stat(source, &st) == -1) {
+        return errno;
+    }
+
+    if (S_ISDIR(st.st_mode)) {
+        int err = makeDirectories(target);
+        if (err != 0) {
+            return err;
+        }
+    } else if (stat(target, &st) == -1) {
+        char parent[PATH_MAX];
+        size_t length = strlen(target);
+        if (length >= sizeof(parent)) {
+            return ENAMETOOLONG;
+        }
+        memcpy(parent, target, length + 1);
+        char *slash = strrchr(parent, '/');
+        if (slash && slash != parent) {
+            *slash = '\0';
+            int err = makeDirectories(parent);
+            if (err != 0) {
+                return err;
+            }
+        }
+        int fd = open(target, O_RDONLY | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            return errno;
+        }
+        close(fd);
+    }
+
+    if (mount(source, target, NULL, MS_BIND | MS_REC, NULL) == -1) {
+        return errno;
+    }
+    return readOnly ? makeReadOnly(target, true) : 0;
+}
+
+int NamespaceRoot::makeReadOnly(const char *target, bool recursive, bool noDevices) {
+    mount_attr attr = {};
+    attr.attr_set = MOUNT_ATTR_RDONLY | (noDevices ? MOUNT_ATTR_NODEV : 0);
+    if (syscall(SYS_mount_setattr, AT_FDCWD, target, recursive ? AT_RECURSIVE : 0, &attr, sizeof(attr)) == 0) {
+        return 0;
+    }
+    if (errno != ENOSYS) {
+        return errno;
+    }
+
+    // older kernels remount the top mount alone, keeping the flags the user namespace locked
+    struct statvfs st;
+    if (statvfs(target, &st) == -1) {
+        return errno;
+    }
+    unsigned long flags = MS_REMOUNT | MS_BIND | MS_RDONLY | (noDevices ? MS_NODEV : 0);
+    const unsigned long locked[][2] = {
+            { ST_NOSUID, MS_NOSUID }, { ST_NODEV, MS_NODEV }, { ST_NOEXEC, MS_NOEXEC },
+            { ST_NOATIME, MS_NOATIME }, { ST_NODIRATIME, MS_NODIRATIME }, { ST_RELATIME, MS_RELATIME },
+    };
+    for (const auto &flag : locked) {
+        if (st.f_flag & flag[0]) {
+            flags |= flag[1];
+        }
+    }
+    return mount(NULL, target, NULL, flags, NULL) == -1 ? errno : 0;
+}
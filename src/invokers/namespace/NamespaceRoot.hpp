@@ -0,0 +1,73 @@
+#ifndef INVOKE_NAMESPACEROOT_HPP
+#define INVOKE_NAMESPACEROOT_HPP
+
+#include <string>
+#include <vector>
+#include <InvokerProfile.hpp>
+
+// A root holding only what a profile lets the program see, mounted once in a user and
+// mount namespace of its own. A helper process builds it and exits, the namespaces live
+// on as long as we hold descriptors to them. Runs join them and copy the mount namespace
+// instead of mounting everything again.
+//
+// Paths are bind-mounted from the host at the same place: directory trees with a trailing
+// slash as a whole, exact entries alone (an empty directory for a directory). Denied trees
+// inside visible ones are covered by an empty tmpfs, denied files by /dev/null on a mount
+// without devices, which can't be opened. Mounts can't tell a violation from
+// an error, so Security paths are simply Denied and ReadOnlySecurity ones ReadOnly.
+class NamespaceRoot {
+private:
+    struct Mount {
+        std::string path;
+        // where it goes in the holder's mount namespace
+        std::string target;
+        PathAccess access;
+        bool exact;
+    };
+
+    // where the root is mounted, in the holder's mount namespace only
+    std::string root;
+    int userns = -1;
+    int mntns = -1;
+    // what the paths outside every entry get: a bare tmpfs if Denied, the host's root otherwise
+    PathAccess base = PathAccess::Denied;
+    bool proc = false;
+    std::vector<Mount> mounts;
+    std::string uidMap;
+    std::string gidMap;
+
+    void plan(const InvokerProfile &profile);
+    // runs in the helper, 0 or the errno of the first step that failed
+    int populate() const;
+    void release();
+
+public:
+    NamespaceRoot() = default;
+    NamespaceRoot(const NamespaceRoot &) = delete;
+    NamespaceRoot &operator=(const NamespaceRoot &) = delete;
+    ~NamespaceRoot();
+
+    // 0 or the errno of the first step that failed
+    int build(const InvokerProfile &profile);
+    bool built() const;
+
+    int userNamespace() const;
+    int mountNamespace() const;
+    const std::string &path() const;
+    // whether the program gets a /proc of its own pid namespace
+    bool mountsProc() const;
+    // whether the root is a tmpfs of ours, which every run makes read only once it is done mounting
+    bool ownsRoot() const;
+
+    // The helpers below don't allocate, so that they can run in a child of a threaded process.
+
+    // mkdir -p, 0 or errno
+    static int makeDirectories(const char *path);
+    // bind `source` at `target`, creating an empty file or directory to mount on, 0 or errno
+    static int bind(const char *source, const char *target, bool readOnly);
+    // noDevices also keeps device files from being opened
+    static int makeReadOnly(const char *target, bool recursive, bool noDevices = false);
+};
+
+
+#endif //INVOKE_NAMESPACEROOT_HPP
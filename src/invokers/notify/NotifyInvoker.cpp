@@ -0,0 +1,734 @@
+#include "NotifyInvoker.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <climits>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <CpuTopology.hpp>
+
+namespace {
+
+// what the child tells us: the listener it installed, or why it could not get to execve()
+struct Handover {
+    int listener;
+    int error;
+};
+
+}
+
+NotifyInvoker::NotifyInvoker(const InvokerConfig &config, uint32_t arch, const char *archName,
+                             const SyscallTable &table) :
+    config(config), arch(arch), archName(archName), table(table), untraced(config, result) {
+
+}
+
+NotifyInvoker::~NotifyInvoker() {
+    closeDescriptors();
+}
+
+void NotifyInvoker::run() {
+    if (!start()) {
+        return;
+    }
+
+    pollfd fds[3] = {
+            { pidfd, POLLIN, 0 },
+            { listener, POLLIN, 0 },
+            { untraced.getCpuTimer(), POLLIN, 0 },
+    };
+    for (;;) {
+        int timeout = -1;
+        if (config.wallLimit > 0) {
+            double left = startTime + config.wallLimit - UntracedRun::getTime();
+            if (left <= 0) {
+                onWallLimit();
+                break;
+            }
+            timeout = (int)ceil(left * 1e3);
+        }
+
+        int ready = poll(fds, 3, timeout);
+        if (ready < 0 && errno != EINTR) {
+            break;
+        }
+        if (ready <= 0) {
+            continue;
+        }
+        if (fds[0].revents & POLLIN) {
+            break;
+        }
+        if (fds[1].revents & POLLIN) {
+            onNotification();
+        } else if (fds[1].revents & (POLLHUP | POLLERR)) {
+            // nothing left that uses the filter
+            fds[1].fd = -1;
+        }
+        if ((fds[2].revents & POLLIN) && untraced.onCpuTimer()) {
+            // the pidfd follows once the program is gone
+            fds[2].fd = -1;
+        }
+    }
+
+    finish();
+}
+
+bool NotifyInvoker::start() {
+    result = InvokerResult();
+    result.cpu = config.cpu;
+    closeDescriptors();
+
+    stats.reset();
+    if (config.stats) {
+        stats = std::make_shared<SyscallStats>();
+        stats->archs[0].name = archName;
+        stats->archs[0].table = &table;
+        result.stats = stats;
+    }
+
+    if (!prepared) {
+        seccomp_notif_sizes sizes = {};
+        if (syscall(SYS_seccomp, SECCOMP_GET_NOTIF_SIZES, 0, &sizes) != 0) {
+            untraced.fail(errno, std::string("seccomp user notifications are not available: ") + strerror(errno));
+            return false;
+        }
+        // the kernel may know more fields than we do
+        request.assign(std::max<size_t>(sizes.seccomp_notif, sizeof(seccomp_notif)), 0);
+        response.assign(std::max<size_t>(sizes.seccomp_notif_resp, sizeof(seccomp_notif_resp)), 0);
+
+        buildSeccompFilter();
+        paths.build(config.profile);
+        prepared = true;
+    }
+
+    boost::filesystem::path cwd;
+    if (config.workingDirectory.empty()) {
+        char *cwd_ = get_current_dir_name();
+        cwd = cwd_;
+        free(cwd_);
+    } else {
+        boost::system::error_code err;
+        cwd = boost::filesystem::canonical(config.workingDirectory, err);
+        if (err.value()) {
+            untraced.fail(err.value(), "Failed to resolve working directory " + err.message());
+            return false;
+        }
+    }
+    paths.setWorkingDirectory(cwd, config.writeableFiles);
+
+    if (!config.cgroupRoot.empty() && !untraced.setupCgroup()) {
+        return false;
+    }
+    untraced.prepareExec();
+
+    int fdUp[2], fdDown[2];
+    pipe2(fdUp, O_CLOEXEC);
+    pipe2(fdDown, O_CLOEXEC);
+
+    pid = fork();
+
+    if (pid < 0) {
+        untraced.fail(errno, std::string("Failed to fork: ") + strerror(errno));
+        close(fdUp[0]);
+        close(fdUp[1]);
+        close(fdDown[0]);
+        close(fdDown[1]);
+        untraced.cgroup.destroy();
+        return false;
+    }
+
+    if (pid == 0) {
+        child(fdDown, fdUp);
+    }
+
+    close(fdDown[0]);
+    close(fdUp[1]);
+    errorPipe = fdUp[0];
+    if (!untraced.cgroup.valid()) {
+        // the child does the same, whichever of us comes first
+        setpgid(pid, pid);
+    }
+
+    if (config.tracerCpu >= 0) {
+        pinToCpus({ config.tracerCpu });
+    }
+
+    bool ok = true;
+    // the child waits for us before exec, so it is accounted from the first instruction
+    if (untraced.cgroup.valid() && !untraced.cgroup.attach(pid)) {
+        untraced.fail(errno, std::string("Failed to move child into cgroup: ") + strerror(errno));
+        ok = false;
+    }
+
+    if (ok) {
+        pidfd = (int)syscall(SYS_pidfd_open, pid, 0);
+        if (pidfd < 0) {
+            untraced.fail(errno, std::string("Failed to open pidfd: ") + strerror(errno));
+            ok = false;
+        }
+    }
+
+    if (ok) {
+        int lock = 0;
+        didExec = false;
+        startTime = UntracedRun::getTime();
+        write(fdDown[1], &lock, sizeof(lock));
+        ok = receiveListener(fdDown[1], errorPipe);
+    }
+    if (ok) {
+        untraced.startCpuTimer();
+    }
+    close(fdDown[1]);
+
+    if (!ok) {
+        kill(pid, SIGKILL);
+        waitpid(pid, NULL, 0);
+        closeDescriptors();
+        untraced.cgroup.destroy();
+        return false;
+    }
+    return true;
+}
+
+bool NotifyInvoker::receiveListener(int downPipe, int upPipe) {
+    Handover handover = { -1, 0 };
+    if (read(upPipe, &handover, sizeof(handover)) != sizeof(handover)) {
+        untraced.fail(EPERM, "The program died before handing over its seccomp listener, "
+                             "the profile has to allow read() and write()");
+        return false;
+    }
+    if (handover.listener < 0) {
+        untraced.fail(handover.error, std::string("execve() failed: ") + strerror(handover.error));
+        return false;
+    }
+
+    // a copy of the descriptor, the child's own goes away with execve()
+    listener = (int)syscall(SYS_pidfd_getfd, pidfd, handover.listener, 0);
+    if (listener < 0) {
+        untraced.fail(errno, std::string("Failed to take over the seccomp listener: ") + strerror(errno));
+        return false;
+    }
+
+    int go = 0;
+    write(downPipe, &go, sizeof(go));
+    return true;
+}
+
+void NotifyInvoker::onNotification() {
+    auto *notification = reinterpret_cast<seccomp_notif*>(request.data());
+    std::fill(request.begin(), request.end(), 0);
+    if (ioctl(listener, SECCOMP_IOCTL_NOTIF_RECV, notification) != 0) {
+        // the syscall was interrupted or its thread is gone
+        return;
+    }
+    double began = UntracedRun::getTime();
+
+    bool security = false;
+    bool checked = true;
+    int error = 0;
+    boost::filesystem::path path;
+    if (!didExec && (pid_t)notification->pid == pid && (long)notification->data.nr == syscallExecve) {
+        // this is our own execve()
+        didExec = true;
+        checked = false;
+        result.spawnLatency = began - startTime;
+    } else {
+        error = checkSyscall(*notification, security, path);
+    }
+
+    if (security) {
+        if (config.log) {
+            std::cerr << "Security violation in syscall " << notification->data.nr << std::endl;
+        }
+        result.securityViolation = true;
+        kill(notification->pid, SIGKILL);
+        killProgram();
+    }
+
+    auto *answer = reinterpret_cast<seccomp_notif_resp*>(response.data());
+    std::fill(response.begin(), response.end(), 0);
+    answer->id = notification->id;
+    bool answered = false;
+    if (error != 0) {
+        answer->error = -error;
+    } else if (!path.empty()) {
+        answered = emulate(*notification, path, *answer);
+    } else {
+        answer->flags = SECCOMP_USER_NOTIF_FLAG_CONTINUE;
+    }
+    if (!answered) {
+        // fails if the thread is gone meanwhile, then there is nobody to answer
+        ioctl(listener, SECCOMP_IOCTL_NOTIF_SEND, answer);
+    }
+
+    if (stats && notification->data.nr >= 0 && notification->data.nr < SyscallStats::SYSCALL_MAX) {
+        double now = UntracedRun::getTime();
+        ++stats->stops;
+        stats->tracerTime += now - began;
+
+        SyscallStats::Counters &counters = stats->archs[0].syscalls[notification->data.nr];
+        ++counters.entered;
+        if (checked) {
+            ++counters.checked;
+        }
+        if (error == 0) {
+            ++counters.allowed;
+        } else {
+            ++counters.denied;
+        }
+        counters.time += now - began;
+    }
+}
+
+int NotifyInvoker::checkSyscall(const seccomp_notif &notification, bool &security, boost::filesystem::path &path) {
+    long syscall = notification.data.nr;
+    SyscallAction action = syscall >= 0 && (size_t)syscall < actions.size() ? actions[syscall] : SyscallAction::Unspecified;
+    if (action == SyscallAction::Unspecified) {
+        action = config.profile.defaultSyscallAction;
+    }
+    if (action != SyscallAction::CheckPath && action != SyscallAction::CheckPathSecurity) {
+        // only sent to us for the execve() of the child
+        security = true;
+        return EPERM;
+    }
+
+    double began = stats ? UntracedRun::getTime() : 0;
+    bool at = std::find(syscallsAt.begin(), syscallsAt.end(), syscall) != syscallsAt.end();
+    std::string str_path;
+    bool readable = readString(notification.pid, notification.data.args[at ? 1 : 0], str_path);
+    if (stats) {
+        stats->readTime += UntracedRun::getTime() - began;
+    }
+
+    // the memory we read may already belong to another process
+    uint64_t id = notification.id;
+    if (ioctl(listener, SECCOMP_IOCTL_NOTIF_ID_VALID, &id) != 0) {
+        return EACCES;
+    }
+    if (!readable) {
+        // the kernel would not be able to read it either
+        return EFAULT;
+    }
+
+    if (str_path.empty()) {
+        // AT_EMPTY_PATH, e.g. fstat() of glibc, works on a descriptor the program already has,
+        // without it the kernel refuses an empty path
+        auto empty = std::find_if(syscallsEmptyPath.begin(), syscallsEmptyPath.end(),
+                                  [syscall](const std::pair<long, int> &entry) {
+                                      return entry.first == syscall;
+                                  });
+        if (empty != syscallsEmptyPath.end() && (notification.data.args[empty->second] & AT_EMPTY_PATH)) {
+            return 0;
+        }
+        return ENOENT;
+    }
+
+    path = str_path;
+    if (path.is_relative()) {
+        int dirfd = (int)notification.data.args[0];
+        if (at && dirfd != AT_FDCWD) {
+            boost::filesystem::path directory = descriptorPath(notification.pid, dirfd);
+            if (directory.empty()) {
+                // not a descriptor of the program, the kernel would fail the call just the same
+                return EBADF;
+            }
+            path = directory / path;
+        } else {
+            path = paths.workingDirectory() / path;
+        }
+    }
+    path = path.lexically_normal();
+
+    if (config.log) {
+        std::cerr << path << std::endl;
+    }
+
+    began = stats ? UntracedRun::getTime() : 0;
+    PathAccess access = paths.check(path);
+    if (stats) {
+        stats->checkTime += UntracedRun::getTime() - began;
+    }
+
+    bool write = false;
+    if (syscall == syscallOpen || syscall == syscallOpenat) {
+        long flags = (long)notification.data.args[(syscall == syscallOpenat) ? 2 : 1];
+        write = (flags & O_WRONLY) || (flags & O_RDWR);
+    }
+
+    int error = paths.verdict(access, write, security);
+    if (error != 0 && action == SyscallAction::CheckPathSecurity) {
+        security = true;
+    }
+    if (error == 0 && emulationOf(syscall) == Emulation::None) {
+        // the kernel would read the path again, after the program may have changed it
+        if (config.log) {
+            std::cerr << "Can't make syscall " << syscall << " for the program" << std::endl;
+        }
+        error = EPERM;
+    }
+    if (error != 0 && config.log) {
+        std::cerr << "denied syscall " << syscall << std::endl;
+    }
+    return error;
+}
+
+bool NotifyInvoker::emulate(const seccomp_notif &notification, const boost::filesystem::path &path,
+                            seccomp_notif_resp &answer) {
+    long syscall = notification.data.nr;
+    const __u64 *args = notification.data.args;
+    // the path is the argument after the descriptor of the *at() syscalls
+    int shift = std::find(syscallsAt.begin(), syscallsAt.end(), syscall) != syscallsAt.end() ? 1 : 0;
+
+    std::string target = path.string();
+    if (target.compare(0, 10, "/proc/self") == 0 && (target.size() == 10 || target[10] == '/')) {
+        // ours otherwise
+        target = "/proc/" + std::to_string(notification.pid) + target.substr(10);
+    }
+
+    Emulation emulation = emulationOf(syscall);
+    long ret = 0;
+    switch (emulation) {
+        case Emulation::Open: {
+            auto flags = (int)args[shift + 1];
+            // a FIFO without a peer would block us rather than the program
+            int fd = open(target.c_str(), flags | O_CLOEXEC | O_NONBLOCK, (mode_t)args[shift + 2]);
+            if (fd < 0) {
+                ret = -errno;
+                break;
+            }
+            if (!(flags & O_NONBLOCK)) {
+                fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+            }
+            seccomp_notif_addfd addfd = {};
+            addfd.id = notification.id;
+            addfd.flags = SECCOMP_ADDFD_FLAG_SEND;
+            addfd.srcfd = (uint32_t)fd;
+            addfd.newfd_flags = (uint32_t)(flags & O_CLOEXEC);
+            // installs the descriptor and answers with its number at once
+            ret = ioctl(listener, SECCOMP_IOCTL_NOTIF_ADDFD, &addfd);
+            if (ret < 0) {
+                ret = -errno;
+            }
+            close(fd);
+            if (ret >= 0) {
+                return true;
+            }
+            break;
+        }
+        case Emulation::Stat:
+        case Emulation::Lstat: {
+            int flags = shift ? (int)args[3] : 0;
+            if (emulation == Emulation::Lstat) {
+                flags |= AT_SYMLINK_NOFOLLOW;
+            }
+            struct stat st = {};
+            if (fstatat(AT_FDCWD, target.c_str(), &st, flags) != 0) {
+                ret = -errno;
+            } else if (!writeMemory(notification.pid, args[shift + 1], &st, sizeof(st))) {
+                ret = -EFAULT;
+            }
+            break;
+        }
+        case Emulation::Statx: {
+            struct statx stx = {};
+            if (statx(AT_FDCWD, target.c_str(), (int)args[2], (unsigned int)args[3], &stx) != 0) {
+                ret = -errno;
+            } else if (!writeMemory(notification.pid, args[4], &stx, sizeof(stx))) {
+                ret = -EFAULT;
+            }
+            break;
+        }
+        case Emulation::Readlink: {
+            auto size = (int)args[shift + 2];
+            if (size <= 0) {
+                ret = -EINVAL;
+                break;
+            }
+            std::vector<char> buf(std::min(size, PATH_MAX));
+            ret = readlink(target.c_str(), buf.data(), buf.size());
+            if (ret < 0) {
+                ret = -errno;
+            } else if (!writeMemory(notification.pid, args[shift + 1], buf.data(), (size_t)ret)) {
+                ret = -EFAULT;
+            }
+            break;
+        }
+        case Emulation::Access:
+        case Emulation::AccessFlags: {
+            int flags = emulation == Emulation::AccessFlags ? (int)args[3] : 0;
+            ret = ::syscall(SYS_faccessat2, AT_FDCWD, target.c_str(), (int)args[shift + 1], flags);
+            if (ret < 0) {
+                ret = -errno;
+            }
+            break;
+        }
+        case Emulation::None:
+            ret = -EPERM;
+            break;
+    }
+
+    if (ret < 0) {
+        answer.error = (int32_t)ret;
+    } else {
+        answer.val = ret;
+    }
+    return false;
+}
+
+NotifyInvoker::Emulation NotifyInvoker::emulationOf(long syscall) const {
+    return syscall >= 0 && (size_t)syscall < emulations.size() ? emulations[syscall] : Emulation::None;
+}
+
+void NotifyInvoker::openMemory(pid_t pid, bool reopen) {
+    if (memPid == pid && !reopen) {
+        return;
+    }
+    if (memfd >= 0) {
+        close(memfd);
+    }
+    std::string mem = "/proc/" + std::to_string(pid) + "/mem";
+    memfd = open(mem.c_str(), O_RDWR | O_CLOEXEC);
+    memPid = pid;
+}
+
+bool NotifyInvoker::readString(pid_t pid, uint64_t addr, std::string &out, size_t max_size) {
+    static const size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+
+    out.clear();
+    // a cached descriptor may be of an earlier process with the same pid, so retry once
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        openMemory(pid, attempt > 0);
+        if (memfd < 0) {
+            continue;
+        }
+
+        char buf[256];
+        uint64_t next = addr;
+        while (out.size() < max_size) {
+            // stay within the page, the next one may not be mapped
+            size_t chunk = std::min(sizeof(buf), pageSize - next % pageSize);
+            ssize_t length = pread(memfd, buf, chunk, (off_t)next);
+            if (length <= 0) {
+                break;
+            }
+            auto *end = (char*)memchr(buf, 0, (size_t)length);
+            if (end) {
+                out.append(buf, end - buf);
+                return true;
+            }
+            out.append(buf, (size_t)length);
+            next += length;
+        }
+        if (out.size() >= max_size) {
+            out.resize(max_size);
+            return true;
+        }
+        out.clear();
+    }
+    return false;
+}
+
+bool NotifyInvoker::writeMemory(pid_t pid, uint64_t addr, const void *data, size_t size) {
+    // the program's own pages, which it could have written just as well
+    openMemory(pid, false);
+    return memfd >= 0 && pwrite(memfd, data, size, (off_t)addr) == (ssize_t)size;
+}
+
+boost::filesystem::path NotifyInvoker::descriptorPath(pid_t pid, int fd) {
+    if (fd < 0) {
+        return boost::filesystem::path();
+    }
+    std::string link = "/proc/" + std::to_string(pid) + "/fd/" + std::to_string(fd);
+    char target[PATH_MAX];
+    ssize_t length = readlink(link.c_str(), target, sizeof(target));
+    if (length <= 0 || (size_t)length >= sizeof(target) || target[0] != '/') {
+        // pipes, sockets and the like are no directories
+        return boost::filesystem::path();
+    }
+    return boost::filesystem::path(std::string(target, (size_t)length));
+}
+
+void NotifyInvoker::onWallLimit() {
+    if (config.log) {
+        std::cerr << "Wall Time Limit exceeded" << std::endl;
+    }
+    result.wallLimitExceeded = true;
+    killProgram();
+}
+
+void NotifyInvoker::killProgram() {
+    if (untraced.cgroup.valid()) {
+        untraced.cgroup.killAll();
+    } else {
+        // the group outlives its leader as long as any of the rest is left
+        kill(-pid, SIGKILL);
+    }
+}
+
+void NotifyInvoker::finish() {
+    int status = 0;
+    rusage ru = {};
+    while (wait4(pid, &status, 0, &ru) < 0 && errno == EINTR) {
+    }
+    result.wallClock = UntracedRun::getTime() - startTime;
+    if (!untraced.cgroup.valid()) {
+        // whatever the program left behind, collect() does the same with a cgroup
+        kill(-pid, SIGKILL);
+    }
+
+    Handover handover = { -1, 0 };
+    if (read(errorPipe, &handover, sizeof(handover)) == sizeof(handover)) {
+        closeDescriptors();
+        untraced.cgroup.destroy();
+        untraced.fail(handover.error, std::string("execve() failed: ") + strerror(handover.error));
+        return;
+    }
+    closeDescriptors();
+
+    untraced.collect(status, ru);
+
+    if (config.log) {
+        printResults();
+    }
+}
+
+void NotifyInvoker::child(int downPipe[2], int upPipe[2]) {
+    close(downPipe[1]);
+    close(upPipe[0]);
+
+    int rpipe = downPipe[0];
+    int wpipe = upPipe[1];
+
+    if (config.cgroupRoot.empty()) {
+        setpgid(0, 0);
+    }
+
+    int lock;
+    read(rpipe, &lock, sizeof(lock));
+
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigprocmask(SIG_SETMASK, &mask, NULL);
+
+    if (config.cpu >= 0) {
+        pinToCpus({ config.cpu });
+    }
+
+    Handover failed = { -1, 0 };
+    if ((!config.workingDirectory.empty() && chdir(config.workingDirectory.c_str()) == -1) ||
+        !untraced.redirectFiles()) {
+
+        failed.error = errno;
+        write(wpipe, &failed, sizeof(failed));
+        _exit(1);
+    }
+
+    untraced.setLimits(false);
+
+    int fd = seccompFilter.installListener();
+    if (fd < 0) {
+        failed.error = errno;
+        write(wpipe, &failed, sizeof(failed));
+        _exit(1);
+    }
+
+    // the filter applies from here on, these are the only syscalls before execve()
+    Handover handover = { fd, 0 };
+    write(wpipe, &handover, sizeof(handover));
+    read(rpipe, &lock, sizeof(lock));
+
+    failed.error = untraced.exec();
+    write(wpipe, &failed, sizeof(failed));
+    _exit(1);
+}
+
+void NotifyInvoker::buildSeccompFilter() {
+    const InvokerProfile &profile = config.profile;
+
+    const ProfileActions *precomputed = profile.actionsFor(archName);
+    if (precomputed) {
+        actions.assign(precomputed->actions, precomputed->actions + precomputed->count);
+    } else {
+        actions.assign(table.size, SyscallAction::Unspecified);
+        for (const SyscallPolicy &policy : profile.syscalls) {
+            int syscall = table.find(policy.syscall);
+            if (syscall >= 0) {
+                actions[syscall] = policy.action;
+            }
+        }
+    }
+
+    emulations.assign(table.size, Emulation::None);
+    static const std::pair<const char*, Emulation> emulated[] = {
+            { "open", Emulation::Open }, { "openat", Emulation::Open },
+            { "stat", Emulation::Stat }, { "newfstatat", Emulation::Stat }, { "lstat", Emulation::Lstat },
+            { "statx", Emulation::Statx },
+            { "readlink", Emulation::Readlink }, { "readlinkat", Emulation::Readlink },
+            { "access", Emulation::Access }, { "faccessat", Emulation::Access },
+            { "faccessat2", Emulation::AccessFlags },
+    };
+    for (const auto &entry : emulated) {
+        long syscall = table.find(entry.first);
+        if (syscall >= 0 && (size_t)syscall < emulations.size()) {
+            emulations[syscall] = entry.second;
+        }
+    }
+
+    syscallOpen = table.find("open");
+    syscallOpenat = table.find("openat");
+    syscallExecve = table.find("execve");
+    syscallsAt.clear();
+    for (const char *name : PathPolicy::atSyscalls) {
+        long syscall = table.find(name);
+        if (syscall >= 0) {
+            syscallsAt.push_back(syscall);
+        }
+    }
+    syscallsEmptyPath.clear();
+    for (const auto &entry : PathPolicy::emptyPathSyscalls) {
+        long syscall = table.find(entry.first);
+        if (syscall >= 0) {
+            syscallsEmptyPath.emplace_back(syscall, entry.second);
+        }
+    }
+
+    std::vector<SyscallAction> filtered = actions;
+    if (syscallExecve >= 0 && (size_t)syscallExecve < filtered.size()) {
+        SyscallAction &execve = filtered[syscallExecve];
+        SyscallAction action = execve == SyscallAction::Unspecified ? profile.defaultSyscallAction : execve;
+        if (action != SyscallAction::Allow && action != SyscallAction::Deny) {
+            // the child has to get through its own execve(), so we are asked about every one
+            execve = SyscallAction::CheckPathSecurity;
+        }
+    }
+
+    // always installed, the listener is how the child proves it got that far
+    seccompFilter.build(arch, table, filtered.data(), filtered.size(), table.size, profile.defaultSyscallAction,
+                        SeccompFilter::Decider::Supervisor);
+}
+
+void NotifyInvoker::closeDescriptors() {
+    for (int *fd : { &pidfd, &listener, &errorPipe, &memfd }) {
+        if (*fd >= 0) {
+            close(*fd);
+            *fd = -1;
+        }
+    }
+    memPid = -1;
+}
+
+const InvokerResult &NotifyInvoker::getResult() const {
+    return result;
+}
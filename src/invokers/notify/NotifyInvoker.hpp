@@ -0,0 +1,119 @@
+#ifndef INVOKE_NOTIFYINVOKER_HPP
+#define INVOKE_NOTIFYINVOKER_HPP
+
+
+#include <memory>
+#include <vector>
+#include <Invoker.hpp>
+#include <PathPolicy.hpp>
+#include <SeccompFilter.hpp>
+#include <SyscallTable.hpp>
+#include <invokers/UntracedRun.hpp>
+#include <linux/seccomp.h>
+
+// Runs the program without a tracer: allowed syscalls never leave the kernel and those
+// that need their path checked are sent to us as seccomp user notifications. Arguments
+// are read through /proc/<pid>/mem, so the program never stops and can be debugged from
+// inside the sandbox.
+//
+// Letting a checked syscall continue would have the kernel read the path again, after
+// another thread may have changed it, so we make the syscall ourselves on the path we
+// checked: open() installs the descriptor in the program with SECCOMP_IOCTL_NOTIF_ADDFD,
+// stat(), readlink() and access() write their results to its memory. Path syscalls we
+// can't make on its behalf are denied. /proc/self is the program's, but other links to
+// it, like /dev/fd, resolve to ours. Syscalls that are a violation whatever their
+// arguments kill the program with SIGSYS.
+//
+// Limits and accounting come from a cgroup v2 if InvokerConfig::cgroupRoot is set, whose
+// CPU time we check on a timer. Otherwise they come from rlimits and the child's rusage,
+// and every process the program forks has a CPU limit of its own. The program then runs
+// in a process group of its own, which is killed once it ends; this is no guard against
+// programs that may call setsid() or setpgid(), and leaves the terminal to us.
+class NotifyInvoker : public Invoker {
+private:
+    // how we make a path syscall on behalf of the program
+    enum class Emulation {
+        None,
+        Open,
+        Stat,
+        Lstat,
+        Statx,
+        Readlink,
+        Access,
+        AccessFlags,
+    };
+
+    const InvokerConfig &config;
+    InvokerResult result;
+
+    uint32_t arch;
+    const char *archName;
+    const SyscallTable &table;
+
+    bool prepared = false;
+    std::vector<SyscallAction> actions;
+    std::vector<long> syscallsAt;
+    // syscall and index of its flags, see PathPolicy::emptyPathSyscalls
+    std::vector<std::pair<long, int>> syscallsEmptyPath;
+    // indexed by syscall number
+    std::vector<Emulation> emulations;
+    long syscallOpen = -1;
+    long syscallOpenat = -1;
+    long syscallExecve = -1;
+    SeccompFilter seccompFilter;
+    PathPolicy paths;
+    UntracedRun untraced;
+
+    // sized as the kernel asks, see SECCOMP_GET_NOTIF_SIZES
+    std::vector<char> request;
+    std::vector<char> response;
+
+    pid_t pid = -1;
+    int pidfd = -1;
+    int listener = -1;
+    // the child reports a failed execve() here
+    int errorPipe = -1;
+    // /proc/<pid>/mem of the process that sent the last notification
+    pid_t memPid = -1;
+    int memfd = -1;
+    double startTime = 0.0;
+    bool didExec = false;
+
+    // nullptr unless config.stats is set
+    std::shared_ptr<SyscallStats> stats;
+
+    // spawns the program, false if it never got to execve()
+    bool start();
+    // answers one notification once the listener is readable
+    void onNotification();
+    void onWallLimit();
+    // waits for the program and computes the verdicts
+    void finish();
+    void child(int downPipe[2], int upPipe[2]);
+    bool receiveListener(int downPipe, int upPipe);
+    void buildSeccompFilter();
+    // 0 if the syscall is allowed, otherwise the errno to fail it with. path is what was
+    // checked, empty if the syscall may continue as it is
+    int checkSyscall(const seccomp_notif &notification, bool &security, boost::filesystem::path &path);
+    // makes the allowed syscall on path and fills in answer, true if the kernel has
+    // already answered the program
+    bool emulate(const seccomp_notif &notification, const boost::filesystem::path &path, seccomp_notif_resp &answer);
+    Emulation emulationOf(long syscall) const;
+    void openMemory(pid_t pid, bool reopen);
+    // false if the memory can't be read, longer strings are cut at max_size
+    bool readString(pid_t pid, uint64_t addr, std::string &out, size_t max_size = 4096);
+    bool writeMemory(pid_t pid, uint64_t addr, const void *data, size_t size);
+    boost::filesystem::path descriptorPath(pid_t pid, int fd);
+    void closeDescriptors();
+    // the cgroup or, without one, the process group of the program
+    void killProgram();
+
+public:
+    NotifyInvoker(const InvokerConfig &config, uint32_t arch, const char *archName, const SyscallTable &table);
+    ~NotifyInvoker() override;
+    void run() override;
+    const InvokerResult& getResult() const override;
+};
+
+
+#endif //INVOKE_NOTIFYINVOKER_HPP
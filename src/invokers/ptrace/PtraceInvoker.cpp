@@ -4,320 +4,1608 @@
 #include <cstring>
 #include <vector>
 #include <cmath>
+#include <algorithm>
+#include <limits>
+#include <fstream>
+#include <sstream>
 
 #include <unistd.h>
+#include <dirent.h>
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/ptrace.h>
 #include <sys/wait.h>
 #include <sys/time.h>
+#include <sys/uio.h>
+#include <sys/syscall.h>
+#include <sched.h>
+#include <csignal>
+#include <ctime>
+#include <poll.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <linux/futex.h>
+#include <CpuTopology.hpp>
+#include <RawSyscall.hpp>
+
+namespace {
+
+// the tracee runs on this stack from clone() until execve()
+const size_t SPAWN_STACK_SIZE = 256 * 1024;
+
+// what a pooled tracee is sent for its run, the descriptors that are set come along
+struct PoolJob {
+    int attached[3];
+};
+
+// runs in the pooled tracee, so it must not allocate or touch errno
+bool receiveJob(int socket, int fds[3]) {
+    PoolJob job = {};
+    iovec iov = { &job, sizeof(job) };
+    alignas(cmsghdr) char control[CMSG_SPACE(3 * sizeof(int))];
+    msghdr msg = {};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    long length;
+    while ((length = rawSyscall(SYS_recvmsg, socket, (long)&msg, MSG_CMSG_CLOEXEC)) == -EINTR) {
+    }
+    if (length != (long)sizeof(job)) {
+        // the invoker is gone
+        return false;
+    }
+
+    int received[3];
+    size_t count = 0;
+    cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    if (cmsg && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+        count = std::min((cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int), (size_t)3);
+        memcpy(received, CMSG_DATA(cmsg), count * sizeof(int));
+    }
+
+    size_t next = 0;
+    for (int i = 0; i < 3; ++i) {
+        fds[i] = -1;
+        if (!job.attached[i]) {
+            continue;
+        }
+        if (next == count) {
+            return false;
+        }
+        fds[i] = received[next++];
+        if (fds[i] <= STDERR_FILENO) {
+            // where it is would be overwritten by the one before it
+            fds[i] = (int)rawSyscall(SYS_fcntl, fds[i], F_DUPFD_CLOEXEC, STDERR_FILENO + 1);
+        }
+    }
+    return true;
+}
+
+// copies what is left of `from` to `to`
+bool copyAll(int from, int to) {
+    char buf[64 * 1024];
+    ssize_t got;
+    while ((got = read(from, buf, sizeof(buf))) != 0) {
+        if (got < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        for (ssize_t done = 0; done < got;) {
+            ssize_t put = write(to, buf + done, (size_t)(got - done));
+            if (put < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            done += put;
+        }
+    }
+    return true;
+}
+
+// a memfd and a description of it opened with `flags`, numbered `lowest` or above
+bool openMemfd(const char *name, int flags, int lowest, int &fd, int &peer) {
+    fd = memfd_create(name, MFD_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    std::string path = "/proc/self/fd/" + std::to_string(fd);
+    int opened = open(path.c_str(), flags | O_CLOEXEC);
+    if (opened < 0) {
+        return false;
+    }
+    peer = fcntl(opened, F_DUPFD_CLOEXEC, lowest);
+    close(opened);
+    return peer >= 0;
+}
+
+}
 
-PtraceInvoker::PtraceInvoker(const InvokerConfig &config) : config(config) {
+PtraceInvoker::PtraceInvoker(const InvokerConfig &config, const SyscallArch &native, const SyscallArch &compat)
+        : config(config) {
+    nativeActions.arch = native;
+    compatActions.arch = compat;
+}
+
+PtraceInvoker::~PtraceInvoker() {
+    for (auto &pooled : pool) {
+        releasePooled(*pooled);
+    }
+    releaseServer();
+    for (int fd : { server.input, server.output, server.errors, server.inputPeer, server.outputPeer, server.errorsPeer }) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+}
 
+void PtraceInvoker::armTimer(int fd, double seconds) {
+    double whole;
+    double fraction = modf(seconds, &whole);
+    itimerspec spec = {};
+    spec.it_value.tv_sec = (time_t)whole;
+    spec.it_value.tv_nsec = (long)(fraction * 1e9);
+    timerfd_settime(fd, 0, &spec, NULL);
 }
 
 void PtraceInvoker::run() {
-    buildSyscallTable();
+    // stops are only reported through SIGCHLD, so it is read from a signalfd
+    sigset_t mask, oldMask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGCHLD);
+    sigprocmask(SIG_BLOCK, &mask, &oldMask);
+
+    if (!start()) {
+        sigprocmask(SIG_SETMASK, &oldMask, NULL);
+        return;
+    }
+
+    // the program is busy starting up, we are not
+    refillPool();
+
+    enum { SIGNAL_FD, PID_FD, WALL_FD, CPU_FD, FD_COUNT };
+    pollfd fds[FD_COUNT];
+    for (pollfd &fd : fds) {
+        fd.fd = -1;
+        fd.events = POLLIN;
+    }
+
+    fds[SIGNAL_FD].fd = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    // the pidfd wakes us up when the root exits even if its SIGCHLD got merged with others
+    fds[PID_FD].fd = pidfd;
 
-    pid_t timeout_pid = -1;
     if (config.wallLimit > 0) {
-        timeout_pid = fork();
-        if (timeout_pid < 0) {
+        fds[WALL_FD].fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        armTimer(fds[WALL_FD].fd, config.wallLimit);
+    }
+
+    double delay = cpuCheckDelay();
+    if (delay > 0) {
+        fds[CPU_FD].fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        armTimer(fds[CPU_FD].fd, delay);
+    }
+
+    bool done = false;
+    while (!done) {
+        rusage ru;
+        int status;
+        pid_t p;
+        // __WALL reports the threads of the tracee as well
+        while (!done && (p = wait4(-1, &status, __WALL | __WNOTHREAD | WNOHANG, &ru)) > 0) {
+            done = onWait(p, status, ru);
+        }
+        if (done) {
+            break;
+        }
+
+        if (poll(fds, FD_COUNT, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
             result.error = errno;
-            result.errorMessage = std::string("Failed to fork: ") + strerror(errno);
+            result.errorMessage = std::string("poll() failed: ") + strerror(errno);
+            terminate();
+            break;
+        }
+
+        uint64_t expirations;
+        if (fds[WALL_FD].revents & POLLIN) {
             if (config.log) {
-                std::cerr << result.errorMessage << std::endl;
+                std::cerr << "Wall Time Limit exceeded" << std::endl;
+            }
+            onWallLimit();
+            break;
+        }
+
+        if (fds[CPU_FD].revents & POLLIN) {
+            read(fds[CPU_FD].fd, &expirations, sizeof(expirations));
+            if (onCpuCheck()) {
+                break;
             }
-            return;
+            armTimer(fds[CPU_FD].fd, cpuCheckDelay());
         }
 
-        if (timeout_pid == 0) {
-            timeout();
+        if (fds[SIGNAL_FD].revents & POLLIN) {
+            signalfd_siginfo info;
+            while (read(fds[SIGNAL_FD].fd, &info, sizeof(info)) > 0) {
+            }
+        }
+    }
+
+    for (int i = 0; i < FD_COUNT; ++i) {
+        // the pidfd is closed by finish()
+        if (fds[i].fd != -1 && i != PID_FD) {
+            close(fds[i].fd);
+        }
+    }
+    sigprocmask(SIG_SETMASK, &oldMask, NULL);
+
+    finish();
+}
+
+bool PtraceInvoker::start() {
+    result = InvokerResult();
+    result.cpu = config.cpu;
+    lastCpuCheck = 0.0;
+    readCalls = 0;
+    readBytes = 0;
+
+    resetStats();
+
+    if (config.tracerCpu >= 0) {
+        pinToCpus({ config.tracerCpu });
+    }
+
+    cpuParallelism = 1;
+    cpu_set_t affinity;
+    if (config.cpu < 0 && sched_getaffinity(0, sizeof(affinity), &affinity) == 0) {
+        cpuParallelism = std::max(CPU_COUNT(&affinity), 1);
+    }
+    if (config.cpuQuota > 0) {
+        cpuParallelism = std::max(std::min(cpuParallelism, (int)ceil(config.cpuQuota)), 1);
+    }
+
+    if (!prepared) {
+        // syscall tables only depend on the profile, so they are shared by all runs
+        buildSyscallTable(nativeActions);
+        if (compatActions.arch.auditArch != 0) {
+            buildSyscallTable(compatActions);
+        }
+        paths.build(config.profile);
+
+        // a thread can rewrite the path between our check and the kernel's read of it,
+        // so only the kernel can enforce the paths of a program that shares its memory
+        racyPathChecks = config.profile.needsPathChecks() && config.profile.sharesMemory();
+        landlockReady = (config.landlock || racyPathChecks) && landlock.build(config.profile);
+        if (config.landlock && !landlockReady && !racyPathChecks && config.log) {
+            std::cerr << "Landlock can't enforce the path permissions, checking them in the tracer" << std::endl;
+        }
+
+        useSeccomp = config.seccomp && SeccompFilter::available();
+        if (useSeccomp) {
+            buildSeccompFilter();
+        }
+        prepared = true;
+    }
+
+    if (config.forkServer) {
+        if (!loadServerInput()) {
+            return false;
+        }
+        // a program that never gets to the handshake runs the test like without a server
+        if (server.pid < 0 && !spawnServer()) {
+            return false;
+        }
+        return forkFromServer();
+    }
+    return spawn();
+}
+
+bool PtraceInvoker::spawn() {
+    dispatched.reset();
+    std::unique_ptr<PooledTracee> pooled;
+    if (!pool.empty()) {
+        pooled = std::move(pool.front());
+        pool.pop_front();
+        if (pooled->cgroup.valid() && pooled->memoryLimit != config.memoryLimit) {
+            // limited for another test
+            releasePooled(*pooled);
+            pooled.reset();
+        }
+    }
+
+    if (!pooled && !config.cgroupRoot.empty() && !setupCgroup()) {
+        return false;
+    }
+
+    if (!prepareSpawn()) {
+        if (pooled) {
+            releasePooled(*pooled);
         }
+        cgroup.destroy();
+        return false;
     }
 
-    int fdUp[2], fdDown[2];
-    pipe(fdUp);
-    pipe(fdDown);
+    spawnGo = 0;
+    spawnError = 0;
+    spawnTime = getTime();
 
-    pid_t child_pid = fork();
+    if (pooled) {
+        dispatched = std::move(pooled);
+        cgroup = dispatched->cgroup;
+        int childPidfd = dispatched->pidfd;
+        dispatched->pidfd = -1;
+        return tracer(dispatched->pid, childPidfd, dispatched.get());
+    }
+
+    // CLONE_VM spares copying our page tables: until execve() the child runs on its own
+    // stack in our memory and only reads what prepareSpawn() has laid out for it. It shares
+    // our TLS as well, so it makes its syscalls with rawSyscall(), which leaves errno alone.
+    int childPidfd = -1;
+    pid_t child_pid = clone(spawnTracee, spawnStack.data() + spawnStack.size(),
+                            CLONE_VM | CLONE_PIDFD | SIGCHLD, this, &childPidfd);
 
     if (child_pid < 0) {
         result.error = errno;
-        result.errorMessage = std::string("Failed to fork: ") + strerror(errno);
+        result.errorMessage = std::string("Failed to clone: ") + strerror(errno);
         if (config.log) {
             std::cerr << result.errorMessage << std::endl;
         }
-        if (timeout_pid != -1) {
-            kill(timeout_pid, SIGKILL);
-            waitpid(timeout_pid, NULL, 0);
+        cgroup.destroy();
+        return false;
+    }
+
+    return tracer(child_pid, childPidfd);
+}
+
+void PtraceInvoker::resetStats() {
+    stats.reset();
+    if (config.stats) {
+        stats = std::make_shared<SyscallStats>();
+        stats->archs[0].name = nativeActions.arch.name;
+        stats->archs[0].table = nativeActions.arch.table;
+        if (compatActions.arch.auditArch != 0) {
+            stats->archs[1].name = compatActions.arch.name;
+            stats->archs[1].table = compatActions.arch.table;
         }
-        close(fdUp[0]);
-        close(fdUp[1]);
-        close(fdDown[0]);
-        close(fdDown[1]);
-        return;
     }
+    result.stats = stats;
+}
+
+pid_t PtraceInvoker::getPid() const {
+    return state.pid;
+}
+
+void PtraceInvoker::setThreadListener(const std::function<void(pid_t tid, bool added)> &listener) {
+    threadListener = listener;
+}
+
+bool PtraceInvoker::prepareSpawn() {
+    if (config.workingDirectory.empty()) {
+        char *cwd_ = get_current_dir_name();
+        cwd = cwd_;
+        free(cwd_);
+    } else {
+        boost::system::error_code err;
+        cwd = boost::filesystem::canonical(config.workingDirectory, err);
+        if (err.value()) {
+            result.error = err.value();
+            result.errorMessage = "Failed to resolve working directory " + err.message();
+            if (config.log) {
+                std::cerr << result.errorMessage << std::endl;
+            }
+            return false;
+        }
+    }
+
+    paths.setWorkingDirectory(cwd, config.writeableFiles);
+
+    useLandlock = landlockReady && landlock.prepare(cwd, config.exe, config.writeableFiles);
+    if (racyPathChecks && !useLandlock) {
+        result.error = ENOTSUP;
+        result.errorMessage = "The program may share memory with itself, so the tracer can't check its paths safely, "
+                              "and Landlock can't enforce them here. Use the namespace invoker";
+        if (config.log) {
+            std::cerr << result.errorMessage << std::endl;
+        }
+        return false;
+    }
+    if (landlockReady && !useLandlock && config.log) {
+        std::cerr << "Landlock can't enforce the working directory, checking paths in the tracer" << std::endl;
+    }
+
+    // the tracee must not allocate, so everything it passes to execve() is ready beforehand
+    spawnArgs.clear();
+    for (const std::string &s : config.args) {
+        spawnArgs.push_back(const_cast<char*>(s.c_str()));
+    }
+    spawnArgs.push_back(NULL);
+
+    spawnEnv.clear();
+    for (const std::string &s : config.envp) {
+        spawnEnv.push_back(const_cast<char*>(s.c_str()));
+    }
+    spawnEnv.push_back(NULL);
+
+    CPU_ZERO(&spawnAffinity);
+    if (config.cpu >= 0) {
+        CPU_SET(config.cpu, &spawnAffinity);
+    }
+
+    if (spawnStack.empty()) {
+        spawnStack.resize(SPAWN_STACK_SIZE);
+    }
+    return true;
+}
+
+int PtraceInvoker::spawnTracee(void *invoker) {
+    static_cast<PtraceInvoker*>(invoker)->tracee();
+    return 1;
+}
+
+void PtraceInvoker::tracee() {
+    // wait until we are seized, so the tracer sees everything from execve() on
+    while (spawnGo == 0) {
+        rawSyscall(SYS_futex, (long)&spawnGo, FUTEX_WAIT, 0);
+    }
+
+    if (config.forkServer) {
+        // dup2() leaves them open across execve(), the runs get their files from the server
+        long error = rawSyscall(SYS_dup2, server.peer, FORK_SERVER_FD);
+        if (error >= 0) {
+            error = rawSyscall(SYS_dup2, server.peer, FORK_SERVER_FD + 1);
+        }
+        if (error < 0) {
+            spawnError = (int)-error;
+            _exit(1);
+        }
+        execTracee(server.inputPeer, server.outputPeer, server.errorsPeer);
+    }
+    execTracee(config.stdin_fd, config.stdout_fd, config.stderr_fd);
+}
+
+int PtraceInvoker::spawnPooledTracee(void *pooled) {
+    auto *tracee = static_cast<PooledTracee*>(pooled);
+    tracee->invoker->pooledTracee(*tracee);
+    return 1;
+}
+
+void PtraceInvoker::pooledTracee(const PooledTracee &pooled) {
+    // our copy of the invoker's end would keep the socket open once the invoker is gone
+    rawSyscall(SYS_close, pooled.socket);
+
+    // blocks until a run takes us, already seized and in the cgroup of that run
+    int fds[3];
+    if (!receiveJob(pooled.peer, fds)) {
+        _exit(1);
+    }
+    rawSyscall(SYS_close, pooled.peer);
+
+    execTracee(fds[0], fds[1], fds[2]);
+}
+
+void PtraceInvoker::execTracee(int stdinFd, int stdoutFd, int stderrFd) {
+    // the supervisor keeps SIGCHLD blocked, do not pass that on
+    sigset_t mask;
+    sigemptyset(&mask);
+    rawSyscall(SYS_rt_sigprocmask, SIG_SETMASK, (long)&mask, 0, _NSIG / 8);
+
+    if (config.cpu >= 0) {
+        rawSyscall(SYS_sched_setaffinity, 0, sizeof(spawnAffinity), (long)&spawnAffinity);
+    }
+
+    int error;
+    if ((error = doChdir()) != 0 ||
+        (error = dupFile(STDIN_FILENO, stdinFd)) != 0 ||
+        (error = dupFile(STDOUT_FILENO, stdoutFd)) != 0 ||
+        (error = dupFile(STDERR_FILENO, stderrFd)) != 0) {
+
+        spawnError = error;
+        _exit(1);
+    }
+    for (int fd : { stdinFd, stdoutFd, stderrFd }) {
+        if (fd > STDERR_FILENO) {
+            rawSyscall(SYS_close, fd);
+        }
+    }
+
+    // a fork server keeps no hard limits, its children may need higher ones than its first run
+    if (config.timeLimit > 0) {
+        auto cpu = (rlim_t)ceil(config.timeLimit);
+        // the soft limit stops it with SIGXCPU for us, the hard one keeps prlimit64() from raising it
+        setLimit(RLIMIT_CPU, cpu, config.forkServer ? RLIM_INFINITY : cpu + 1);
+    }
+
+    if (config.memoryLimit > 0 && config.cgroupRoot.empty()) {
+        auto mem = (rlim_t)config.memoryLimit;
+        mem *= 2; // we need it to detect memory limits
+        setLimit(RLIMIT_AS, mem, config.forkServer ? RLIM_INFINITY : mem);
+    }
+
+    if (useLandlock) {
+        error = landlock.restrictSelf();
+        if (error != 0) {
+            spawnError = error;
+            _exit(1);
+        }
+    }
+
+    // from now on only the syscalls that need a decision stop in the tracer
+    if (useSeccomp) {
+        error = (useLandlock ? landlockSeccompFilter : seccompFilter).install();
+        if (error != 0) {
+            spawnError = error;
+            _exit(1);
+        }
+    }
+
+    char **envp = config.inheritEnvironment ? environ : spawnEnv.data();
+    spawnError = (int)-rawSyscall(SYS_execve, (long)config.exe.c_str(), (long)spawnArgs.data(), (long)envp);
+    _exit(1);
+}
+
+void PtraceInvoker::trackRoot(pid_t pid) {
+    state.pid = pid;
+    state.didExec = false;
+    threads.clear();
+    processes.clear();
+    exitedCpuUsage = 0.0;
+    exitedMemoryUsage = 0;
+    TracedThread &leader = threads.insert(pid);
+    leader.tgid = pid;
+    processes[pid].threads = 1;
+    processes[pid].running = 1;
+}
+
+bool PtraceInvoker::tracer(pid_t pid, int childPidfd, PooledTracee *pooled) {
+    trackRoot(pid);
+    pidfd = childPidfd;
+
+    // the tracee waits for us before exec, so it starts accounting from the first instruction
+    if (!pooled && cgroup.valid() && !cgroup.attach(pid)) {
+        result.error = errno;
+        result.errorMessage = std::string("Failed to move tracee into cgroup: ") + strerror(errno);
+        if (config.log) {
+            std::cerr << result.errorMessage << std::endl;
+        }
+        kill(pid, SIGKILL);
+        waitpid(pid, NULL, __WALL);
+        close(pidfd);
+        pidfd = -1;
+        cgroup.destroy();
+        return false;
+    }
+
+    // PTRACE_SEIZE sets the options right away and does not stop the tracee
+    if (!pooled && ptrace(PTRACE_SEIZE, pid, NULL, seizeOptions()) == -1) {
+        result.error = errno;
+        result.errorMessage = std::string("Failed to seize tracee: ") + strerror(errno);
+        if (config.log) {
+            std::cerr << result.errorMessage << std::endl;
+        }
+        kill(pid, SIGKILL);
+        waitpid(pid, NULL, __WALL);
+        close(pidfd);
+        pidfd = -1;
+        cgroup.destroy();
+        return false;
+    }
+
+    result.cpuUsage = 0.0;
+    result.wallClock = 0.0;
+    result.memoryUsage = 0;
+    startTime = getTime();
+
+    if (pooled) {
+        bool sent = sendJob(pooled->socket);
+        int error = errno;
+        close(pooled->socket);
+        pooled->socket = -1;
+        if (!sent) {
+            result.error = error;
+            result.errorMessage = std::string("Failed to hand the run to a pooled tracee: ") + strerror(error);
+            if (config.log) {
+                std::cerr << result.errorMessage << std::endl;
+            }
+            kill(pid, SIGKILL);
+            reapThread(pid);
+            close(pidfd);
+            pidfd = -1;
+            cgroup.destroy();
+            return false;
+        }
+    } else {
+        spawnGo = 1;
+        syscall(SYS_futex, &spawnGo, FUTEX_WAKE, 1, NULL, NULL, 0);
+    }
+
+    // as with vfork(), wait for the tracee to run the new program: until then it
+    // shares our memory, including its stack
+    while (!state.didExec) {
+        rusage ru;
+        int status;
+        pid_t p = wait4(pid, &status, __WALL, &ru);
+        if (p < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        if (onWait(p, status, ru)) {
+            // execve() failed or the tracee was killed before it
+            finish();
+            return false;
+        }
+    }
+    return true;
+}
+
+long PtraceInvoker::seizeOptions() const {
+    long options = PTRACE_O_EXITKILL | PTRACE_O_TRACECLONE | PTRACE_O_TRACEFORK |
+                   PTRACE_O_TRACEVFORK | PTRACE_O_TRACEEXEC | PTRACE_O_TRACEEXIT;
+    if (useSeccomp) {
+        options |= PTRACE_O_TRACESECCOMP;
+    } else {
+        // tells syscall stops apart from event stops and real SIGTRAPs
+        options |= PTRACE_O_TRACESYSGOOD;
+    }
+    return options;
+}
+
+void PtraceInvoker::refillPool() {
+    // the seccomp filter and the seize options are only known once prepared,
+    // and runs forked from a server have no use for a pool
+    while (prepared && !config.forkServer && pool.size() < (size_t)std::max(config.poolSize, 0)) {
+        std::unique_ptr<PooledTracee> pooled(new PooledTracee());
+        if (!spawnPooled(*pooled)) {
+            break;
+        }
+        pool.push_back(std::move(pooled));
+    }
+}
+
+bool PtraceInvoker::spawnPooled(PooledTracee &pooled) {
+    int sockets[2];
+    if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, sockets) == -1) {
+        if (config.log) {
+            std::cerr << "Failed to add a tracee to the pool: " << strerror(errno) << std::endl;
+        }
+        return false;
+    }
+    pooled.invoker = this;
+    pooled.socket = sockets[0];
+    pooled.peer = sockets[1];
+    pooled.memoryLimit = config.memoryLimit;
+
+    bool ok = config.cgroupRoot.empty() || limitCgroup(pooled.cgroup);
+    if (ok) {
+        pooled.stack.resize(SPAWN_STACK_SIZE);
+        pooled.pid = clone(spawnPooledTracee, pooled.stack.data() + pooled.stack.size(),
+                           CLONE_VM | CLONE_PIDFD | SIGCHLD, &pooled, &pooled.pidfd);
+        ok = pooled.pid > 0;
+    }
+    // the tracee reads its end from `pooled`, not from our descriptor table
+    close(pooled.peer);
+
+    ok = ok && (!pooled.cgroup.valid() || pooled.cgroup.attach(pooled.pid)) &&
+         ptrace(PTRACE_SEIZE, pooled.pid, NULL, seizeOptions()) != -1;
+    if (!ok) {
+        if (config.log) {
+            std::cerr << "Failed to add a tracee to the pool: " << strerror(errno) << std::endl;
+        }
+        releasePooled(pooled);
+    }
+    return ok;
+}
 
-    if (child_pid == 0) {
-        tracee(fdDown, fdUp);
+bool PtraceInvoker::sendJob(int socket) const {
+    PoolJob job = {};
+    int fds[3];
+    size_t count = 0;
+    const int descriptors[3] = { config.stdin_fd, config.stdout_fd, config.stderr_fd };
+    for (int i = 0; i < 3; ++i) {
+        if (descriptors[i] >= 0) {
+            job.attached[i] = 1;
+            fds[count++] = descriptors[i];
+        }
     }
 
-    tracer(child_pid, timeout_pid, fdDown, fdUp);
+    iovec iov = { &job, sizeof(job) };
+    alignas(cmsghdr) char control[CMSG_SPACE(3 * sizeof(int))] = {};
+    msghdr msg = {};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    if (count > 0) {
+        msg.msg_control = control;
+        msg.msg_controllen = CMSG_SPACE(count * sizeof(int));
+        cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(count * sizeof(int));
+        memcpy(CMSG_DATA(cmsg), fds, count * sizeof(int));
+    }
+    return sendmsg(socket, &msg, MSG_NOSIGNAL) == (ssize_t)sizeof(job);
 }
 
-void PtraceInvoker::timeout() {
-    usleep((useconds_t)(config.wallLimit * 1e6));
-    exit(0);
+bool PtraceInvoker::onPooledWait(pid_t pid, int status) {
+    auto it = std::find_if(pool.begin(), pool.end(), [pid](const std::unique_ptr<PooledTracee> &pooled) {
+        return pooled->pid == pid;
+    });
+    if (it == pool.end()) {
+        return false;
+    }
+
+    if (WIFSTOPPED(status)) {
+        // a signal for the waiting tracee, not for us to act on
+        ptrace(PTRACE_CONT, pid, NULL, (status >> 16) == 0 ? WSTOPSIG(status) : 0);
+        return true;
+    }
+    if (WIFEXITED(status) || WIFSIGNALED(status)) {
+        // already reaped
+        (*it)->pid = -1;
+        releasePooled(**it);
+        pool.erase(it);
+    }
+    return true;
+}
+
+void PtraceInvoker::releasePooled(PooledTracee &pooled) {
+    if (pooled.pid > 0) {
+        // it shares our memory, the stack must not go before it does
+        kill(pooled.pid, SIGKILL);
+        reapThread(pooled.pid);
+        pooled.pid = -1;
+    }
+    for (int *fd : { &pooled.socket, &pooled.pidfd }) {
+        if (*fd >= 0) {
+            close(*fd);
+            *fd = -1;
+        }
+    }
+    pooled.cgroup.destroy();
+}
+
+bool PtraceInvoker::openServerFiles() {
+    // descriptions of their own, so that the program can neither write its input nor read its output
+    bool ok = (server.input >= 0 ||
+               openMemfd("invoke-input", O_RDONLY, FORK_SERVER_FD + 2, server.input, server.inputPeer)) &&
+              (server.output >= 0 ||
+               openMemfd("invoke-output", O_WRONLY, FORK_SERVER_FD + 2, server.output, server.outputPeer)) &&
+              (server.errors >= 0 || config.stderr_fd < 0 ||
+               openMemfd("invoke-errors", O_WRONLY, FORK_SERVER_FD + 2, server.errors, server.errorsPeer));
+    if (!ok) {
+        result.error = errno;
+        result.errorMessage = std::string("Failed to create the files of the fork server: ") + strerror(errno);
+        if (config.log) {
+            std::cerr << result.errorMessage << std::endl;
+        }
+    }
+    return ok;
+}
+
+bool PtraceInvoker::loadServerInput() {
+    if (!openServerFiles()) {
+        return false;
+    }
+    bool ok = ftruncate(server.input, 0) == 0 && lseek(server.input, 0, SEEK_SET) == 0 &&
+              (config.stdin_fd < 0 || copyAll(config.stdin_fd, server.input));
+    if (!ok) {
+        result.error = errno;
+        result.errorMessage = std::string("Failed to load the input of the run: ") + strerror(errno);
+        if (config.log) {
+            std::cerr << result.errorMessage << std::endl;
+        }
+        return false;
+    }
+    return rewindServerFiles();
+}
+
+bool PtraceInvoker::rewindServerFiles() {
+    // the server and its children share the offsets of these descriptions with us
+    bool ok = lseek(server.inputPeer, 0, SEEK_SET) == 0;
+    for (int fd : { server.output, server.errors }) {
+        ok = ok && (fd < 0 || ftruncate(fd, 0) == 0);
+    }
+    for (int fd : { server.outputPeer, server.errorsPeer }) {
+        ok = ok && (fd < 0 || lseek(fd, 0, SEEK_SET) == 0);
+    }
+    if (!ok) {
+        result.error = errno;
+        result.errorMessage = std::string("Failed to rewind the files of the fork server: ") + strerror(errno);
+        if (config.log) {
+            std::cerr << result.errorMessage << std::endl;
+        }
+    }
+    return ok;
+}
+
+void PtraceInvoker::collectServerOutput() {
+    const int outputs[][2] = { { server.output, config.stdout_fd }, { server.errors, config.stderr_fd } };
+    for (const auto &output : outputs) {
+        if (output[0] < 0 || output[1] < 0) {
+            continue;
+        }
+        if ((lseek(output[0], 0, SEEK_SET) != 0 || !copyAll(output[0], output[1])) && result.error == 0) {
+            result.error = errno;
+            result.errorMessage = std::string("Failed to copy the output of the run: ") + strerror(errno);
+            if (config.log) {
+                std::cerr << result.errorMessage << std::endl;
+            }
+        }
+    }
+}
+
+bool PtraceInvoker::spawnServer() {
+    int sockets[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, sockets) == -1) {
+        result.error = errno;
+        result.errorMessage = std::string("Failed to set up the fork server: ") + strerror(errno);
+        if (config.log) {
+            std::cerr << result.errorMessage << std::endl;
+        }
+        return false;
+    }
+    server.socket = sockets[0];
+    // above the handshake descriptors, which dup2() overwrites
+    server.peer = fcntl(sockets[1], F_DUPFD_CLOEXEC, FORK_SERVER_FD + 2);
+    close(sockets[1]);
+    if (server.peer < 0) {
+        result.error = errno;
+        result.errorMessage = std::string("Failed to set up the fork server: ") + strerror(errno);
+        if (config.log) {
+            std::cerr << result.errorMessage << std::endl;
+        }
+        releaseServer();
+        return false;
+    }
+
+    if (!spawn()) {
+        releaseServer();
+        return false;
+    }
+    return awaitServer();
+}
+
+bool PtraceInvoker::awaitServer() {
+    // the program has its end, ours would keep the socket open once it has closed it
+    close(server.peer);
+    server.peer = -1;
+
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGCHLD);
+    enum { SIGNAL_FD, SERVER_FD, FD_COUNT };
+    pollfd fds[FD_COUNT];
+    fds[SIGNAL_FD].fd = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    fds[SERVER_FD].fd = server.socket;
+    for (pollfd &fd : fds) {
+        fd.events = POLLIN;
+    }
+
+    // the startup is traced like a run and gets its limits, but it is charged to none
+    bool ready = false;
+    bool over = false;
+    while (!ready && !over) {
+        rusage ru;
+        int status;
+        pid_t p;
+        while (!over && (p = wait4(-1, &status, __WALL | __WNOTHREAD | WNOHANG, &ru)) > 0) {
+            over = onWait(p, status, ru);
+        }
+        if (over) {
+            break;
+        }
+
+        uint32_t hello;
+        ssize_t got = recv(server.socket, &hello, sizeof(hello), MSG_DONTWAIT);
+        if (got > 0) {
+            ready = true;
+            break;
+        }
+        if (got == 0) {
+            // it closed the handshake, so it runs the test itself
+            fds[SERVER_FD].fd = -1;
+        }
+
+        int timeout = -1;
+        if (config.wallLimit > 0) {
+            double left = startTime + config.wallLimit - getTime();
+            if (left <= 0) {
+                if (config.log) {
+                    std::cerr << "Wall Time Limit exceeded before the fork server was ready" << std::endl;
+                }
+                onWallLimit();
+                over = true;
+                break;
+            }
+            timeout = (int)ceil(left * 1000);
+        }
+
+        if (poll(fds, FD_COUNT, timeout) < 0 && errno != EINTR) {
+            result.error = errno;
+            result.errorMessage = std::string("poll() failed: ") + strerror(errno);
+            terminate();
+            over = true;
+        }
+        if (fds[SIGNAL_FD].revents & POLLIN) {
+            signalfd_siginfo info;
+            while (read(fds[SIGNAL_FD].fd, &info, sizeof(info)) > 0) {
+            }
+        }
+    }
+    close(fds[SIGNAL_FD].fd);
+
+    if (!over && (processes.size() > 1 || threads.size() > 1)) {
+        // fork() would only take the thread that does the handshake along
+        result.error = EINVAL;
+        result.errorMessage = "The fork server must be a single thread when it is ready to fork";
+        if (config.log) {
+            std::cerr << result.errorMessage << std::endl;
+        }
+        terminate();
+        over = true;
+    }
+
+    if (over) {
+        finish();
+        releaseServer();
+        return false;
+    }
+
+    if (config.log) {
+        std::cerr << "Fork server ready after " << getTime() - startTime << "s" << std::endl;
+    }
+
+    server.pid = state.pid;
+    server.thread = *threads.find(state.pid);
+    // it stays in the cgroup it has started in, the runs get theirs
+    server.cgroup = cgroup;
+    cgroup = Cgroup();
+    threads.clear();
+    processes.clear();
+    state.pid = -1;
+    close(pidfd);
+    pidfd = -1;
+
+    // it is waiting for runs from now on, every child gets the limits of its own run
+    rlimit unlimited = { RLIM_INFINITY, RLIM_INFINITY };
+    prlimit(server.pid, RLIMIT_CPU, &unlimited, NULL);
+    prlimit(server.pid, RLIMIT_AS, &unlimited, NULL);
+
+    // what it has read or written while starting up is of no run
+    return rewindServerFiles();
+}
+
+bool PtraceInvoker::forkFromServer() {
+    if (!config.cgroupRoot.empty() && !setupCgroup()) {
+        return false;
+    }
+
+    // whatever the server has reported about the previous runs
+    char reports[64];
+    while (recv(server.socket, reports, sizeof(reports), MSG_DONTWAIT) > 0) {
+    }
+
+    spawnTime = getTime();
+    server.forkPending = true;
+    server.child = -1;
+    uint32_t go = 0;
+    int error = ETIMEDOUT;
+    if (send(server.socket, &go, sizeof(go), MSG_NOSIGNAL) != (ssize_t)sizeof(go)) {
+        error = errno;
+    }
+
+    // as for execve(), except that a server is not trusted to ever get there
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGCHLD);
+    while (error == ETIMEDOUT && server.pid > 0 && server.child < 0) {
+        int status;
+        pid_t p = wait4(server.pid, &status, __WALL | WNOHANG, NULL);
+        if (p == server.pid) {
+            onServerWait(status);
+            continue;
+        }
+        if (p < 0 && errno != EINTR) {
+            break;
+        }
+
+        timespec left = {};
+        timespec *timeout = nullptr;
+        if (config.wallLimit > 0) {
+            double seconds = spawnTime + config.wallLimit - getTime();
+            if (seconds <= 0) {
+                break;
+            }
+            left.tv_sec = (time_t)seconds;
+            left.tv_nsec = (long)((seconds - (double)left.tv_sec) * 1e9);
+            timeout = &left;
+        }
+        // SIGCHLD is blocked and we only wait for it
+        sigtimedwait(&mask, NULL, timeout);
+    }
+    server.forkPending = false;
+
+    pid_t child = server.child;
+    if (child < 0) {
+        result.error = server.pid < 0 ? ECHILD : error;
+        result.errorMessage = std::string("The fork server did not fork the run: ") + strerror(result.error);
+        if (config.log) {
+            std::cerr << result.errorMessage << std::endl;
+        }
+        releaseServer();
+        cgroup.destroy();
+        return false;
+    }
+
+    // it runs the program already, from a copy of the server
+    trackRoot(child);
+    state.didExec = true;
+
+    // the server has no hard limits, so the run can get any of its own
+    rlimit cpu = { RLIM_INFINITY, RLIM_INFINITY };
+    if (config.timeLimit > 0) {
+        cpu = { (rlim_t)ceil(config.timeLimit), (rlim_t)ceil(config.timeLimit) + 1 };
+    }
+    rlimit as = { RLIM_INFINITY, RLIM_INFINITY };
+    if (config.memoryLimit > 0 && config.cgroupRoot.empty()) {
+        auto mem = (rlim_t)config.memoryLimit * 2;
+        as = { mem, mem };
+    }
+
+    // it is stopped before its first instruction, so everything it does is charged to the run
+    const char *failure = nullptr;
+    if (cgroup.valid() && !cgroup.attach(child)) {
+        failure = "Failed to move the forked run into cgroup: ";
+    } else if (prlimit(child, RLIMIT_CPU, &cpu, NULL) != 0 || prlimit(child, RLIMIT_AS, &as, NULL) != 0) {
+        failure = "Failed to limit the forked run: ";
+    }
+    if (failure) {
+        result.error = errno;
+        result.errorMessage = failure + std::string(strerror(errno));
+        if (config.log) {
+            std::cerr << result.errorMessage << std::endl;
+        }
+        kill(child, SIGKILL);
+        reapThread(child);
+        threads.clear();
+        processes.clear();
+        cgroup.destroy();
+        return false;
+    }
+
+    pidfd = (int)syscall(SYS_pidfd_open, child, 0);
+    // nothing of the startup of the server belongs to the run
+    result.cpuUsage = 0.0;
+    result.wallClock = 0.0;
+    result.memoryUsage = 0;
+    result.threads.clear();
+    resetStats();
+    lastCpuCheck = 0.0;
+    result.spawnLatency = getTime() - spawnTime;
+    startTime = getTime();
+    return true;
+}
+
+bool PtraceInvoker::onServerWait(int status) {
+    pid_t pid = server.pid;
+    if (WIFEXITED(status) || WIFSIGNALED(status)) {
+        if (config.log) {
+            std::cerr << "Fork server exited" << std::endl;
+        }
+        // already reaped
+        server.pid = -1;
+        releaseServer();
+        return false;
+    }
+    if (!WIFSTOPPED(status)) {
+        return true;
+    }
+
+    int event = status >> 16;
+    int sendSignal = 0;
+    bool allowed = true;
+    SyscallInfo info;
+    long denySyscall = 0;
+
+    if (event == PTRACE_EVENT_SECCOMP) {
+        if (fetchSyscall(pid, info)) {
+            allowed = checkServerSyscall(pid, info, denySyscall);
+            if (denySyscall != 0) {
+                writeSyscall(pid, -1);
+                writeResult(pid, denySyscall);
+            }
+        }
+    } else if (WSTOPSIG(status) == (SIGTRAP | 0x80)) {
+        TracedThread &thread = server.thread;
+        thread.inSyscall = !thread.inSyscall;
+        if (thread.inSyscall && fetchSyscall(pid, info)) {
+            allowed = checkServerSyscall(pid, info, denySyscall);
+            if (denySyscall != 0) {
+                writeSyscall(pid, -1);
+                thread.denySyscall = denySyscall;
+            }
+        } else if (!thread.inSyscall && thread.denySyscall != 0) {
+            writeResult(pid, thread.denySyscall);
+            thread.denySyscall = 0;
+        }
+    } else if (event == PTRACE_EVENT_FORK || event == PTRACE_EVENT_VFORK || event == PTRACE_EVENT_CLONE) {
+        unsigned long child = 0;
+        ptrace(PTRACE_GETEVENTMSG, pid, NULL, &child);
+        if (event == PTRACE_EVENT_FORK && server.forkPending) {
+            server.forkPending = false;
+            server.child = (pid_t)child;
+        } else {
+            // not what the handshake is for
+            kill((pid_t)child, SIGKILL);
+            reapThread((pid_t)child);
+            allowed = false;
+        }
+    } else if (event == PTRACE_EVENT_EXEC) {
+        // another program now
+        allowed = false;
+    } else if (event == 0) {
+        sendSignal = WSTOPSIG(status);
+    }
+
+    if (!allowed) {
+        if (config.log) {
+            std::cerr << "Fork server left the handshake, stopping it" << std::endl;
+        }
+        releaseServer();
+        return false;
+    }
+    ptrace(useSeccomp ? PTRACE_CONT : PTRACE_SYSCALL, pid, NULL, sendSignal);
+    return true;
+}
+
+bool PtraceInvoker::checkServerSyscall(pid_t pid, const SyscallInfo &info, long &denySyscall) {
+    if (info.arch == nativeActions.arch.auditArch) {
+        auto listed = [&info](const std::vector<long> &syscalls) {
+            return std::find(syscalls.begin(), syscalls.end(), info.syscall) != syscalls.end();
+        };
+        // reaping its children, and forking when asked to
+        if (listed(nativeActions.syscallsWait) || (server.forkPending && listed(nativeActions.syscallsFork))) {
+            return true;
+        }
+    }
+    return checkSyscall(pid, info, denySyscall);
+}
+
+void PtraceInvoker::releaseServer() {
+    if (server.pid > 0) {
+        kill(server.pid, SIGKILL);
+        reapThread(server.pid);
+        server.pid = -1;
+    }
+    for (int *fd : { &server.socket, &server.peer }) {
+        if (*fd >= 0) {
+            close(*fd);
+            *fd = -1;
+        }
+    }
+    server.forkPending = false;
+    server.cgroup.destroy();
+}
+
+bool PtraceInvoker::onWait(pid_t pid, int status, const rusage &ru) {
+    if (!pool.empty() && onPooledWait(pid, status)) {
+        return false;
+    }
+    if (pid == server.pid) {
+        // whatever happens to the server, the run of its child goes on
+        onServerWait(status);
+        return false;
+    }
+
+    bool root = pid == state.pid;
+    double stopped = stats && WIFSTOPPED(status) ? getTime() : 0;
+
+    if (WIFSIGNALED(status) && WTERMSIG(status) == SIGSYS) {
+        // killed by the seccomp filter
+        result.securityViolation = true;
+    }
+
+    if (!root && (WIFEXITED(status) || WIFSIGNALED(status))) {
+        // the run is over once the root is reported, which happens after all of its threads;
+        // other processes of the tree are just forgotten
+        removeThread(pid);
+        return false;
+    }
+
+    if (root && WIFEXITED(status) && !state.didExec) {
+        if (spawnError != 0) {
+            // execve() failed
+            result.error = spawnError;
+            result.errorMessage = std::string("execve() failed: ") + strerror(spawnError);
+            if (config.log) {
+                std::cerr << result.errorMessage << std::endl;
+            }
+        }
+        threads.clear();
+        processes.clear();
+        return true;
+    }
+
+    TracedThread *thread = nullptr;
+    if (WIFSTOPPED(status)) {
+        thread = threads.find(pid);
+        if (!thread) {
+            // a new task may report its first stop before the ptrace event of its parent
+            pid_t tgid = (pid_t)readProcStatus(pid, "Tgid:");
+            if (!addThread(pid, tgid > 0 ? tgid : pid)) {
+                result.securityViolation = true;
+                terminate();
+                return true;
+            }
+            thread = threads.find(pid);
+        }
+    }
+
+    if (root || (thread && thread->tgid == state.pid)) {
+        // the usage reported for the root covers its threads and the children it has waited for
+        double cpuUsage = tvToSeconds(ru.ru_utime) + tvToSeconds(ru.ru_stime);
+        if (result.cpuUsage < cpuUsage)
+            result.cpuUsage = cpuUsage;
+        // ru_maxrss is no use here: execve() keeps the peak of the old address space in it,
+        // which is the tracer's own. Peak memory is read from VmHWM as processes exit instead.
+    }
+
+    bool quit = false;
+
+    if (config.timeLimit > 0 && result.cpuUsage >= config.timeLimit) {
+        quit = true;
+    }
+
+    if (config.memoryLimit > 0 && result.memoryUsage >= config.memoryLimit) {
+        quit = true;
+    }
+
+    if (WIFEXITED(status)) {
+        result.exitCode = WEXITSTATUS(status);
+        if (config.log) {
+            std::cerr << "Tracee died with exit code " << result.exitCode << std::endl;
+        }
+        // whatever the root left behind must not outlive the run
+        terminate();
+        return true;
+    }
+
+    if (WIFSIGNALED(status)) {
+        result.exitCode = -WTERMSIG(status);
+        if (config.log) {
+            std::cerr << "Tracee died with signal " << -result.exitCode << std::endl;
+        }
+        terminate();
+        return true;
+    }
+
+    if (WIFSTOPPED(status)) {
+        int sendSignal = WSTOPSIG(status);
+
+        if ((status >> 16) == PTRACE_EVENT_STOP) {
+            // first stop of an automatically attached task, or a group-stop: carry on
+            sendSignal = 0;
+        } else if ((WSTOPSIG(status) == SIGTRAP && (status >> 16) != 0) || WSTOPSIG(status) == (SIGTRAP | 0x80)) {
+            // ptrace event or syscall stop
+            sendSignal = 0;
+            if (!onTrap(pid, status)) {
+                // security violation, kill it
+                if (config.log) {
+                    std::cerr << "Tracee made dangerous system call. Security Violation" << std::endl;
+                }
+                result.securityViolation = true;
+                quit = true;
+            }
+        }
+
+        if (WSTOPSIG(status) == SIGXCPU) {
+            // cpu limit exceeded
+            if (config.log) {
+                std::cerr << "Tracee received SIGXCPU. Time Limit Exceeded" << std::endl;
+            }
+            result.timeLimitExceeded = true;
+            quit = true;
+        }
+
+        if (config.timeLimit > 0 && result.cpuUsage >= config.timeLimit) {
+            quit = true;
+        }
+
+        if (config.memoryLimit > 0 && result.memoryUsage >= config.memoryLimit) {
+            quit = true;
+        }
+
+        if (!quit) {
+            ptrace(useSeccomp ? PTRACE_CONT : PTRACE_SYSCALL, pid, NULL, sendSignal);
+            if (stats) {
+                countStop(pid, stopped);
+            }
+        }
+    }
+
+    if (quit) {
+        terminate();
+        return true;
+    }
+
+    return false;
+}
+
+void PtraceInvoker::onWallLimit() {
+    result.wallLimitExceeded = true;
+    terminate();
+}
+
+void PtraceInvoker::terminate() {
+    std::vector<pid_t> tgids;
+    for (auto &process : processes) {
+        tgids.push_back(process.first);
+    }
+    if (std::find(tgids.begin(), tgids.end(), state.pid) == tgids.end()) {
+        tgids.push_back(state.pid);
+    }
+
+    // killed processes do not stop at PTRACE_EVENT_EXIT, so their peak memory is taken now
+    long liveMemoryUsage = 0;
+    for (auto &process : processes) {
+        if (process.second.running > 0) {
+            liveMemoryUsage += std::max(readProcStatus(process.first, "VmHWM:"), 0L) * 1024L;
+        }
+    }
+    result.memoryUsage = std::max(result.memoryUsage, exitedMemoryUsage + liveMemoryUsage);
+
+    for (pid_t tgid : tgids) {
+        kill(tgid, SIGKILL);
+    }
+
+    // traced threads stay zombies until we reap them, and a leader is only
+    // reported after all of its threads, including those we have not heard of yet
+    std::vector<pid_t> tids = threads.tids();
+    for (pid_t tgid : tgids) {
+        std::string taskDir = "/proc/" + std::to_string(tgid) + "/task";
+        DIR *dir = opendir(taskDir.c_str());
+        if (dir) {
+            while (dirent *entry = readdir(dir)) {
+                pid_t tid = (pid_t)atoi(entry->d_name);
+                if (tid > 0) {
+                    tids.push_back(tid);
+                }
+            }
+            closedir(dir);
+        }
+    }
+
+    std::sort(tids.begin(), tids.end());
+    tids.erase(std::unique(tids.begin(), tids.end()), tids.end());
+    for (pid_t tid : tids) {
+        if (std::find(tgids.begin(), tgids.end(), tid) == tgids.end()) {
+            reapThread(tid);
+            removeThread(tid);
+        }
+    }
+    for (pid_t tgid : tgids) {
+        if (tgid != state.pid) {
+            reapThread(tgid);
+            removeThread(tgid);
+        }
+    }
+    reapThread(state.pid);
+    threads.clear();
+    processes.clear();
+}
+
+void PtraceInvoker::reapThread(pid_t tid) {
+    // SIGKILL does not end a stop we have already been told about at PTRACE_EVENT_EXIT
+    ptrace(PTRACE_CONT, tid, NULL, NULL);
+
+    int status;
+    while (waitpid(tid, &status, __WALL) == tid) {
+        if (WIFEXITED(status) || WIFSIGNALED(status)) {
+            break;
+        }
+        // dying threads still stop at PTRACE_EVENT_EXIT
+        ptrace(PTRACE_CONT, tid, NULL, NULL);
+    }
 }
 
-void PtraceInvoker::tracee(int downPipe[2], int upPipe[2]) {
-    close(downPipe[1]);
-    close(upPipe[0]);
-
-    int rpipe = downPipe[0];
-    int wpipe = upPipe[1];
-
-    int lock;
-    read(rpipe, &lock, sizeof(lock));
-    close(rpipe);
-    fcntl(wpipe, F_SETFD, FD_CLOEXEC);
-
-    if (!doChdir() ||
-        !dupFile(STDIN_FILENO, config.stdin_fd) ||
-        !dupFile(STDOUT_FILENO, config.stdout_fd) ||
-        !dupFile(STDERR_FILENO, config.stderr_fd)) {
+bool PtraceInvoker::addThread(pid_t tid, pid_t tgid) {
+    TracedThread &thread = threads.insert(tid);
+    thread.tgid = tgid;
+    TracedProcess &process = processes[tgid];
+    ++process.threads;
+    ++process.running;
+    if (threadListener) {
+        threadListener(tid, true);
+    }
 
-        write(wpipe, &result.error, sizeof(result.error));
-        exit(1);
+    // the new process is tracked anyway, so that it is reaped along with the others
+    if (tid == tgid && config.maxProcesses() > 0 && (long)processes.size() > config.maxProcesses()) {
+        if (config.log) {
+            std::cerr << "Tracee exceeded the limit of " << config.maxProcesses() << " processes" << std::endl;
+        }
+        return false;
     }
+    return true;
+}
 
-    if (config.timeLimit > 0) {
-        auto cpu = (rlim_t)ceil(config.timeLimit);
-        // use infinite hard limit, so we can catch SIGXCPUs
-        setLimit(RLIMIT_CPU, cpu, RLIM_INFINITY);
+void PtraceInvoker::removeThread(pid_t tid) {
+    TracedThread *thread = threads.find(tid);
+    if (!thread) {
+        return;
     }
 
-    if (config.memoryLimit > 0) {
-        auto mem = (rlim_t)config.memoryLimit;
-        mem *= 2; // we need it to detect memory limits
-        setLimit(RLIMIT_AS, mem, mem);
+    auto process = processes.find(thread->tgid);
+    if (process != processes.end() && --process->second.threads == 0) {
+        processes.erase(process);
     }
 
-    std::vector<char*> cargs;
-    cargs.reserve(config.args.size());
-    for (const std::string &s : config.args) {
-        char *t = new char[s.size() + 1];
-        strcpy(t, s.c_str());
-        cargs.push_back(t);
+    threads.erase(tid);
+    if (threadListener) {
+        threadListener(tid, false);
     }
-    cargs.push_back(NULL);
+}
 
-    if (config.inheritEnvironment) {
-        execv(config.exe.c_str(), &cargs[0]);
-    } else {
-        std::vector<char*> cenvp;
-        cenvp.reserve(config.envp.size());
-        for (const std::string &s : config.envp) {
-            char *t = new char[s.size() + 1];
-            strcpy(t, s.c_str());
-            cenvp.push_back(t);
+long PtraceInvoker::readProcStatus(pid_t pid, const std::string &key) {
+    std::ifstream status("/proc/" + std::to_string(pid) + "/status");
+    std::string field;
+    while (status >> field) {
+        if (field == key) {
+            long value = -1;
+            status >> value;
+            return value;
         }
-        cenvp.push_back(NULL);
-        execve(config.exe.c_str(), &cargs[0], &cenvp[0]);
+        status.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
     }
-
-    int err = errno;
-    write(wpipe, &err, sizeof(err));
-    close(wpipe);
-    exit(1);
+    return -1;
 }
 
-void PtraceInvoker::tracer(pid_t pid, pid_t timer, int downPipe[2], int upPipe[2]) {
-    close(downPipe[0]);
-    close(upPipe[1]);
+void PtraceInvoker::recordThreadUsage(pid_t tid) {
+    TracedThread *thread = threads.find(tid);
+    pid_t tgid = thread ? thread->tgid : state.pid;
+    std::string taskDir = "/proc/" + std::to_string(tgid) + "/task/" + std::to_string(tid);
 
-    int rpipe = upPipe[0];
-    int wpipe = downPipe[1];
+    double cpuUsage = -1;
 
-    int err = 0;
-    int status = 0;
-    didExec = false;
-    inSyscall = false;
-    denySyscall = false;
-
-    if (config.workingDirectory.empty()) {
-        char *cwd_ = get_current_dir_name();
-        cwd = cwd_;
-        free(cwd_);
+    // the first field is the time spent on a CPU in nanoseconds
+    std::ifstream schedstat(taskDir + "/schedstat");
+    unsigned long long runtime;
+    if (schedstat >> runtime) {
+        cpuUsage = runtime * 1e-9;
     } else {
-        boost::system::error_code err;
-        cwd = boost::filesystem::canonical(config.workingDirectory, err);
-        if (err.value()) {
-            result.error = err.value();
-            result.errorMessage = "Failed to resolve working directory " + err.message();
-            if (config.log) {
-                std::cerr << result.errorMessage << std::endl;
+        // otherwise fall back to utime and stime in clock ticks, the 14th and 15th fields;
+        // the command name in parentheses may contain spaces
+        static const double ticks = (double)sysconf(_SC_CLK_TCK);
+        std::ifstream file(taskDir + "/stat");
+        std::string line;
+        size_t pos;
+        if (std::getline(file, line) && (pos = line.rfind(')')) != std::string::npos) {
+            std::istringstream fields(line.substr(pos + 1));
+            std::string skip;
+            for (int i = 3; i < 14; ++i) {
+                fields >> skip;
             }
-            kill(pid, SIGKILL);
-            waitpid(pid, NULL, 0);
-            if (timer != -1) {
-                kill(timer, SIGKILL);
-                waitpid(timer, NULL, 0);
+            unsigned long utime = 0, stime = 0;
+            if (fields >> utime >> stime) {
+                cpuUsage = (utime + stime) / ticks;
             }
         }
     }
 
-    // attach to tracee
-    ptrace(PTRACE_ATTACH, pid, NULL, NULL);
-    waitpid(pid, &status, 0);
-    if (WIFSTOPPED(status) && WSTOPSIG(status) == SIGSTOP) {
-        // we have successfully attached to the tracee
+    if (cpuUsage >= 0) {
+        result.threads.push_back({ tid, cpuUsage });
+    }
 
-        ptrace(PTRACE_SETOPTIONS, pid, NULL, PTRACE_O_EXITKILL);
-        ptrace(PTRACE_CONT, pid, NULL, NULL); // we will stop at the next execve()
-    } else {
-        // something has gone seriously wrong
-        kill(pid, SIGKILL);
-        waitpid(pid, NULL, 0);
-        if (timer != -1) {
-            kill(timer, SIGKILL);
-            waitpid(timer, NULL, 0);
-        }
-        result.error = -1;
-        result.errorMessage =
-                "Failed to attach to tracee: waitpid() returned invalid status " +
-                std::to_string(status);
-        if (config.log) {
-            std::cerr << result.errorMessage << std::endl;
-        }
+    auto process = processes.find(tgid);
+    if (process == processes.end() || --process->second.running > 0) {
         return;
     }
 
-    write(wpipe, &err, sizeof(err));
-    close(wpipe);
+    // the last thread still holds the address space and the CPU clock of the whole process
+    double processCpu = processCpuTime(tgid);
+    if (processCpu >= 0) {
+        exitedCpuUsage += processCpu;
+        result.cpuUsage = std::max(result.cpuUsage, exitedCpuUsage);
+    }
 
-    if (read(rpipe, &err, sizeof(err)) > 0) {
-        // execve() failed
-        close(rpipe);
-        if (timer != -1) {
-            kill(timer, SIGKILL);
-            waitpid(timer, NULL, 0);
-        }
-        result.error = err;
-        result.errorMessage = std::string("execve() failed: ") + strerror(err);
-        if (config.log) {
-            std::cerr << result.errorMessage << std::endl;
-        }
+    if (!state.didExec) {
+        // still running in our address space after a failed execve()
         return;
     }
-    close(rpipe);
-
-    result.cpuUsage = 0.0;
-    result.wallClock = 0.0;
-    result.memoryUsage = 0;
-    double start = getTime();
-
-    for (;;) {
-        rusage ru;
-        pid_t p = wait3(&status, 0, &ru);
 
-        if (timer != -1 && p == timer) {
-            if (WIFEXITED(status)) {
-                if (config.log) {
-                    std::cerr << "Timer thread died. Wall Time Limit exceeded" << std::endl;
-                }
-                result.wallLimitExceeded = true;
-                kill(pid, SIGKILL);
-                waitpid(pid, NULL, 0);
-                break;
-            }
+    // the leader may be gone already, the exiting thread still holds the address space
+    std::ifstream status(taskDir + "/status");
+    std::string field;
+    while (status >> field) {
+        if (field == "VmHWM:") {
+            long kilobytes = 0;
+            status >> kilobytes;
+            exitedMemoryUsage += kilobytes * 1024L;
+            result.memoryUsage = std::max(result.memoryUsage, exitedMemoryUsage);
+            break;
         }
+        status.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    }
+}
 
-        if (p == pid) {
-            double cpuUsage = tvToSeconds(ru.ru_utime);
-            if (result.cpuUsage < cpuUsage)
-                result.cpuUsage = cpuUsage;
-
-            long memoryUsage = ru.ru_maxrss * 1024L;
-            if (result.memoryUsage < memoryUsage)
-                result.memoryUsage = memoryUsage;
+double PtraceInvoker::processCpuTime(pid_t pid) {
+    clockid_t clock;
+    timespec ts;
+    if (clock_getcpuclockid(pid, &clock) != 0 || clock_gettime(clock, &ts) != 0) {
+        return -1;
+    }
+    return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
 
-            bool quit = false;
+double PtraceInvoker::treeCpuTime() {
+    double cpuUsage = exitedCpuUsage;
+    for (auto &process : processes) {
+        if (process.second.running > 0) {
+            cpuUsage += std::max(processCpuTime(process.first), 0.0);
+        }
+    }
+    return cpuUsage;
+}
 
-            if (config.timeLimit > 0 && result.cpuUsage >= config.timeLimit) {
-                quit = true;
-            }
+double PtraceInvoker::cpuCheckDelay() const {
+    if (config.timeLimit <= 0) {
+        return -1;
+    }
+    // the tree can not use up the rest of the limit faster than on all of its CPUs at once
+    double remaining = config.timeLimit - std::max(result.cpuUsage, lastCpuCheck);
+    return std::max(remaining / cpuParallelism, 0.001);
+}
 
-            if (config.memoryLimit > 0 && result.memoryUsage >= config.memoryLimit) {
-                quit = true;
-            }
+bool PtraceInvoker::onCpuCheck() {
+    lastCpuCheck = treeCpuTime();
+    result.cpuUsage = std::max(result.cpuUsage, lastCpuCheck);
+    if (result.cpuUsage < config.timeLimit) {
+        return false;
+    }
 
-            if (WIFEXITED(status)) {
-                result.exitCode = WEXITSTATUS(status);
-                if (config.log) {
-                    std::cerr << "Tracee died with exit code " << result.exitCode << std::endl;
-                }
-                if (timer != -1) {
-                    kill(timer, SIGKILL);
-                    waitpid(timer, NULL, 0);
-                }
-                break;
-            }
+    if (config.log) {
+        std::cerr << "Tracee used up " << result.cpuUsage << "s of CPU time. Time Limit Exceeded" << std::endl;
+    }
+    result.timeLimitExceeded = true;
+    terminate();
+    return true;
+}
 
-            if (WIFSIGNALED(status)) {
-                result.exitCode = -WTERMSIG(status);
-                if (config.log) {
-                    std::cerr << "Tracee died with signal " << -result.exitCode << std::endl;
-                }
-                if (timer != -1) {
-                    kill(timer, SIGKILL);
-                    waitpid(timer, NULL, 0);
-                }
-                break;
-            }
+void PtraceInvoker::finish() {
+    if (pidfd != -1) {
+        close(pidfd);
+        pidfd = -1;
+    }
+    result.wallClock = getTime() - startTime;
 
-            if (WIFSTOPPED(status)) {
-                int sendSignal = WSTOPSIG(status);
-                if (WSTOPSIG(status) == SIGTRAP) {
-                    // ptrace event
-                    sendSignal = 0;
-                    if (!onTrap(pid)) {
-                        // security violation, kill it
-                        if (config.log) {
-                            std::cerr << "Tracee made dangerous system call. Security Violation" << std::endl;
-                        }
-                        result.securityViolation = true;
-                        quit = true;
-                    }
-                }
+    if (config.forkServer) {
+        collectServerOutput();
+    }
 
-                if (WSTOPSIG(status) == SIGXCPU) {
-                    // cpu limit exceeded
-                    if (config.log) {
-                        std::cerr << "Tracee received SIGXCPU. Time Limit Exceeded" << std::endl;
-                    }
-                    result.timeLimitExceeded = true;
-                    quit = true;
-                }
+    if (cgroup.valid()) {
+        // cgroup accounts for system time and for every child of the tracee
+        double cpuUsage = cgroup.cpuUsage();
+        if (cpuUsage >= 0) {
+            result.cpuUsage = cpuUsage;
+        }
 
-                if (!quit) {
-                    ptrace(PTRACE_SYSCALL, pid, NULL, sendSignal);
-                }
-            }
+        long memoryUsage = cgroup.memoryPeak();
+        if (memoryUsage >= 0) {
+            result.memoryUsage = memoryUsage;
+        }
 
-            if (quit) {
-                kill(pid, SIGKILL);
-                waitpid(pid, NULL, 0);
-                if (timer != -1) {
-                    kill(timer, SIGKILL);
-                    waitpid(timer, NULL, 0);
-                }
-                break;
-            }
+        if (cgroup.oomKills() > 0) {
+            result.memoryLimitExceeded = true;
         }
-    }
 
-    result.wallClock = getTime() - start;
+        cgroup.destroy();
+    }
 
     if (config.timeLimit > 0 && result.cpuUsage >= config.timeLimit) {
         result.timeLimitExceeded = true;
@@ -332,27 +1620,46 @@ void PtraceInvoker::tracer(pid_t pid, pid_t timer, int downPipe[2], int upPipe[2
     }
 
     if (config.log) {
+        std::cerr << "Read " << readBytes << " bytes of tracee memory in " << readCalls << " calls" << std::endl;
         printResults();
     }
 }
 
-bool PtraceInvoker::dupFile(int prev, int next) {
-    if (next < 0) {
-        if (close(prev) < 0) {
-            result.error = errno;
-            return false;
+bool PtraceInvoker::setupCgroup() {
+    bool ok = limitCgroup(cgroup);
+    if (!ok) {
+        result.error = errno;
+        result.errorMessage = std::string("Failed to set up cgroup: ") + strerror(errno);
+        if (config.log) {
+            std::cerr << result.errorMessage << std::endl;
         }
+        cgroup.destroy();
+    }
+    return ok;
+}
+
+bool PtraceInvoker::limitCgroup(Cgroup &target) const {
+    bool ok = target.create(config.cgroupRoot);
+    if (ok && config.memoryLimit > 0) {
+        ok = target.setMemoryLimit(config.memoryLimit);
+    }
+    if (ok && config.maxProcesses() > 0) {
+        ok = target.setProcessLimit(config.maxProcesses());
+    }
+    if (ok && config.cpuQuota > 0) {
+        ok = target.setCpuLimit(config.cpuQuota);
+    }
+    return ok;
+}
+
+int PtraceInvoker::dupFile(int prev, int next) {
+    long ret = 0;
+    if (next < 0) {
+        ret = rawSyscall(SYS_close, prev);
     } else if (prev != next) {
-        if (dup2(next, prev) < 0) {
-            result.error = errno;
-            return false;
-        }
-        if (close(next) < 0) {
-            result.error = errno;
-            return false;
-        }
+        ret = rawSyscall(SYS_dup2, next, prev);
     }
-    return true;
+    return ret < 0 ? (int)-ret : 0;
 }
 
 void PtraceInvoker::setLimit(__rlimit_resource limit, rlim_t soft, rlim_t hard) {
@@ -360,31 +1667,94 @@ void PtraceInvoker::setLimit(__rlimit_resource limit, rlim_t soft, rlim_t hard)
             soft,
             hard,
     };
-    setrlimit(limit, &lim);
+    rawSyscall(SYS_prlimit64, 0, limit, (long)&lim, 0);
+}
+
+boost::filesystem::path PtraceInvoker::traceeDescriptorPath(pid_t pid, int fd) {
+    if (fd < 0) {
+        return boost::filesystem::path();
+    }
+    std::string link = "/proc/" + std::to_string(pid) + "/fd/" + std::to_string(fd);
+    char target[PATH_MAX];
+    ssize_t length = readlink(link.c_str(), target, sizeof(target));
+    if (length <= 0 || (size_t)length >= sizeof(target) || target[0] != '/') {
+        // pipes, sockets and the like are no directories
+        return boost::filesystem::path();
+    }
+    return boost::filesystem::path(std::string(target, (size_t)length));
 }
 
-std::string PtraceInvoker::traceeReadString(pid_t pid, void *addr, size_t max_size) {
-    signed char *ptr = (signed char*)addr;
-    std::string res;
-    if (!ptr) {
-        return res;
+bool PtraceInvoker::traceeReadString(pid_t pid, void *addr, std::string &res, size_t max_size) {
+    static const uintptr_t pageSize = (uintptr_t)sysconf(_SC_PAGESIZE);
+
+    res.clear();
+    if (!addr) {
+        return false;
     }
+
+    auto ptr = (uintptr_t)addr;
     while (res.size() < max_size) {
-        long word = ptrace(PTRACE_PEEKDATA, pid, ptr, NULL);
-        if (word == -1) {
-            break;
+        // never cross a page boundary, so a chunk is either readable as a whole or not at all;
+        // most paths are short, so the first chunk is kept small
+        size_t chunk = std::min<size_t>(pageSize - ptr % pageSize, max_size - res.size());
+        if (res.empty()) {
+            chunk = std::min<size_t>(chunk, 256);
         }
-        ptr += sizeof(long);
-        signed char *c = (signed char*)&word;
-        for (size_t n = 0; n < sizeof(word); ++c, ++n) {
-            if (*c >= 32) {
-                res.push_back(*c);
-            } else {
-                return res;
+        size_t offset = res.size();
+        res.resize(offset + chunk);
+
+        ssize_t got = -1;
+        if (useVmReadv) {
+            iovec local = { &res[offset], chunk };
+            iovec remote = { (void*)ptr, chunk };
+            got = process_vm_readv(pid, &local, 1, &remote, 1, 0);
+            ++readCalls;
+            if (got < 0 && errno == ENOSYS) {
+                useVmReadv = false;
             }
         }
+        if (got <= 0) {
+            // PEEKDATA also reads pages the tracee has no read permission for
+            got = traceePeek(pid, ptr, &res[offset], chunk);
+        }
+        if (got <= 0) {
+            res.resize(offset);
+            break;
+        }
+        readBytes += got;
+
+        auto nul = (const char*)memchr(&res[offset], '\0', (size_t)got);
+        if (nul) {
+            res.resize(nul - res.data());
+            return true;
+        }
+
+        res.resize(offset + got);
+        ptr += got;
+        if ((size_t)got < chunk) {
+            break;
+        }
     }
-    return res;
+    return res.size() >= max_size;
+}
+
+ssize_t PtraceInvoker::traceePeek(pid_t pid, uintptr_t addr, char *buf, size_t size) {
+    size_t done = 0;
+    while (done < size) {
+        errno = 0;
+        long word = ptrace(PTRACE_PEEKDATA, pid, addr + done, NULL);
+        ++readCalls;
+        if (word == -1 && errno != 0) {
+            break;
+        }
+        size_t n = std::min(sizeof(word), size - done);
+        memcpy(buf + done, &word, n);
+        done += n;
+        if (memchr(&word, '\0', n)) {
+            break;
+        }
+    }
+    return (ssize_t)done;
 }
 
 const InvokerResult &PtraceInvoker::getResult() const {
@@ -392,45 +1762,178 @@ const InvokerResult &PtraceInvoker::getResult() const {
 }
 
 double PtraceInvoker::getTime() {
-    timeval tv;
-    gettimeofday(&tv, NULL);
-    return tvToSeconds(tv);
+    // wall time must not jump with the system clock
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1e-9 * ts.tv_nsec;
 }
 
 double PtraceInvoker::tvToSeconds(timeval tv) {
     return 1.0 * tv.tv_sec + 1e-6 * tv.tv_usec;
 }
 
-bool PtraceInvoker::onTrap(pid_t pid) {
-    if (!didExec) {
-        // tracee did execve(), transition into secure state
-        didExec = true;
-        return true;
+bool PtraceInvoker::onTrap(pid_t pid, int status) {
+    int event = status >> 16;
+    switch (event) {
+        case PTRACE_EVENT_SECCOMP:
+            return onSeccompTrap(pid);
+
+        case PTRACE_EVENT_CLONE:
+        case PTRACE_EVENT_FORK:
+        case PTRACE_EVENT_VFORK: {
+            unsigned long tid = 0;
+            ptrace(PTRACE_GETEVENTMSG, pid, NULL, &tid);
+            if (threads.find((pid_t)tid)) {
+                // its first stop came first
+                return true;
+            }
+
+            pid_t tgid = (pid_t)tid;
+            if (event == PTRACE_EVENT_CLONE) {
+                // clone() without CLONE_THREAD is reported the same way, signal 0 only checks membership
+                pid_t parent = threads.find(pid)->tgid;
+                if (syscall(SYS_tgkill, parent, (pid_t)tid, 0) == 0) {
+                    tgid = parent;
+                }
+            }
+            return addThread((pid_t)tid, tgid);
+        }
+
+        case PTRACE_EVENT_EXEC: {
+            unsigned long former = 0;
+            ptrace(PTRACE_GETEVENTMSG, pid, NULL, &former);
+            TracedThread *thread = threads.find((pid_t)former);
+            if ((pid_t)former != pid && thread) {
+                // a non-leader thread took over the thread ID of the leader, which is gone silently
+                TracedThread moved = *thread;
+                removeThread((pid_t)former);
+                moved.tid = pid;
+                threads.insert(pid) = moved;
+            }
+            // every other thread of the process has passed its PTRACE_EVENT_EXIT by now
+            processes[threads.find(pid)->tgid].running = 1;
+            if (!useSeccomp) {
+                // the syscall exit stop of execve() is still to come
+                threads.find(pid)->inSyscall = true;
+            }
+            if (pid == state.pid && !state.didExec) {
+                // tracee did execve(), transition into secure state
+                state.didExec = true;
+                result.spawnLatency = getTime() - spawnTime;
+            }
+            return true;
+        }
+
+        case PTRACE_EVENT_EXIT:
+            recordThreadUsage(pid);
+            return true;
+
+        default:
+            break;
     }
-    inSyscall = !inSyscall;
 
-    if (!inSyscall) {
-        if (denySyscall != 0) {
+    return onSyscallTrap(pid);
+}
+
+bool PtraceInvoker::onSyscallTrap(pid_t pid) {
+    TracedThread *thread = threads.find(pid);
+    thread->inSyscall = !thread->inSyscall;
+
+    if (!thread->inSyscall) {
+        if (thread->denySyscall != 0) {
             // return an error as syscall result
-            ptrace(PTRACE_POKEUSER, pid, regSyscallResult(), (void*)denySyscall);
-            denySyscall = 0;
+            writeResult(pid, thread->denySyscall);
+            thread->denySyscall = 0;
         }
         return true;
     }
 
-    long syscall = ptrace(PTRACE_PEEKUSER, pid, regSyscall(), NULL);
+    SyscallInfo info;
+    if (!fetchSyscall(pid, info)) {
+        // killed while stopped, the exit is reported next
+        return true;
+    }
+    long denySyscall = 0;
+    double began = stats ? getTime() : 0;
+    bool allowed = checkSyscall(pid, info, denySyscall);
+    if (stats) {
+        countSyscall(info, allowed, denySyscall, began);
+    }
+    if (denySyscall != 0) {
+        writeSyscall(pid, -1); // drop this syscall
+        thread->denySyscall = denySyscall;
+    }
+    return allowed;
+}
+
+bool PtraceInvoker::onSeccompTrap(pid_t pid) {
+    if (!state.didExec) {
+        // this is our own execve()
+        return true;
+    }
 
-    if (syscall < 0 || syscall >= SYSCALL_MAX) {
+    SyscallInfo info;
+    if (!fetchSyscall(pid, info)) {
         return true;
     }
+    long denySyscall = 0;
+    double began = stats ? getTime() : 0;
+    bool allowed = checkSyscall(pid, info, denySyscall);
+    if (stats) {
+        countSyscall(info, allowed, denySyscall, began);
+    }
+    if (denySyscall != 0) {
+        // skip the syscall, its result is taken from the result register as is
+        writeSyscall(pid, -1);
+        writeResult(pid, denySyscall);
+    }
+    return allowed;
+}
+
+bool PtraceInvoker::checkSyscall(pid_t pid, const SyscallInfo &info, long &denySyscall) {
+    const ArchActions *arch = &nativeActions;
+    if (info.arch != nativeActions.arch.auditArch) {
+        if (compatActions.arch.auditArch == 0 || info.arch != compatActions.arch.auditArch) {
+            // an ABI we know nothing about
+            if (config.log) {
+                std::cerr << "Syscall of unknown architecture 0x" << std::hex << info.arch << std::dec << std::endl;
+            }
+            denySyscall = -ENOSYS;
+            return false;
+        }
+        arch = &compatActions;
+        if (config.log) {
+            const char *name = arch->arch.table->name(info.syscall);
+            std::cerr << arch->arch.name << " syscall " << (name ? name : std::to_string(info.syscall)) << std::endl;
+        }
+    }
+
+    long syscall = info.syscall;
+    if (syscall < 0 || syscall >= SYSCALL_MAX) {
+        // x32 syscalls and numbers no table knows, the seccomp filter kills them as well
+        if (config.log) {
+            std::cerr << "Syscall number " << syscall << " out of range" << std::endl;
+        }
+        denySyscall = -ENOSYS;
+        return false;
+    }
 
-    SyscallAction action = syscallActions[syscall];
+    SyscallAction action = (size_t)syscall < arch->count ? arch->actions[syscall] : SyscallAction::Unspecified;
     if (action == SyscallAction::Unspecified) {
         action = config.profile.defaultSyscallAction;
     }
 
     if (action == SyscallAction::Allow) {
-        // just allow
+        // only seen here without seccomp, or for the other ABI
+        int error = arch->checks.error(syscall, info.args);
+        if (error != 0) {
+            denySyscall = -error;
+        }
+        return true;
+    }
+
+    if (action == SyscallAction::CheckPath && useLandlock) {
+        // just allow, Landlock has the kernel check the path
         return true;
     }
 
@@ -441,48 +1944,74 @@ bool PtraceInvoker::onTrap(pid_t pid) {
     }
 
     if (action == SyscallAction::CheckPath || action == SyscallAction::CheckPathSecurity) {
-        void *ptr = (void*)ptrace(PTRACE_PEEKUSER, pid, (syscall == syscall_openat) ? regArg1() : regArg0(), NULL);
-        std::string str_path = traceeReadString(pid, ptr);
+        pathChecked = true;
+        double began = stats ? getTime() : 0;
+        bool at = std::find(arch->syscallsAt.begin(), arch->syscallsAt.end(), syscall) != arch->syscallsAt.end();
+        void *ptr = (void*)info.args[at ? 1 : 0];
+        std::string str_path;
+        bool readable = traceeReadString(pid, ptr, str_path);
+        if (stats) {
+            stats->readTime += getTime() - began;
+        }
+        if (!readable) {
+            // the kernel would not be able to read it either
+            denySyscall = -EFAULT;
+            return true;
+        }
+
+        if (str_path.empty()) {
+            // AT_EMPTY_PATH, e.g. fstat() of glibc, works on a descriptor the tracee already has,
+            // without it the kernel refuses an empty path
+            auto empty = std::find_if(arch->syscallsEmptyPath.begin(), arch->syscallsEmptyPath.end(),
+                                      [syscall](const std::pair<long, int> &entry) {
+                                          return entry.first == syscall;
+                                      });
+            if (empty != arch->syscallsEmptyPath.end() && (info.args[empty->second] & AT_EMPTY_PATH)) {
+                return true;
+            }
+            denySyscall = -ENOENT;
+            return true;
+        }
         boost::filesystem::path path = str_path;
 
-        if (path.is_relative())
-            path = cwd / path;
+        if (path.is_relative()) {
+            int dirfd = (int)info.args[0];
+            if (at && dirfd != AT_FDCWD) {
+                boost::filesystem::path directory = traceeDescriptorPath(pid, dirfd);
+                if (directory.empty()) {
+                    // not a descriptor of the tracee, the kernel would fail the call just the same
+                    denySyscall = -EBADF;
+                    return true;
+                }
+                path = directory / path;
+            } else {
+                path = cwd / path;
+            }
+        }
         path = path.lexically_normal();
 
         if (config.log) {
             std::cerr << path << std::endl;
         }
 
-        auto access = checkPath(path);
-
-        if (access == PathAccess::Security) {
-            security = true;
+        began = stats ? getTime() : 0;
+        auto access = paths.check(path);
+        if (stats) {
+            stats->checkTime += getTime() - began;
         }
 
-        if (access == PathAccess::ReadWrite) {
-            return true;
+        bool write = false;
+        if (syscall == arch->syscallOpen || syscall == arch->syscallOpenat) {
+            // check if we don't request write permissions
+            long flags = (long)info.args[(syscall == arch->syscallOpenat) ? 2 : 1];
+            write = (flags & O_WRONLY) || (flags & O_RDWR);
         }
 
-        if (access == PathAccess::ReadOnly || access == PathAccess::ReadOnlySecurity) {
-            if (syscall == syscall_open || syscall == syscall_openat) {
-                // check if we don't request write permissions
-                long arg = (syscall == syscall_openat) ? regArg2() : regArg1();
-                long flags = ptrace(PTRACE_PEEKUSER, pid, arg, NULL);
-
-                if (!(flags & O_WRONLY) && !(flags & O_RDWR)) {
-                    return true;
-                }
-
-                // permission error
-                if (access == PathAccess::ReadOnlySecurity) {
-                    security = true;
-                }
-            } else {
-                return true;
-            }
+        int error = paths.verdict(access, write, security);
+        if (error == 0) {
+            return true;
         }
-
-        denySyscall = -EACCES;
+        denySyscall = -error;
     }
 
     // emulate syscall, return error
@@ -492,99 +2021,124 @@ bool PtraceInvoker::onTrap(pid_t pid) {
     if (denySyscall == 0) {
         denySyscall = -EPERM;
     }
-    ptrace(PTRACE_POKEUSER, pid, regSyscall(), (void*)-1); // drop this syscall
     return !security;
 }
 
-PathAccess PtraceInvoker::checkPath(boost::filesystem::path path) {
-    PathAccess access = config.profile.defaultPathAccess;
+void PtraceInvoker::countSyscall(const SyscallInfo &info, bool allowed, long denySyscall, double began) {
+    bool checked = pathChecked;
+    pathChecked = false;
 
-    if (path.parent_path() == cwd) {
-        auto filename = path.filename();
-        for (const std::string &file : config.writeableFiles) {
-            if (filename == file) {
-                return PathAccess::ReadWrite;
-            }
-        }
-        return PathAccess::ReadOnly;
+    SyscallStats::Arch *arch = nullptr;
+    if (info.arch == nativeActions.arch.auditArch) {
+        arch = &stats->archs[0];
+    } else if (compatActions.arch.auditArch != 0 && info.arch == compatActions.arch.auditArch) {
+        arch = &stats->archs[1];
     }
-
-    for (const PathPermission &permission : config.profile.paths) {
-        if (permission.path.empty()) continue;
-        boost::filesystem::path cur(permission.path);
-        if (permission.path.back() == '/') {
-            // directory
-            if (cur.filename() == ".") {
-                cur.remove_filename();
-            }
-            auto cur_len = std::distance(cur.begin(), cur.end());
-            auto path_len = std::distance(path.begin(), path.end());
-            if (cur_len > path_len) {
-                continue;
-            }
-            if (std::equal(cur.begin(), cur.end(), path.begin())) {
-                access = permission.access;
-            }
-        } else {
-            // file
-            if (cur == path) {
-                access = permission.access;
-            }
-        }
+    if (!arch || info.syscall < 0 || info.syscall >= SYSCALL_MAX) {
+        return;
     }
 
-    return access;
+    SyscallStats::Counters &counters = arch->syscalls[info.syscall];
+    ++counters.entered;
+    if (allowed && denySyscall == 0) {
+        ++counters.allowed;
+    } else {
+        ++counters.denied;
+    }
+    if (checked) {
+        ++counters.checked;
+    }
+    counters.time += getTime() - began;
 }
 
-void PtraceInvoker::buildSyscallTable() {
-    syscall_open = syscallFromName("open");
-    syscall_openat = syscallFromName("openat");
+void PtraceInvoker::countStop(pid_t pid, double stopped) {
+    double now = getTime();
+    ++stats->stops;
+    stats->tracerTime += now - stopped;
 
-    for (const SyscallPolicy &policy : config.profile.syscalls) {
-        long syscall = syscallFromName(policy.syscall);
-        if (syscall >= 0 && syscall < SYSCALL_MAX) {
-            syscallActions[syscall] = policy.action;
-        }
+    TracedThread *thread = threads.find(pid);
+    if (!thread) {
+        return;
     }
+    if (thread->resumed > 0 && (stats->roundTrip < 0 || stopped - thread->resumed < stats->roundTrip)) {
+        stats->roundTrip = stopped - thread->resumed;
+    }
+    thread->resumed = now;
 }
 
-void PtraceInvoker::printResults() const {
-    if (result.error != 0) {
-        std::cerr << "error: '" << std::endl;
-        std::cerr << result.errorMessage << "'" << std::endl;
+void PtraceInvoker::buildSyscallTable(ArchActions &actions) {
+    const SyscallTable &table = *actions.arch.table;
+    actions.syscallOpen = table.find("open");
+    actions.syscallOpenat = table.find("openat");
+    actions.syscallsAt.clear();
+    for (const char *name : PathPolicy::atSyscalls) {
+        long syscall = table.find(name);
+        if (syscall >= 0) {
+            actions.syscallsAt.push_back(syscall);
+        }
     }
-    std::cerr << "exit_code: " << result.exitCode << std::endl;
-    std::cerr << "wall_clock: " << result.wallClock << std::endl;
-    std::cerr << "cpu_clock: " << result.cpuUsage << std::endl;
-    std::cerr << "memory_usage: " << result.memoryUsage << std::endl;
-
-    std::cerr << "verdicts: [";
-    if (result.timeLimitExceeded) {
-        std::cerr << "TL,";
+    actions.checks.find(table);
+    actions.syscallsEmptyPath.clear();
+    for (const auto &entry : PathPolicy::emptyPathSyscalls) {
+        long syscall = table.find(entry.first);
+        if (syscall >= 0) {
+            actions.syscallsEmptyPath.emplace_back(syscall, entry.second);
+        }
     }
-
-    if (result.memoryLimitExceeded) {
-        std::cerr << "ML,";
+    actions.syscallsFork.clear();
+    for (const char *name : { "fork", "clone", "clone3" }) {
+        long syscall = table.find(name);
+        if (syscall >= 0) {
+            actions.syscallsFork.push_back(syscall);
+        }
+    }
+    actions.syscallsWait.clear();
+    for (const char *name : { "wait4", "waitid" }) {
+        long syscall = table.find(name);
+        if (syscall >= 0) {
+            actions.syscallsWait.push_back(syscall);
+        }
     }
 
-    if (result.wallLimitExceeded) {
-        std::cerr << "RL,";
+    const ProfileActions *precomputed = config.profile.actionsFor(actions.arch.name);
+    if (precomputed) {
+        // generated along with the profile, nothing to build
+        actions.actions = precomputed->actions;
+        actions.count = precomputed->count;
+        return;
     }
 
-    if (result.securityViolation) {
-        std::cerr << "SV,";
+    actions.own.assign(SYSCALL_MAX, SyscallAction::Unspecified);
+    for (const SyscallPolicy &policy : config.profile.syscalls) {
+        long syscall = table.find(policy.syscall);
+        if (syscall >= 0 && syscall < SYSCALL_MAX) {
+            actions.own[syscall] = policy.action;
+        }
     }
+    actions.actions = actions.own.data();
+    actions.count = actions.own.size();
+}
 
-    std::cerr << "]" << std::endl;
+void PtraceInvoker::buildSeccompFilter() {
+    seccompFilter.build(nativeActions.arch.auditArch, *nativeActions.arch.table, nativeActions.actions,
+                        nativeActions.count, SYSCALL_MAX, config.profile.defaultSyscallAction);
+
+    if (landlockReady) {
+        // CheckPathSecurity still stops, a denied path is a violation rather than an error
+        std::vector<SyscallAction> actions(nativeActions.actions, nativeActions.actions + nativeActions.count);
+        std::replace(actions.begin(), actions.end(), SyscallAction::CheckPath, SyscallAction::Allow);
+        SyscallAction defaultAction = config.profile.defaultSyscallAction;
+        if (defaultAction == SyscallAction::CheckPath) {
+            defaultAction = SyscallAction::Allow;
+        }
+        landlockSeccompFilter.build(nativeActions.arch.auditArch, *nativeActions.arch.table, actions.data(),
+                                    actions.size(), SYSCALL_MAX, defaultAction);
+    }
 }
 
-bool PtraceInvoker::doChdir() {
+int PtraceInvoker::doChdir() const {
     if (config.workingDirectory.empty()) {
-        return true;
+        return 0;
     }
-    if (chdir(config.workingDirectory.c_str()) == -1) {
-        result.error = errno;
-        return false;
-    }
-    return true;
+    return (int)-rawSyscall(SYS_chdir, (long)config.workingDirectory.c_str());
 }
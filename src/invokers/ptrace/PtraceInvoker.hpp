@@ -7,50 +7,277 @@
 #include <array>
 #include <boost/filesystem.hpp>
 #include <Invoker.hpp>
+#include <SeccompFilter.hpp>
+#include <LandlockRuleset.hpp>
+#include <Cgroup.hpp>
+#include <PathPolicy.hpp>
+#include <SyscallTable.hpp>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <sched.h>
+#include "ThreadTable.hpp"
+
+// Syscall ABI a tracee may use, identified by its AUDIT_ARCH_* value
+struct SyscallArch {
+    uint32_t auditArch;
+    const char *name;
+    const SyscallTable *table;
+};
+
+// Syscall a tracee is stopped at, as reported on a syscall entry or seccomp stop
+struct SyscallInfo {
+    uint32_t arch = 0;
+    long syscall = -1;
+    uint64_t args[6] = {};
+};
 
 class PtraceInvoker : public Invoker {
 private:
-    static const int SYSCALL_MAX = 4096;
-    std::array<SyscallAction, SYSCALL_MAX> syscallActions;
+    static const int SYSCALL_MAX = SyscallStats::SYSCALL_MAX;
+    // control descriptor of a fork server, the status descriptor is the next one, as in AFL
+    static const int FORK_SERVER_FD = 198;
+
+    // resolved syscall actions of the profile for one ABI
+    struct ArchActions {
+        SyscallArch arch;
+        const SyscallAction *actions = nullptr;
+        size_t count = 0;
+        std::vector<SyscallAction> own;
+        long syscallOpen = -1;
+        long syscallOpenat = -1;
+        SeccompFilter::ArgumentChecks checks;
+        // path syscalls taking a directory descriptor before the path
+        std::vector<long> syscallsAt;
+        // and the index of the flags of those that take AT_EMPTY_PATH
+        std::vector<std::pair<long, int>> syscallsEmptyPath;
+        // what a fork server needs besides reading and writing the handshake
+        std::vector<long> syscallsFork;
+        std::vector<long> syscallsWait;
+    };
+
+    ArchActions nativeActions;
+    // 32-bit syscalls of a 64-bit tracee, arch.auditArch is 0 if there are none
+    ArchActions compatActions;
+
+    struct TraceeState {
+        pid_t pid = -1;
+        bool didExec = false;
+    };
+
+    TraceeState state;
+    struct TracedProcess {
+        size_t threads = 0;
+        // threads that have not reached PTRACE_EVENT_EXIT yet
+        size_t running = 0;
+    };
+
+    // every task of the process tree, and the processes by their thread group ID
+    ThreadTable threads;
+    std::unordered_map<pid_t, TracedProcess> processes;
+    // CPU time and peak memory of the processes of the tree that have exited
+    double exitedCpuUsage = 0.0;
+    long exitedMemoryUsage = 0;
+    // number of CPUs the tree may run on at once, bounds how fast it can use up the time limit
+    int cpuParallelism = 1;
+    double lastCpuCheck = 0.0;
+    std::function<void(pid_t tid, bool added)> threadListener;
+    double startTime = 0.0;
+
+    // state shared with the tracee between clone() and execve()
+    std::vector<char> spawnStack;
+    std::vector<char*> spawnArgs;
+    std::vector<char*> spawnEnv;
+    cpu_set_t spawnAffinity;
+    // futex word the tracee waits on until it has been seized
+    volatile int spawnGo = 0;
+    // errno of a failed execve() or setup step in the tracee
+    volatile int spawnError = 0;
+    double spawnTime = 0.0;
+    int pidfd = -1;
 
-    bool inSyscall;
-    bool didExec;
-    long denySyscall;
+    // A tracee cloned, seized and put in its cgroup ahead of its run, see refillPool().
+    // It waits on its end of a socketpair for the descriptors of the program, everything
+    // else it takes from our memory like any other tracee.
+    struct PooledTracee {
+        PtraceInvoker *invoker = nullptr;
+        pid_t pid = -1;
+        int pidfd = -1;
+        // ours and the tracee's end of the socketpair
+        int socket = -1;
+        int peer = -1;
+        std::vector<char> stack;
+        Cgroup cgroup;
+        long memoryLimit = -1;
+    };
 
-    long syscall_open;
-    long syscall_openat;
+    std::deque<std::unique_ptr<PooledTracee>> pool;
+    // the last one taken from the pool, its stack is in use until execve()
+    std::unique_ptr<PooledTracee> dispatched;
+
+    // With InvokerConfig::forkServer the program is spawned once and does the handshake of
+    // AFL on the descriptors it inherits: it writes 4 bytes to FORK_SERVER_FD + 1 once it has
+    // started up, then reads 4 bytes from FORK_SERVER_FD for every run and fork()s. The child
+    // runs the test, the server may report its PID and status as AFL does, which we ignore.
+    //
+    // The child becomes the root of the run, with the cgroup and the limits of the run, so
+    // that only what it uses is accounted. Its stdin and stdout are those of the server,
+    // memfds that we fill with the input of every run and copy to its output afterwards.
+    // The server is held to the profile, except that it may reap its children and fork
+    // once for every run we ask for.
+    struct ForkServer {
+        pid_t pid = -1;
+        // our end of the socketpair on both handshake descriptors, and the program's end
+        int socket = -1;
+        int peer = -1;
+        // the memfds and the descriptions of them the program gets, read or write only
+        int input = -1;
+        int output = -1;
+        int errors = -1;
+        int inputPeer = -1;
+        int outputPeer = -1;
+        int errorsPeer = -1;
+        // a run is waiting for its fork, and the child once it has been forked
+        bool forkPending = false;
+        pid_t child = -1;
+        TracedThread thread;
+        // where the server was started, what the runs use is charged to cgroups of their own
+        Cgroup cgroup;
+    };
+
+    ForkServer server;
+
+    bool prepared = false;
+    bool useSeccomp;
+    SeccompFilter seccompFilter;
+    // with config.landlock: whether the profile can be enforced by Landlock at all,
+    // and whether it is for this run, which also depends on the working directory
+    bool landlockReady = false;
+    // the program shares memory with itself, so its paths need Landlock regardless
+    bool racyPathChecks = false;
+    bool useLandlock = false;
+    LandlockRuleset landlock;
+    // lets the path syscalls through, for runs with Landlock
+    SeccompFilter landlockSeccompFilter;
+    Cgroup cgroup;
+    PathPolicy paths;
+
+    bool useVmReadv = true;
+    size_t readCalls = 0;
+    size_t readBytes = 0;
+
+    // nullptr unless config.stats is set
+    std::shared_ptr<SyscallStats> stats;
+    bool pathChecked = false;
 
     boost::filesystem::path cwd;
 
     const InvokerConfig &config;
     InvokerResult result;
 
-    void tracee(int downPipe[2], int upPipe[2]);
-    void tracer(pid_t pid, pid_t timer, int downPipe[2], int upPipe[2]);
-    PathAccess checkPath(boost::filesystem::path path);
-    bool onTrap(pid_t pid);
-    void timeout();
+    bool prepareSpawn();
+    void resetStats();
+    static int spawnTracee(void *invoker);
+    void tracee();
+    void execTracee(int stdinFd, int stdoutFd, int stderrFd);
+    bool spawnPooled(PooledTracee &pooled);
+    static int spawnPooledTracee(void *pooled);
+    void pooledTracee(const PooledTracee &pooled);
+    bool sendJob(int socket) const;
+    // true if `pid` is a tracee of the pool, which is taken care of
+    bool onPooledWait(pid_t pid, int status);
+    void releasePooled(PooledTracee &pooled);
+    long seizeOptions() const;
+    // spawns the tracee, from the pool if it has one
+    bool spawn();
+    bool openServerFiles();
+    // fills the input of the server with the one of the run
+    bool loadServerInput();
+    // rewinds the input and empties the outputs for the next run
+    bool rewindServerFiles();
+    void collectServerOutput();
+    // spawns the server and runs it until it has started up, false if the run ended before
+    bool spawnServer();
+    bool awaitServer();
+    bool forkFromServer();
+    // handles one wait status of the server, false if it is gone
+    bool onServerWait(int status);
+    bool checkServerSyscall(pid_t pid, const SyscallInfo &info, long &denySyscall);
+    void releaseServer();
+    // forgets the process tree of the last run, `pid` is the root of the next one
+    void trackRoot(pid_t pid);
+    // `pooled` is already seized and in its cgroup, it is waiting for sendJob()
+    bool tracer(pid_t pid, int childPidfd, PooledTracee *pooled = nullptr);
+    bool onTrap(pid_t pid, int status);
+    bool onSyscallTrap(pid_t pid);
+    void countSyscall(const SyscallInfo &info, bool allowed, long denySyscall, double began);
+    void countStop(pid_t pid, double stopped);
+    bool onSeccompTrap(pid_t pid);
+    bool checkSyscall(pid_t pid, const SyscallInfo &info, long &denySyscall);
+    bool addThread(pid_t tid, pid_t tgid);
+    void removeThread(pid_t tid);
+    void reapThread(pid_t tid);
+    void recordThreadUsage(pid_t tid);
+    double treeCpuTime();
+    static double processCpuTime(pid_t pid);
+    bool setupCgroup();
+    bool limitCgroup(Cgroup &target) const;
     double getTime();
     double tvToSeconds(timeval tv);
-    bool dupFile(int prev, int next);
-    bool doChdir();
-    void setLimit(__rlimit_resource limit, rlim_t soft, rlim_t hard);
-    std::string traceeReadString(pid_t pid, void *addr, size_t max_size = 4096);
-    void buildSyscallTable();
+    // these run in the tracee before execve(), they return 0 or the errno and leave errno alone
+    static int dupFile(int prev, int next);
+    int doChdir() const;
+    static void setLimit(__rlimit_resource limit, rlim_t soft, rlim_t hard);
+    // false if the memory can't be read, longer strings are cut at max_size
+    bool traceeReadString(pid_t pid, void *addr, std::string &out, size_t max_size = 4096);
+    // absolute path of an open descriptor of the tracee, empty if it has none
+    boost::filesystem::path traceeDescriptorPath(pid_t pid, int fd);
+    ssize_t traceePeek(pid_t pid, uintptr_t addr, char *buf, size_t size);
+    void buildSyscallTable(ArchActions &actions);
+    void buildSeccompFilter();
 
 protected:
-    virtual int regSyscall() const = 0;
-    virtual int regSyscallResult() const = 0;
-    virtual int regArg0() const = 0;
-    virtual int regArg1() const = 0;
-    virtual int regArg2() const = 0;
-    virtual int syscallFromName(const std::string &name) const = 0;
+    // reads the syscall of a tracee stopped at its entry, false if the tracee is gone
+    virtual bool fetchSyscall(pid_t pid, SyscallInfo &info) = 0;
+    // overwrite the syscall number or the result of a stopped tracee
+    virtual void writeSyscall(pid_t pid, long syscall) = 0;
+    virtual void writeResult(pid_t pid, long value) = 0;
 
 public:
-    explicit PtraceInvoker(const InvokerConfig &config);
+    PtraceInvoker(const InvokerConfig &config, const SyscallArch &native, const SyscallArch &compat);
+    ~PtraceInvoker() override;
     void run() override;
-    void printResults() const override;
+
+    // Clone tracees up to InvokerConfig::poolSize for the next runs to start from, run()
+    // does it while its program runs. They are killed along with the invoker.
+    void refillPool();
+
+    // Stepwise interface used to drive many tracees from one event loop:
+    // start() spawns the tracee, onWait() handles a single wait status of one of
+    // its threads and returns true once the run is over, then finish() computes the verdicts.
+    bool start();
+    bool onWait(pid_t pid, int status, const rusage &ru);
+    void onWallLimit();
+    // Seconds until onCpuCheck() should run again, or -1 without a time limit.
+    // CPU time is summed over the whole tree from the CPU clocks of its processes.
+    double cpuCheckDelay() const;
+    // returns true once the time limit is exceeded and the run is over
+    bool onCpuCheck();
+    void finish();
+    // kills the tracee and reaps all of its threads
+    void terminate();
+    pid_t getPid() const;
+    // told about every task of the tree that starts or stops being traced, except the root
+    void setThreadListener(const std::function<void(pid_t tid, bool added)> &listener);
+    // a numeric field of /proc/<pid>/status, such as "Tgid:" or "PPid:", or -1
+    static long readProcStatus(pid_t pid, const std::string &key);
+
     const InvokerResult& getResult() const override;
+
+    // one-shot timerfd expiring after `seconds`
+    static void armTimer(int fd, double seconds);
 };
 
 
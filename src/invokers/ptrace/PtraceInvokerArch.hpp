@@ -0,0 +1,69 @@
+#ifndef INVOKE_PTRACEINVOKERARCH_HPP
+#define INVOKE_PTRACEINVOKERARCH_HPP
+
+
+#include <cerrno>
+#include <cstring>
+#include <sys/ptrace.h>
+#include "PtraceInvoker.hpp"
+
+// PtraceInvoker for one architecture. Registers maps the syscall state onto the
+// registers of that architecture at compile time and provides
+//   static const SyscallArch native, compat;
+//   static const long syscallOffset, resultOffset; // offsets into struct user
+//   static bool readRegisters(pid_t pid, SyscallInfo &info);
+template<typename Registers>
+class PtraceInvokerArch : public PtraceInvoker {
+private:
+    // cleared on kernels older than 5.3
+    bool useSyscallInfo = true;
+
+protected:
+    bool fetchSyscall(pid_t pid, SyscallInfo &info) override;
+    void writeSyscall(pid_t pid, long syscall) override;
+    void writeResult(pid_t pid, long value) override;
+
+public:
+    explicit PtraceInvokerArch(const InvokerConfig &config)
+            : PtraceInvoker(config, Registers::native, Registers::compat) {
+    }
+};
+
+template<typename Registers>
+bool PtraceInvokerArch<Registers>::fetchSyscall(pid_t pid, SyscallInfo &info) {
+    if (useSyscallInfo) {
+        // the number, the arguments and the ABI they belong to in a single call
+        __ptrace_syscall_info data;
+        if (ptrace(PTRACE_GET_SYSCALL_INFO, pid, (void*)sizeof(data), &data) > 0) {
+            if (data.op == PTRACE_SYSCALL_INFO_SECCOMP) {
+                info.syscall = (long)data.seccomp.nr;
+                memcpy(info.args, data.seccomp.args, sizeof(info.args));
+            } else if (data.op == PTRACE_SYSCALL_INFO_ENTRY) {
+                info.syscall = (long)data.entry.nr;
+                memcpy(info.args, data.entry.args, sizeof(info.args));
+            } else {
+                return false;
+            }
+            info.arch = data.arch;
+            return true;
+        }
+        if (errno != EIO) {
+            return false;
+        }
+        useSyscallInfo = false;
+    }
+    return Registers::readRegisters(pid, info);
+}
+
+template<typename Registers>
+void PtraceInvokerArch<Registers>::writeSyscall(pid_t pid, long syscall) {
+    ptrace(PTRACE_POKEUSER, pid, (void*)Registers::syscallOffset, (void*)syscall);
+}
+
+template<typename Registers>
+void PtraceInvokerArch<Registers>::writeResult(pid_t pid, long value) {
+    ptrace(PTRACE_POKEUSER, pid, (void*)Registers::resultOffset, (void*)value);
+}
+
+
+#endif //INVOKE_PTRACEINVOKERARCH_HPP
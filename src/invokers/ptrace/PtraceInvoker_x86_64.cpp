@@ -1,35 +1,45 @@
 #include "PtraceInvoker_x86_64.hpp"
 #include "tables/linux_x86_64.hpp"
+#include "tables/linux_i386.hpp"
 
-#include <sys/reg.h>
+#include <cstddef>
+#include <sys/user.h>
+#include <linux/audit.h>
 
-int PtraceInvoker_x86_64::regSyscall() const {
-    return sizeof(long) * ORIG_RAX;
-}
+// code segment selector of 32-bit user code
+static const unsigned long USER32_CS = 0x23;
 
-int PtraceInvoker_x86_64::regSyscallResult() const {
-    return sizeof(long) * RAX;
-}
+const SyscallArch Registers_x86_64::native = { AUDIT_ARCH_X86_64, "x86_64", &linux_x86_64_table };
+const SyscallArch Registers_x86_64::compat = { AUDIT_ARCH_I386, "i386", &linux_i386_table };
+const long Registers_x86_64::syscallOffset = offsetof(user, regs.orig_rax);
+const long Registers_x86_64::resultOffset = offsetof(user, regs.rax);
 
-int PtraceInvoker_x86_64::regArg0() const {
-    return sizeof(long) * RDI;
-}
-
-int PtraceInvoker_x86_64::regArg1() const {
-    return sizeof(long) * RSI;
-}
-
-int PtraceInvoker_x86_64::regArg2() const{
-    return sizeof(long) * RDX;
-}
+bool Registers_x86_64::readRegisters(pid_t pid, SyscallInfo &info) {
+    user_regs_struct regs;
+    if (ptrace(PTRACE_GETREGS, pid, NULL, &regs) == -1) {
+        return false;
+    }
 
-int PtraceInvoker_x86_64::syscallFromName(const std::string &name) const {
-    auto it = linux_x86_64_table.find(name);
-    if (it == linux_x86_64_table.end()) {
-        return -1;
+    info.syscall = (long)regs.orig_rax;
+    // without PTRACE_GET_SYSCALL_INFO an int 0x80 from 64-bit code passes for a native syscall
+    if (regs.cs == USER32_CS) {
+        info.arch = AUDIT_ARCH_I386;
+        info.args[0] = (uint32_t)regs.rbx;
+        info.args[1] = (uint32_t)regs.rcx;
+        info.args[2] = (uint32_t)regs.rdx;
+        info.args[3] = (uint32_t)regs.rsi;
+        info.args[4] = (uint32_t)regs.rdi;
+        info.args[5] = (uint32_t)regs.rbp;
+    } else {
+        info.arch = AUDIT_ARCH_X86_64;
+        info.args[0] = regs.rdi;
+        info.args[1] = regs.rsi;
+        info.args[2] = regs.rdx;
+        info.args[3] = regs.r10;
+        info.args[4] = regs.r8;
+        info.args[5] = regs.r9;
     }
-    return it->second;
+    return true;
 }
 
-PtraceInvoker_x86_64::PtraceInvoker_x86_64(const InvokerConfig &config) : PtraceInvoker(config) {
-}
+template class PtraceInvokerArch<Registers_x86_64>;
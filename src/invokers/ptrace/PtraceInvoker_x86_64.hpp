@@ -2,20 +2,21 @@
 #define INVOKE_PTRACEINVOKER_X86_64_HPP
 
 
-#include "PtraceInvoker.hpp"
-
-class PtraceInvoker_x86_64 : public PtraceInvoker {
-protected:
-    int regSyscall() const override;
-    int regSyscallResult() const override;
-    int regArg0() const override;
-    int regArg1() const override;
-    int regArg2() const override;
-    int syscallFromName(const std::string &name) const override;
-
-public:
-    explicit PtraceInvoker_x86_64(const InvokerConfig &config);
+#include "PtraceInvokerArch.hpp"
+
+struct Registers_x86_64 {
+    static const SyscallArch native;
+    // int 0x80 and 32-bit code use the i386 syscall numbers
+    static const SyscallArch compat;
+    static const long syscallOffset;
+    static const long resultOffset;
+
+    static bool readRegisters(pid_t pid, SyscallInfo &info);
 };
 
+extern template class PtraceInvokerArch<Registers_x86_64>;
+
+typedef PtraceInvokerArch<Registers_x86_64> PtraceInvoker_x86_64;
+
 
 #endif //INVOKE_PTRACEINVOKER_X86_64_HPP
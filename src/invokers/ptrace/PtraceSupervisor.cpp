@@ -0,0 +1,326 @@
+#include "PtraceSupervisor.hpp"
+
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/syscall.h>
+#include <sys/timerfd.h>
+#include <sys/wait.h>
+
+namespace {
+
+enum EventKind {
+    EVENT_SIGCHLD = 0,
+    EVENT_PIDFD = 1,
+    EVENT_TIMER = 2,
+    EVENT_CPU = 3,
+    EVENT_SOURCE = 4,
+};
+
+uint64_t makeTag(size_t slot, EventKind kind) {
+    return ((uint64_t)slot << 3) | kind;
+}
+
+}
+
+PtraceSupervisor::PtraceSupervisor(const std::string &arch, size_t slots) :
+    arch(arch), slots(slots == 0 ? 1 : slots) {
+    epollfd = epoll_create1(EPOLL_CLOEXEC);
+}
+
+PtraceSupervisor::~PtraceSupervisor() {
+    for (Slot &slot : slots) {
+        if (slot.busy) {
+            slot.invoker->terminate();
+        }
+        if (slot.pidfd != -1) {
+            close(slot.pidfd);
+        }
+        if (slot.timerfd != -1) {
+            close(slot.timerfd);
+        }
+        if (slot.cpufd != -1) {
+            close(slot.cpufd);
+        }
+    }
+    if (sigchldfd != -1) {
+        close(sigchldfd);
+    }
+    if (epollfd != -1) {
+        close(epollfd);
+    }
+}
+
+void PtraceSupervisor::pin(const std::vector<CpuSlot> &layout) {
+    this->layout = layout;
+}
+
+void PtraceSupervisor::submit(size_t id, const InvokerConfig &config) {
+    Job job;
+    job.id = id;
+    job.config.reset(new InvokerConfig(config));
+    queue.push_back(std::move(job));
+}
+
+void PtraceSupervisor::cancel(size_t id) {
+    for (auto it = queue.begin(); it != queue.end(); ++it) {
+        if (it->id == id) {
+            queue.erase(it);
+            return;
+        }
+    }
+
+    for (size_t i = 0; i < slots.size(); ++i) {
+        if (slots[i].busy && slots[i].id == id && running) {
+            slots[i].invoker->terminate();
+            complete(i, *running);
+            return;
+        }
+    }
+}
+
+void PtraceSupervisor::addSource(int fd, const SourceHandler &handler, uint32_t events) {
+    bool added = sources.count(fd) > 0;
+    sources[fd] = handler;
+    if (added) {
+        epoll_event event = {};
+        event.events = events;
+        event.data.u64 = makeTag((size_t)fd, EVENT_SOURCE);
+        epoll_ctl(epollfd, EPOLL_CTL_MOD, fd, &event);
+    } else {
+        watch(fd, makeTag((size_t)fd, EVENT_SOURCE), events);
+    }
+}
+
+void PtraceSupervisor::removeSource(int fd) {
+    if (sources.erase(fd) > 0) {
+        epoll_ctl(epollfd, EPOLL_CTL_DEL, fd, NULL);
+    }
+}
+
+void PtraceSupervisor::watch(int fd, uint64_t tag, uint32_t events) {
+    epoll_event event = {};
+    event.events = events;
+    event.data.u64 = tag;
+    epoll_ctl(epollfd, EPOLL_CTL_ADD, fd, &event);
+}
+
+bool PtraceSupervisor::launch(size_t index, Job &job, const Callback &callback) {
+    Slot &slot = slots[index];
+    slot.id = job.id;
+    slot.config = std::move(job.config);
+    if (!layout.empty()) {
+        // slots beyond the layout have to share CPUs
+        slot.config->cpu = layout[index % layout.size()].traceeCpu;
+        slot.config->tracerCpu = -1;
+    }
+    slot.invoker.reset(static_cast<PtraceInvoker*>(Invoker::makeInvoker("ptrace", arch, *slot.config)));
+
+    if (!slot.invoker->start()) {
+        bool keep = callback(slot.id, *slot.invoker);
+        slot.invoker.reset();
+        slot.config.reset();
+        return keep;
+    }
+
+    pid_t pid = slot.invoker->getPid();
+    slot.busy = true;
+    slotByPid[pid] = index;
+    slot.invoker->setThreadListener([this, index](pid_t tid, bool added) {
+        if (added) {
+            slotByPid[tid] = index;
+        } else {
+            slotByPid.erase(tid);
+        }
+    });
+
+    // the pidfd becomes readable once the tracee exits, stops are reported by SIGCHLD
+    slot.pidfd = (int)syscall(SYS_pidfd_open, pid, 0);
+    if (slot.pidfd != -1) {
+        watch(slot.pidfd, makeTag(index, EVENT_PIDFD));
+    }
+
+    if (slot.config->wallLimit > 0) {
+        slot.timerfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        if (slot.timerfd != -1) {
+            PtraceInvoker::armTimer(slot.timerfd, slot.config->wallLimit);
+            watch(slot.timerfd, makeTag(index, EVENT_TIMER));
+        }
+    }
+
+    // the CPU time of the tree is checked again whenever it could have run out
+    double delay = slot.invoker->cpuCheckDelay();
+    if (delay > 0) {
+        slot.cpufd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        if (slot.cpufd != -1) {
+            PtraceInvoker::armTimer(slot.cpufd, delay);
+            watch(slot.cpufd, makeTag(index, EVENT_CPU));
+        }
+    }
+
+    return true;
+}
+
+bool PtraceSupervisor::complete(size_t index, const Callback &callback) {
+    Slot &slot = slots[index];
+
+    // closing the descriptors also removes them from the epoll set
+    if (slot.pidfd != -1) {
+        close(slot.pidfd);
+        slot.pidfd = -1;
+    }
+    if (slot.timerfd != -1) {
+        close(slot.timerfd);
+        slot.timerfd = -1;
+    }
+    if (slot.cpufd != -1) {
+        close(slot.cpufd);
+        slot.cpufd = -1;
+    }
+
+    slotByPid.erase(slot.invoker->getPid());
+    slot.busy = false;
+    slot.invoker->finish();
+
+    bool keep = callback(slot.id, *slot.invoker);
+    slot.invoker.reset();
+    slot.config.reset();
+    return keep;
+}
+
+bool PtraceSupervisor::reap(const Callback &callback) {
+    bool keep = true;
+    for (;;) {
+        rusage ru;
+        int status;
+        // only our own tracees, an embedding program may have children of its own
+        pid_t p = wait4(-1, &status, WNOHANG | __WALL | __WNOTHREAD, &ru);
+        if (p <= 0) {
+            break;
+        }
+
+        auto it = slotByPid.find(p);
+        if (it == slotByPid.end() && WIFSTOPPED(status)) {
+            // a new task reported its first stop before the ptrace event of its parent,
+            // it belongs to the slot of its thread group or of its parent process
+            it = slotByPid.find((pid_t)PtraceInvoker::readProcStatus(p, "Tgid:"));
+            if (it == slotByPid.end()) {
+                it = slotByPid.find((pid_t)PtraceInvoker::readProcStatus(p, "PPid:"));
+            }
+        }
+        if (it == slotByPid.end()) {
+            continue;
+        }
+
+        size_t index = it->second;
+        if (slots[index].invoker->onWait(p, status, ru)) {
+            keep = complete(index, callback) && keep;
+        }
+    }
+    return keep;
+}
+
+void PtraceSupervisor::run(const Callback &callback) {
+    sigset_t mask, oldMask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGCHLD);
+    sigprocmask(SIG_BLOCK, &mask, &oldMask);
+
+    if (!layout.empty()) {
+        // all tracees share one tracer, it may run on any of the tracer CPUs
+        std::vector<int> tracerCpus;
+        for (const CpuSlot &slot : layout) {
+            tracerCpus.push_back(slot.tracerCpu);
+        }
+        pinToCpus(tracerCpus);
+    }
+
+    sigchldfd = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    running = &callback;
+    watch(sigchldfd, makeTag(0, EVENT_SIGCHLD));
+
+    bool accepting = true;
+    for (;;) {
+        size_t active = 0;
+        for (size_t i = 0; i < slots.size(); ++i) {
+            while (!slots[i].busy && accepting && !queue.empty()) {
+                Job job = std::move(queue.front());
+                queue.pop_front();
+                accepting = launch(i, job, callback);
+            }
+            if (slots[i].busy) {
+                ++active;
+            }
+        }
+
+        if (!accepting) {
+            queue.clear();
+        }
+
+        if (active == 0 && sources.empty()) {
+            break;
+        }
+
+        epoll_event events[64];
+        int n = epoll_wait(epollfd, events, 64, -1);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        bool children = false;
+        for (int i = 0; i < n; ++i) {
+            size_t index = events[i].data.u64 >> 3;
+            auto kind = (EventKind)(events[i].data.u64 & 7);
+
+            if (kind == EVENT_SOURCE) {
+                // the handler may have been removed by an earlier one in this batch
+                auto it = sources.find((int)index);
+                if (it != sources.end()) {
+                    SourceHandler handler = it->second;
+                    handler();
+                }
+            } else if (kind == EVENT_TIMER) {
+                Slot &slot = slots[index];
+                if (slot.busy && slot.timerfd != -1) {
+                    uint64_t expirations;
+                    read(slot.timerfd, &expirations, sizeof(expirations));
+                    slot.invoker->onWallLimit();
+                    accepting = complete(index, callback) && accepting;
+                }
+            } else if (kind == EVENT_CPU) {
+                Slot &slot = slots[index];
+                if (slot.busy && slot.cpufd != -1) {
+                    uint64_t expirations;
+                    read(slot.cpufd, &expirations, sizeof(expirations));
+                    if (slot.invoker->onCpuCheck()) {
+                        accepting = complete(index, callback) && accepting;
+                    } else {
+                        PtraceInvoker::armTimer(slot.cpufd, slot.invoker->cpuCheckDelay());
+                    }
+                }
+            } else {
+                children = true;
+            }
+        }
+
+        if (children) {
+            signalfd_siginfo info;
+            while (read(sigchldfd, &info, sizeof(info)) > 0) {
+            }
+            accepting = reap(callback) && accepting;
+        }
+    }
+
+    running = nullptr;
+    // closing it also removes it from the epoll set, which stays for the next run
+    close(sigchldfd);
+    sigchldfd = -1;
+    sigprocmask(SIG_SETMASK, &oldMask, NULL);
+}
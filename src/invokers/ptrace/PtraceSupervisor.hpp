@@ -0,0 +1,79 @@
+#ifndef INVOKE_PTRACESUPERVISOR_HPP
+#define INVOKE_PTRACESUPERVISOR_HPP
+
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <sys/epoll.h>
+#include "PtraceInvoker.hpp"
+#include "CpuTopology.hpp"
+
+// Runs up to `slots` tracees at once from a single event loop. Stops and exits of
+// the tracees are picked up through a signalfd for SIGCHLD and their pidfds, wall
+// and CPU limits are enforced with timerfds per tracee.
+class PtraceSupervisor {
+public:
+    // called once a job is complete, returning false drops all jobs still queued
+    typedef std::function<bool(size_t id, const Invoker &invoker)> Callback;
+    // called from the event loop whenever a source descriptor is ready
+    typedef std::function<void()> SourceHandler;
+
+private:
+    struct Job {
+        size_t id;
+        std::unique_ptr<InvokerConfig> config;
+    };
+
+    struct Slot {
+        size_t id = 0;
+        std::unique_ptr<InvokerConfig> config;
+        std::unique_ptr<PtraceInvoker> invoker;
+        int pidfd = -1;
+        int timerfd = -1;
+        int cpufd = -1;
+        bool busy = false;
+    };
+
+    std::string arch;
+    std::deque<Job> queue;
+    std::vector<Slot> slots;
+    std::unordered_map<pid_t, size_t> slotByPid;
+    std::unordered_map<int, SourceHandler> sources;
+    std::vector<CpuSlot> layout;
+    const Callback *running = nullptr;
+
+    int epollfd = -1;
+    int sigchldfd = -1;
+
+    bool launch(size_t slot, Job &job, const Callback &callback);
+    bool complete(size_t slot, const Callback &callback);
+    bool reap(const Callback &callback);
+    void watch(int fd, uint64_t tag, uint32_t events = EPOLLIN);
+
+public:
+    PtraceSupervisor(const std::string &arch, size_t slots);
+    ~PtraceSupervisor();
+
+    // Pin the tracee of every slot to its own CPU and the supervisor to the tracer CPUs
+    void pin(const std::vector<CpuSlot> &layout);
+
+    void submit(size_t id, const InvokerConfig &config);
+    // Drop a queued job, or kill a running one and report it as complete.
+    // Must be called from a handler of the running event loop.
+    void cancel(size_t id);
+
+    // Also wait for one of the epoll `events` on `fd`, adding it again only changes them.
+    // run() keeps going while any source is watched, so jobs may be submitted from the
+    // handler long after it started.
+    void addSource(int fd, const SourceHandler &handler, uint32_t events = EPOLLIN);
+    // the descriptor is not closed
+    void removeSource(int fd);
+
+    void run(const Callback &callback);
+};
+
+
+#endif //INVOKE_PTRACESUPERVISOR_HPP
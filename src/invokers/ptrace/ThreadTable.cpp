@@ -0,0 +1,102 @@
+#include "ThreadTable.hpp"
+
+size_t ThreadTable::home(pid_t tid) const {
+    // TIDs are mostly consecutive, Fibonacci hashing spreads them over the table
+    return (size_t)(((uint32_t)tid * 2654435769u) >> (32 - bits));
+}
+
+void ThreadTable::grow() {
+    std::vector<TracedThread> old;
+    old.swap(slots);
+
+    bits = bits == 0 ? 4 : bits + 1;
+    slots.assign((size_t)1 << bits, TracedThread());
+    count = 0;
+
+    for (const TracedThread &thread : old) {
+        if (thread.tid != 0) {
+            insert(thread.tid) = thread;
+        }
+    }
+}
+
+TracedThread *ThreadTable::find(pid_t tid) {
+    if (count == 0) {
+        return nullptr;
+    }
+
+    size_t mask = slots.size() - 1;
+    for (size_t i = home(tid); ; i = (i + 1) & mask) {
+        if (slots[i].tid == tid) {
+            return &slots[i];
+        }
+        if (slots[i].tid == 0) {
+            return nullptr;
+        }
+    }
+}
+
+TracedThread &ThreadTable::insert(pid_t tid) {
+    TracedThread *thread = find(tid);
+    if (thread) {
+        return *thread;
+    }
+
+    // keep the load factor at most one half, so probe sequences stay short
+    if ((count + 1) * 2 > slots.size()) {
+        grow();
+    }
+
+    size_t mask = slots.size() - 1;
+    size_t i = home(tid);
+    while (slots[i].tid != 0) {
+        i = (i + 1) & mask;
+    }
+
+    slots[i] = TracedThread();
+    slots[i].tid = tid;
+    ++count;
+    return slots[i];
+}
+
+void ThreadTable::erase(pid_t tid) {
+    TracedThread *thread = find(tid);
+    if (!thread) {
+        return;
+    }
+
+    // backward shift deletion, so the table never fills up with tombstones
+    size_t mask = slots.size() - 1;
+    size_t hole = (size_t)(thread - slots.data());
+    for (size_t i = (hole + 1) & mask; slots[i].tid != 0; i = (i + 1) & mask) {
+        size_t want = home(slots[i].tid);
+        if (((i - want) & mask) >= ((i - hole) & mask)) {
+            slots[hole] = slots[i];
+            hole = i;
+        }
+    }
+    slots[hole] = TracedThread();
+    --count;
+}
+
+void ThreadTable::clear() {
+    for (TracedThread &thread : slots) {
+        thread = TracedThread();
+    }
+    count = 0;
+}
+
+size_t ThreadTable::size() const {
+    return count;
+}
+
+std::vector<pid_t> ThreadTable::tids() const {
+    std::vector<pid_t> res;
+    res.reserve(count);
+    for (const TracedThread &thread : slots) {
+        if (thread.tid != 0) {
+            res.push_back(thread.tid);
+        }
+    }
+    return res;
+}
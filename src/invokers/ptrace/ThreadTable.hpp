@@ -0,0 +1,42 @@
+#ifndef INVOKE_THREADTABLE_HPP
+#define INVOKE_THREADTABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <sys/types.h>
+
+struct TracedThread {
+    pid_t tid = 0;
+    pid_t tgid = 0;
+    // only used when every syscall entry and exit stops in the tracer
+    bool inSyscall = false;
+    long denySyscall = 0;
+    // when it was last resumed, only kept with InvokerConfig::stats
+    double resumed = 0;
+};
+
+// Tracing state of every thread of a tracee, kept in one flat open-addressing table
+// keyed by TID, so a lookup on each stop touches a single cache line in the common case.
+class ThreadTable {
+private:
+    std::vector<TracedThread> slots;
+    size_t count = 0;
+    unsigned bits = 0;
+
+    size_t home(pid_t tid) const;
+    void grow();
+
+public:
+    // the returned pointer is only valid until the next insert()
+    TracedThread *find(pid_t tid);
+    TracedThread &insert(pid_t tid);
+    void erase(pid_t tid);
+    void clear();
+
+    size_t size() const;
+    std::vector<pid_t> tids() const;
+};
+
+
+#endif //INVOKE_THREADTABLE_HPP
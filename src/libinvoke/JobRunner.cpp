@@ -0,0 +1,133 @@
+#include "JobRunner.hpp"
+
+#include <cerrno>
+#include <system_error>
+
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+JobRunner::Job::~Job() {
+    if (fd != -1) {
+        close(fd);
+    }
+}
+
+JobRunner::JobRunner(size_t slots) : supervisor("x86_64", slots) {
+
+}
+
+bool JobRunner::start() {
+    wakefd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakefd == -1) {
+        return false;
+    }
+
+    try {
+        thread = std::thread([this]() { loop(); });
+    } catch (std::system_error &e) {
+        close(wakefd);
+        wakefd = -1;
+        errno = e.code().value();
+        return false;
+    }
+    thread.detach();
+    return true;
+}
+
+void JobRunner::loop() {
+    // the wakeup source keeps the supervisor running when there are no jobs
+    supervisor.addSource(wakefd, [this]() { onWake(); });
+    supervisor.run([this](size_t id, const Invoker &invoker) {
+        return onComplete(id, invoker);
+    });
+}
+
+std::shared_ptr<JobRunner::Job> JobRunner::submit(const InvokerConfig &config) {
+    std::shared_ptr<Job> job = std::make_shared<Job>();
+    job->fd = eventfd(0, EFD_CLOEXEC);
+    if (job->fd == -1) {
+        return nullptr;
+    }
+    job->stdio[0] = config.stdin_fd;
+    job->stdio[1] = config.stdout_fd;
+    job->stdio[2] = config.stderr_fd;
+
+    Command command;
+    command.job = job;
+    command.config.reset(new InvokerConfig(config));
+    post(std::move(command));
+    return job;
+}
+
+void JobRunner::cancel(const std::shared_ptr<Job> &job) {
+    Command command;
+    command.job = job;
+    post(std::move(command));
+}
+
+void JobRunner::post(Command command) {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (command.config) {
+            command.job->id = nextJob++;
+        }
+        commands.push_back(std::move(command));
+    }
+    uint64_t one = 1;
+    write(wakefd, &one, sizeof(one));
+}
+
+void JobRunner::onWake() {
+    uint64_t count;
+    read(wakefd, &count, sizeof(count));
+
+    std::vector<Command> pending;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        pending.swap(commands);
+    }
+
+    for (Command &command : pending) {
+        size_t id = command.job->id;
+        if (command.config) {
+            running[id] = command.job;
+            supervisor.submit(id, *command.config);
+        } else if (running.count(id)) {
+            // a queued job never gets to onComplete(), so it is completed right here
+            supervisor.cancel(id);
+            auto it = running.find(id);
+            if (it != running.end()) {
+                for (int fd : it->second->stdio) {
+                    if (fd > 2) {
+                        close(fd);
+                    }
+                }
+                running.erase(it);
+            }
+        }
+    }
+}
+
+bool JobRunner::onComplete(size_t id, const Invoker &invoker) {
+    auto it = running.find(id);
+    if (it == running.end()) {
+        return true;
+    }
+    std::shared_ptr<Job> job = it->second;
+    running.erase(it);
+
+    for (int fd : job->stdio) {
+        if (fd > 2) {
+            close(fd);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(job->lock);
+        job->result = invoker.getResult();
+        job->done = true;
+    }
+    uint64_t one = 1;
+    write(job->fd, &one, sizeof(one));
+    return true;
+}
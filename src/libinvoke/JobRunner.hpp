@@ -0,0 +1,66 @@
+#ifndef INVOKE_JOBRUNNER_HPP
+#define INVOKE_JOBRUNNER_HPP
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "InvokerConfig.hpp"
+#include "invokers/ptrace/PtraceSupervisor.hpp"
+
+// Runs jobs submitted from any thread on a PtraceSupervisor driven by a thread of its
+// own, which is the tracer of every job. Submissions and cancellations are handed
+// over through a queue and an eventfd that wakes up the event loop.
+class JobRunner {
+public:
+    struct Job {
+        size_t id = 0;
+        // eventfd that becomes readable once the job is complete
+        int fd = -1;
+        // descriptors of the config, owned by the job
+        int stdio[3] = { -1, -1, -1 };
+
+        std::mutex lock;
+        bool done = false;
+        InvokerResult result;
+
+        ~Job();
+    };
+
+private:
+    struct Command {
+        std::shared_ptr<Job> job;
+        // null for a cancellation
+        std::unique_ptr<InvokerConfig> config;
+    };
+
+    PtraceSupervisor supervisor;
+    std::thread thread;
+    int wakefd = -1;
+
+    std::mutex lock;
+    std::vector<Command> commands;
+    size_t nextJob = 0;
+
+    // only touched by the thread of the runner
+    std::unordered_map<size_t, std::shared_ptr<Job>> running;
+
+    void loop();
+    void onWake();
+    bool onComplete(size_t id, const Invoker &invoker);
+    void post(Command command);
+
+public:
+    explicit JobRunner(size_t slots);
+
+    // Starts the thread, which runs until the process exits. Returns false with errno set on failure.
+    bool start();
+
+    // The job takes over the descriptors of the config
+    std::shared_ptr<Job> submit(const InvokerConfig &config);
+    void cancel(const std::shared_ptr<Job> &job);
+};
+
+
+#endif //INVOKE_JOBRUNNER_HPP
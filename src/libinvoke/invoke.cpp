@@ -0,0 +1,242 @@
+#include "invoke.h"
+#include "JobRunner.hpp"
+
+#include <cerrno>
+#include <csignal>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include <Cgroup.hpp>
+#include <ProfileLoader.hpp>
+
+struct invoke_config {
+    InvokerConfig config;
+
+    explicit invoke_config(const InvokerProfile &profile) : config(profile) {
+        config.stdin_fd = -1;
+        config.stdout_fd = -1;
+        config.stderr_fd = -1;
+    }
+};
+
+struct invoke_job {
+    std::shared_ptr<JobRunner::Job> job;
+    invoke_result result;
+};
+
+namespace {
+
+JobRunner *runner = nullptr;
+
+// own close-on-exec copy of a descriptor, -1 stays -1
+int duplicate(int fd) {
+    return fd < 0 ? -1 : fcntl(fd, F_DUPFD_CLOEXEC, 3);
+}
+
+void closeDuplicate(int fd) {
+    if (fd != -1) {
+        close(fd);
+    }
+}
+
+}
+
+int invoke_init(int parallel) {
+    if (runner) {
+        return 0;
+    }
+
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGCHLD);
+    pthread_sigmask(SIG_BLOCK, &mask, NULL);
+
+    if (parallel <= 0) {
+        cpu_set_t affinity;
+        parallel = sched_getaffinity(0, sizeof(affinity), &affinity) == 0 ? CPU_COUNT(&affinity) : 1;
+    }
+
+    JobRunner *created = new JobRunner((size_t)parallel);
+    if (!created->start()) {
+        int err = errno;
+        delete created;
+        return -err;
+    }
+    runner = created;
+    return 0;
+}
+
+void invoke_set_profile_directory(const char *directory, const char *cache) {
+    ProfileLoader::setDirectory(directory ? directory : "", cache ? cache : "");
+}
+
+invoke_config *invoke_config_new(const char *profile) {
+    try {
+        const InvokerProfile &found = InvokerProfile::getProfile(
+                profile ? profile : InvokerProfile::availableProfiles[0]);
+        return new invoke_config(found);
+    } catch (std::invalid_argument &e) {
+        errno = EINVAL;
+        return nullptr;
+    }
+}
+
+void invoke_config_free(invoke_config *config) {
+    delete config;
+}
+
+int invoke_config_set_program(invoke_config *config, const char *exe, const char *const argv[]) {
+    if (!argv || !argv[0]) {
+        return -EINVAL;
+    }
+    config->config.args.clear();
+    for (size_t i = 0; argv[i]; ++i) {
+        config->config.args.push_back(argv[i]);
+    }
+    config->config.exe = exe ? exe : argv[0];
+    return 0;
+}
+
+int invoke_config_add_env(invoke_config *config, const char *variable) {
+    if (!variable) {
+        return -EINVAL;
+    }
+    config->config.envp.push_back(variable);
+    return 0;
+}
+
+void invoke_config_set_limits(invoke_config *config, double time_limit, long memory_limit, double wall_limit) {
+    config->config.timeLimit = time_limit;
+    config->config.memoryLimit = memory_limit;
+    config->config.wallLimit = wall_limit;
+}
+
+void invoke_config_set_process_limit(invoke_config *config, long processes) {
+    config->config.processLimit = processes;
+}
+
+void invoke_config_set_cpu_quota(invoke_config *config, double cpus) {
+    config->config.cpuQuota = cpus;
+}
+
+void invoke_config_set_stdio(invoke_config *config, int stdin_fd, int stdout_fd, int stderr_fd) {
+    config->config.stdin_fd = stdin_fd;
+    config->config.stdout_fd = stdout_fd;
+    config->config.stderr_fd = stderr_fd;
+}
+
+int invoke_config_set_workdir(invoke_config *config, const char *path) {
+    if (!path) {
+        return -EINVAL;
+    }
+    config->config.workingDirectory = path;
+    return 0;
+}
+
+void invoke_config_set_seccomp(invoke_config *config, int enabled) {
+    config->config.seccomp = enabled != 0;
+}
+
+void invoke_config_set_landlock(invoke_config *config, int enabled) {
+    config->config.landlock = enabled != 0;
+}
+
+int invoke_config_set_cgroup(invoke_config *config, const char *root) {
+    std::string path = root ? root : Cgroup::defaultRoot();
+    if (path.empty()) {
+        return -ENOENT;
+    }
+    config->config.cgroupRoot = path;
+    return 0;
+}
+
+invoke_job *invoke_start(const invoke_config *config) {
+    if (!runner) {
+        errno = EINVAL;
+        return nullptr;
+    }
+    if (config->config.args.empty()) {
+        errno = EINVAL;
+        return nullptr;
+    }
+
+    InvokerConfig copy(config->config);
+    copy.stdin_fd = duplicate(config->config.stdin_fd);
+    copy.stdout_fd = duplicate(config->config.stdout_fd);
+    copy.stderr_fd = duplicate(config->config.stderr_fd);
+
+    std::shared_ptr<JobRunner::Job> job = runner->submit(copy);
+    if (!job) {
+        int err = errno;
+        closeDuplicate(copy.stdin_fd);
+        closeDuplicate(copy.stdout_fd);
+        closeDuplicate(copy.stderr_fd);
+        errno = err;
+        return nullptr;
+    }
+
+    invoke_job *handle = new invoke_job();
+    handle->job = job;
+    return handle;
+}
+
+invoke_job *invoke_run(const invoke_config *config) {
+    invoke_job *job = invoke_start(config);
+    if (job) {
+        invoke_job_wait(job);
+    }
+    return job;
+}
+
+int invoke_job_fd(const invoke_job *job) {
+    return job->job->fd;
+}
+
+const invoke_result *invoke_job_result(const invoke_job *job) {
+    std::lock_guard<std::mutex> guard(job->job->lock);
+    if (!job->job->done) {
+        return nullptr;
+    }
+
+    // the result of a complete job does not change any more
+    const InvokerResult &result = job->job->result;
+    invoke_result &out = const_cast<invoke_job*>(job)->result;
+    out.error = result.error;
+    out.error_message = result.errorMessage.c_str();
+    out.exit_code = result.exitCode;
+    out.wall_clock = result.wallClock;
+    out.cpu_clock = result.cpuUsage;
+    out.memory_usage = result.memoryUsage;
+    out.spawn_latency = result.spawnLatency;
+    out.verdicts = (result.timeLimitExceeded ? INVOKE_VERDICT_TL : 0) |
+                   (result.memoryLimitExceeded ? INVOKE_VERDICT_ML : 0) |
+                   (result.wallLimitExceeded ? INVOKE_VERDICT_RL : 0) |
+                   (result.securityViolation ? INVOKE_VERDICT_SV : 0);
+    return &out;
+}
+
+const invoke_result *invoke_job_wait(invoke_job *job) {
+    pollfd fd = { job->job->fd, POLLIN, 0 };
+    while (poll(&fd, 1, -1) < 0 && errno == EINTR) {
+    }
+    return invoke_job_result(job);
+}
+
+void invoke_job_free(invoke_job *job) {
+    if (!job) {
+        return;
+    }
+    bool done;
+    {
+        std::lock_guard<std::mutex> guard(job->job->lock);
+        done = job->job->done;
+    }
+    if (!done) {
+        runner->cancel(job->job);
+    }
+    delete job;
+}
@@ -0,0 +1,96 @@
+#ifndef INVOKE_INVOKE_H
+#define INVOKE_INVOKE_H
+
+/*
+ * Stable C interface of libinvoke.
+ *
+ * Jobs are run by a tracer thread owned by the library. It learns about stops of the
+ * tracees from SIGCHLD, so invoke_init() must be called before the program starts any
+ * threads of its own: it blocks SIGCHLD in the calling thread, and threads created
+ * afterwards inherit that.
+ *
+ * All handles are opaque and structures are only ever allocated by the library, so
+ * new fields may be appended without breaking binaries built against older headers.
+ */
+
+#include <stddef.h>
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define INVOKE_VERDICT_TL 0x1 /* CPU time limit exceeded */
+#define INVOKE_VERDICT_ML 0x2 /* memory limit exceeded */
+#define INVOKE_VERDICT_RL 0x4 /* wall time limit exceeded */
+#define INVOKE_VERDICT_SV 0x8 /* security violation */
+
+typedef struct invoke_config invoke_config;
+typedef struct invoke_job invoke_job;
+
+typedef struct invoke_result {
+    /* errno of a failure to run the program at all, error_message tells more */
+    int error;
+    const char *error_message;
+    int exit_code;
+    double wall_clock;
+    double cpu_clock;
+    long memory_usage;
+    /* seconds from spawning the program until it started, or -1 */
+    double spawn_latency;
+    /* INVOKE_VERDICT_* flags */
+    int verdicts;
+} invoke_result;
+
+/* Start the tracer thread running up to `parallel` jobs at once, 0 for one per CPU.
+ * Returns 0 or a negative errno value. */
+int invoke_init(int parallel);
+
+/* Look up profiles other than the built-in ones as <directory>/<name>.json, compiled
+ * profiles are cached in `cache`, NULL for <directory>/.cache */
+void invoke_set_profile_directory(const char *directory, const char *cache);
+
+/* NULL with errno set to EINVAL if there is no such profile, NULL picks the default one */
+invoke_config *invoke_config_new(const char *profile);
+void invoke_config_free(invoke_config *config);
+
+/* argv is NULL-terminated and starts with argv[0], exe defaults to argv[0] */
+int invoke_config_set_program(invoke_config *config, const char *exe, const char *const argv[]);
+/* NAME=value, the environment is empty unless variables are added */
+int invoke_config_add_env(invoke_config *config, const char *variable);
+/* seconds, bytes and seconds, zero or negative values mean no limit */
+void invoke_config_set_limits(invoke_config *config, double time_limit, long memory_limit, double wall_limit);
+/* zero means no limit, negative values take the limit of the profile */
+void invoke_config_set_process_limit(invoke_config *config, long processes);
+void invoke_config_set_cpu_quota(invoke_config *config, double cpus);
+/* duplicated by invoke_start(), -1 leaves the stream closed */
+void invoke_config_set_stdio(invoke_config *config, int stdin_fd, int stdout_fd, int stderr_fd);
+int invoke_config_set_workdir(invoke_config *config, const char *path);
+void invoke_config_set_seccomp(invoke_config *config, int enabled);
+/* enforce path permissions with Landlock, falls back to the tracer where it can't */
+void invoke_config_set_landlock(invoke_config *config, int enabled);
+/* run every job in its own cgroup v2 under root, NULL picks <cgroup2 mount>/invoke */
+int invoke_config_set_cgroup(invoke_config *config, const char *root);
+
+/*
+ * Queue a job, the config may be changed or freed right away.
+ * Returns NULL with errno set if the job could not be queued.
+ */
+invoke_job *invoke_start(const invoke_config *config);
+/* Same, but blocks until the job is complete */
+invoke_job *invoke_run(const invoke_config *config);
+
+/* readable once the job is complete, owned by the job */
+int invoke_job_fd(const invoke_job *job);
+/* NULL while the job is still running, owned by the job */
+const invoke_result *invoke_job_result(const invoke_job *job);
+/* blocks until the job is complete */
+const invoke_result *invoke_job_wait(invoke_job *job);
+/* kills the program if it still runs */
+void invoke_job_free(invoke_job *job);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INVOKE_INVOKE_H */
@@ -1,12 +1,60 @@
 #include <iostream>
+#include <memory>
 #include <invokers/ptrace/PtraceInvoker_x86_64.hpp>
 #include <profiles/linux_native.hpp>
 #include <fcntl.h>
+#include <BatchManifest.hpp>
+#include <InvokerDaemon.hpp>
+#include <invokers/ptrace/PtraceSupervisor.hpp>
+#include <CpuTopology.hpp>
+#include <Cgroup.hpp>
+#include <ProfileLoader.hpp>
 
 #include <boost/program_options.hpp>
 
 namespace po = boost::program_options;
 
+// Point config at the files and limits of a test, everything else is taken from base
+static bool applyTest(const BatchTest &test, const InvokerConfig &base, InvokerConfig &config) {
+    config.timeLimit = test.timeLimit >= 0 ? test.timeLimit : base.timeLimit;
+    config.memoryLimit = test.memoryLimit >= 0 ? test.memoryLimit : base.memoryLimit;
+    config.wallLimit = test.wallLimit >= 0 ? test.wallLimit : base.wallLimit;
+    config.stdin_fd = base.stdin_fd;
+    config.stdout_fd = base.stdout_fd;
+
+    // close-on-exec, so that tests running in parallel do not see each other's files
+    if (test.input != "-") {
+        config.stdin_fd = open(test.input.c_str(), O_RDONLY | O_CLOEXEC);
+        if (config.stdin_fd < 0) {
+            std::cerr << "Failed to open file '" << test.input << "' for reading: " << strerror(errno) << std::endl;
+            return false;
+        }
+    }
+
+    if (test.output != "-") {
+        config.stdout_fd = open(test.output.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+        if (config.stdout_fd < 0) {
+            std::cerr << "Failed to open file '" << test.output << "' for writing: " << strerror(errno) << std::endl;
+            if (config.stdin_fd != base.stdin_fd) {
+                close(config.stdin_fd);
+            }
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void releaseTest(const InvokerConfig &base, const InvokerConfig &config) {
+    if (config.stdin_fd != base.stdin_fd) {
+        close(config.stdin_fd);
+    }
+
+    if (config.stdout_fd != base.stdout_fd) {
+        close(config.stdout_fd);
+    }
+}
+
 int main(int argc, char **argv) {
     double timeLimit = 0;
     long memoryLimit = 0;
@@ -15,6 +63,14 @@ int main(int argc, char **argv) {
     std::string stdoutFilename;
     std::string stderrFilename;
     std::string workdir;
+    std::string manifestFilename;
+    std::string socketPath;
+    std::string profileDirectory, profileCache;
+    int parallel = 1;
+    std::string cgroupRoot;
+    long processLimit = -1;
+    double cpuQuota = -1;
+    int poolSize = 0;
     std::vector<std::string> program, env;
 
     std::string profileName = InvokerProfile::availableProfiles[0];
@@ -27,9 +83,16 @@ int main(int argc, char **argv) {
             ("list-profiles", "Show list of available profiles")
             ("list-invokers", "Show list of available invokers")
             ("profile,P", po::value<std::string>(&profileName), "Set profile used to run program")
+            ("profile-dir", po::value<std::string>(&profileDirectory), "Load other profiles from <name>.json files in this directory")
+            ("profile-cache", po::value<std::string>(&profileCache),
+                    "Cache compiled profiles in this directory (default: <profile-dir>/.cache)")
             ("invoker,I", po::value<std::string>(&invokerName), "Set invoker used to run program")
             ("arch,a", po::value<std::string>(&archName))
             ("verbose,v", "Be more verbose")
+            ("no-seccomp", "Stop in the tracer on every system call instead of using a seccomp filter")
+            ("landlock", "Have the kernel enforce the path permissions with Landlock where it can, "
+                         "profiles that allow threads always do")
+            ("stats", "Report how often each system call stopped in the tracer and how long the tracer took")
             ("stdin,i", po::value<std::string>(&stdinFilename), "Redirect program's stdin to this file instead of stdin")
             ("stdout,o", po::value<std::string>(&stdoutFilename), "Redirect program's stdout to this file instead of stdout")
             ("stderr,e", po::value<std::string>(&stderrFilename), "Redirect program's stderr to this file instead of discarding it")
@@ -38,7 +101,21 @@ int main(int argc, char **argv) {
             ("wall-limit,w", po::value<double>(&wallLimit), "Wall time limit in seconds")
             ("environment,E", po::value<std::vector<std::string>>(&env), "Set environment variable")
             ("inherit-environment,r", "Inherit current environment variables")
-            ("workdir,d", po::value<std::string>(&workdir), "Set working directory of program");
+            ("workdir,d", po::value<std::string>(&workdir), "Set working directory of program")
+            ("batch,b", po::value<std::string>(&manifestFilename), "Run program once for every test listed in this manifest")
+            ("stop-on-failure", "Stop running tests from the manifest after the first failed one")
+            ("pool", po::value<int>(&poolSize),
+                    "Keep this many tracees cloned, seized and limited ahead of the next test of the manifest")
+            ("fork-server", "Start the program once and fork every test from it once it has done the AFL fork server "
+                            "handshake on descriptors 198 and 199")
+            ("parallel,j", po::value<int>(&parallel), "Run this many tests from the manifest or jobs of the daemon at once")
+            ("daemon", po::value<std::string>(&socketPath),
+                    "Serve jobs from clients of this Unix domain socket, options are defaults for the jobs")
+            ("pin-cpus", "Pin every tracee to a dedicated physical core and its tracer next to it")
+            ("cgroup", po::value<std::string>(&cgroupRoot)->implicit_value(""),
+                    "Run every program in its own cgroup v2 under this directory (default: <cgroup2 mount>/invoke)")
+            ("process-limit", po::value<long>(&processLimit), "Maximum number of processes the program may run at once, 0 for no limit (default: that of the profile)")
+            ("cpu-quota", po::value<double>(&cpuQuota), "Number of CPUs the program may use at once, requires a cgroup");
 
     po::options_description hidden;
     hidden.add_options()
@@ -80,33 +157,70 @@ int main(int argc, char **argv) {
         return 0;
     }
 
+    ProfileLoader::setDirectory(profileDirectory, profileCache);
+
     if (vm.count("list-profiles")) {
         for (auto &profile : InvokerProfile::availableProfiles) {
             std::cout << profile << std::endl;
         }
+        for (auto &profile : ProfileLoader::available()) {
+            std::cout << profile << std::endl;
+        }
         return 0;
     }
 
-    if (vm.count("help") || program.empty()) {
+    if (vm.count("help") || (program.empty() && socketPath.empty())) {
         std::cerr << "Usage: " << argv[0] << " [options] <program> [arguments]" << std::endl;
+        std::cerr << "       " << argv[0] << " [options] --daemon <socket>" << std::endl;
         std::cerr << std::endl;
         std::cerr << desc << std::endl;
         return 1;
     }
 
-    Invoker *invoker;
     try {
         InvokerConfig config(InvokerProfile::getProfile(profileName));
         config.wallLimit = wallLimit;
         config.timeLimit = timeLimit;
         config.memoryLimit = memoryLimit;
-        config.exe = program[0];
+        config.exe = program.empty() ? "" : program[0];
         config.args = program;
         config.envp = env;
         config.inheritEnvironment = vm.count("inherit-environment") > 0;
         config.log = vm.count("verbose") > 0;
+        config.seccomp = vm.count("no-seccomp") == 0;
+        config.landlock = vm.count("landlock") > 0;
+        config.stats = vm.count("stats") > 0;
         config.stderr_fd = -1;
         config.workingDirectory = workdir;
+        config.processLimit = processLimit;
+        config.cpuQuota = cpuQuota;
+        config.poolSize = poolSize;
+        config.forkServer = vm.count("fork-server") > 0;
+
+        if (config.forkServer && (invokerName != "ptrace" || parallel > 1 || !socketPath.empty())) {
+            std::cerr << "--fork-server needs the ptrace invoker and one test at a time" << std::endl;
+            return 1;
+        }
+
+        if (!socketPath.empty() && invokerName != "ptrace") {
+            // the daemon traces the jobs of all of its clients in one loop
+            std::cerr << "--daemon needs the ptrace invoker" << std::endl;
+            return 1;
+        }
+
+        if (!manifestFilename.empty() && parallel > 1 && invokerName != "ptrace") {
+            // the tests run side by side in one tracer
+            std::cerr << "Running tests from a manifest in parallel needs the ptrace invoker" << std::endl;
+            return 1;
+        }
+
+        if (vm.count("cgroup") || invokerName == "cgroup") {
+            config.cgroupRoot = cgroupRoot.empty() ? Cgroup::defaultRoot() : cgroupRoot;
+            if (config.cgroupRoot.empty()) {
+                std::cerr << "cgroup v2 is not mounted" << std::endl;
+                return 1;
+            }
+        }
 
         if (!stdinFilename.empty()) {
             config.stdin_fd = open(stdinFilename.c_str(), O_RDONLY);
@@ -132,10 +246,102 @@ int main(int argc, char **argv) {
             }
         }
 
-        invoker = Invoker::makeInvoker(invokerName, archName, config);
-        invoker->run();
-        if (!config.log) {
-            invoker->printResults();
+        if (vm.count("pin-cpus") && parallel <= 1) {
+            std::vector<CpuSlot> layout = CpuTopology::detect().layoutSlots(1);
+            if (!layout.empty()) {
+                config.cpu = layout[0].traceeCpu;
+                config.tracerCpu = layout[0].tracerCpu;
+            }
+        }
+
+        if (!socketPath.empty()) {
+            InvokerDaemon daemon(config, archName, parallel);
+            if (vm.count("pin-cpus")) {
+                daemon.pin(CpuTopology::detect().layoutSlots(parallel));
+            }
+            daemon.listen(socketPath);
+            daemon.run();
+            return 0;
+        }
+
+        // holds on to config, so it must go first
+        std::unique_ptr<Invoker> invoker(Invoker::makeInvoker(invokerName, archName, config));
+
+        if (!manifestFilename.empty() && parallel > 1) {
+            BatchManifest manifest = BatchManifest::load(manifestFilename);
+            bool stopOnFailure = vm.count("stop-on-failure") > 0;
+            PtraceSupervisor supervisor(archName, parallel);
+            if (vm.count("pin-cpus")) {
+                supervisor.pin(CpuTopology::detect().layoutSlots(parallel));
+            }
+            std::vector<InvokerConfig> running(manifest.tests.size(), config);
+            size_t next = 0;
+            bool ok = true;
+
+            // keep only a few more tests than slots open, the rest wait in the manifest
+            auto submitNext = [&]() {
+                if (next == manifest.tests.size()) {
+                    return;
+                }
+                if (!applyTest(manifest.tests[next], config, running[next])) {
+                    ok = false;
+                    next = manifest.tests.size();
+                    return;
+                }
+                supervisor.submit(next, running[next]);
+                ++next;
+            };
+
+            for (int i = 0; i < parallel; ++i) {
+                submitNext();
+            }
+
+            supervisor.run([&](size_t id, const Invoker &done) {
+                std::cerr << "test: " << id + 1 << std::endl;
+                if (!config.log) {
+                    done.printResults();
+                }
+                releaseTest(config, running[id]);
+                if (stopOnFailure && done.getResult().failed()) {
+                    return false;
+                }
+                submitNext();
+                return true;
+            });
+
+            if (!ok) {
+                return 1;
+            }
+        } else if (!manifestFilename.empty()) {
+            BatchManifest manifest = BatchManifest::load(manifestFilename);
+            bool stopOnFailure = vm.count("stop-on-failure") > 0;
+            InvokerConfig base(config);
+
+            for (size_t i = 0; i < manifest.tests.size(); ++i) {
+                if (!applyTest(manifest.tests[i], base, config)) {
+                    return 1;
+                }
+
+                std::cerr << "test: " << i + 1 << std::endl;
+                invoker->run();
+                if (!config.log) {
+                    invoker->printResults();
+                }
+
+                releaseTest(base, config);
+
+                if (stopOnFailure && invoker->getResult().failed()) {
+                    break;
+                }
+            }
+
+            config.stdin_fd = base.stdin_fd;
+            config.stdout_fd = base.stdout_fd;
+        } else {
+            invoker->run();
+            if (!config.log) {
+                invoker->printResults();
+            }
         }
 
         if (config.stdin_fd > 2) {
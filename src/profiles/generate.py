@@ -2,51 +2,129 @@
 # Generate profiles for invoke
 
 import json
+import sys
 
-profiles = ["linux_native", "linux_nosecurity"]
+profiles = ["linux_native", "linux_nosecurity", "linux_runtime", "linux_python", "linux_java", "linux_go", "linux_node"]
 
+# architectures to precompute syscall actions for, from ../tables/linux_<arch>.tbl
+archs = ["i386", "x86_64"]
 
-def gen(name):
+
+def load_table(arch):
+    table = {}
+    with open("../tables/linux_%s.tbl" % arch) as f:
+        for line in f:
+            num, syscall = line.split()
+            table[syscall] = int(num)
+    return table
+
+
+def resolve(syscalls, table):
+    actions = {}
+    for syscall, action in syscalls:
+        if syscall in table:
+            actions[table[syscall]] = action
+    if not actions:
+        return []
+    return [actions.get(num, "SyscallAction::Unspecified") for num in range(max(actions) + 1)]
+
+
+def print_array(f, decl, items):
+    if not items:
+        return False
+    print("constexpr %s[] = {" % decl, file=f)
+    for item in items:
+        print("    %s," % item, file=f)
+    print("};", file=f)
+    print(file=f)
+    return True
+
+
+def list_ref(name, items, present):
+    if not present:
+        return "{ nullptr, 0 }"
+    return "{ %s, %d }" % (name, len(items))
+
+
+def merge(entries, added):
+    """Entries of a profile extending another one, an entry of the same name replaces the inherited one"""
+    names = set(name for name, _ in added)
+    return [entry for entry in entries if entry[0] not in names] + added
+
+
+def load(name, chain=()):
+    if name in chain:
+        raise SystemExit("%s: profile extends itself" % " -> ".join(chain + (name,)))
     with open(name + ".json") as f:
         data = json.load(f)
 
-    syscalls = []
-    syscalls_default = "Security"
-
-    paths = []
-    paths_default = "Security"
+    if "extends" in data:
+        syscalls_default, syscalls, paths_default, paths, process_limit = load(data["extends"], chain + (name,))
+    else:
+        syscalls_default, syscalls, paths_default, paths, process_limit = "Security", [], "Security", [], 0
+    process_limit = data.get("processLimit", process_limit)
 
+    added = []
     for t in data.get("syscalls", []):
         if t == "default":
             syscalls_default = data["syscalls"][t]
             continue
         action = "SyscallAction::{}".format(t)
         for syscall in data["syscalls"][t]:
-            syscalls.append((syscall, action))
+            added.append((syscall, action))
+    syscalls = merge(syscalls, added)
 
+    added = []
     for t in data.get("paths", []):
         if t == "default":
             paths_default = data["paths"][t]
             continue
         access = "PathAccess::{}".format(t)
         for path in data["paths"][t]:
-            paths.append((path, access))
+            added.append((path, access))
+    paths = merge(paths, added)
+
+    return syscalls_default, syscalls, paths_default, paths, process_limit
+
+
+def gen(name):
+    # profiles are merged here, so the generated tables are as flat as those of any other profile
+    syscalls_default, syscalls, paths_default, paths, process_limit = load(name)
+
+    tables = {arch: load_table(arch) for arch in archs}
+    for syscall, _ in syscalls:
+        if not any(syscall in table for table in tables.values()):
+            print("%s: unknown syscall '%s'" % (name, syscall), file=sys.stderr)
 
     with open(name + ".cpp", "w") as f:
         print("// This file is generated automatically. Any changes will be lost!", file=f)
         print("#include \"profiles/%s.hpp\"" % name, file=f)
         print(file=f)
+        print("namespace {", file=f)
+        print(file=f)
+
+        has_syscalls = print_array(f, "SyscallPolicy syscalls",
+                                   ["{ \"%s\", %s }" % (syscall, action) for syscall, action in syscalls])
+        has_paths = print_array(f, "PathPermission paths",
+                                ["{ \"%s\", %s }" % (path, access) for path, access in paths])
+
+        actions = []
+        for arch in archs:
+            resolved = resolve(syscalls, tables[arch])
+            present = print_array(f, "SyscallAction actions_%s" % arch, resolved)
+            actions.append("{ \"%s\", %s, %d }" % (arch, "actions_" + arch if present else "nullptr", len(resolved)))
+        print_array(f, "ProfileActions actions", actions)
+
+        print("}", file=f)
+        print(file=f)
 
         print("const InvokerProfile %s_profile = {" % name, file=f)
         print("    \"%s\", SyscallAction::%s, PathAccess::%s," % (name, syscalls_default, paths_default), file=f)
-        print("    {", file=f)
-        for syscall, action in syscalls:
-            print("        { \"%s\", %s }," % (syscall, action), file=f)
-        print("    },", file=f)
-        print("    {", file=f)
-        for path, access in paths:
-            print("        { \"%s\", %s }," % (path, access), file=f)
-        print("    },", file=f)
+        print("    %s," % list_ref("syscalls", syscalls, has_syscalls), file=f)
+        print("    %s," % list_ref("paths", paths, has_paths), file=f)
+        print("    { actions, %d }," % len(actions), file=f)
+        print("    nullptr,", file=f)
+        print("    %d," % process_limit, file=f)
         print("};", file=f)
 
     with open(name + ".hpp", "w") as f:
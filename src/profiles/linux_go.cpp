@@ -0,0 +1,1056 @@
+// This file is generated automatically. Any changes will be lost!
+#include "profiles/linux_go.hpp"
+
+namespace {
+
+constexpr SyscallPolicy syscalls[] = {
+    { "access", SyscallAction::Allow },
+    { "arch_prctl", SyscallAction::Allow },
+    { "brk", SyscallAction::Allow },
+    { "clock_getres", SyscallAction::Allow },
+    { "clock_gettime", SyscallAction::Allow },
+    { "close", SyscallAction::Allow },
+    { "dup", SyscallAction::Allow },
+    { "dup2", SyscallAction::Allow },
+    { "dup3", SyscallAction::Allow },
+    { "exit", SyscallAction::Allow },
+    { "exit_group", SyscallAction::Allow },
+    { "fcntl", SyscallAction::Allow },
+    { "futex", SyscallAction::Allow },
+    { "getcwd", SyscallAction::Allow },
+    { "getdents", SyscallAction::Allow },
+    { "getdents64", SyscallAction::Allow },
+    { "geteuid", SyscallAction::Allow },
+    { "getpid", SyscallAction::Allow },
+    { "getppid", SyscallAction::Allow },
+    { "getrandom", SyscallAction::Allow },
+    { "getrlimit", SyscallAction::Allow },
+    { "getrusage", SyscallAction::Allow },
+    { "gettid", SyscallAction::Allow },
+    { "gettimeofday", SyscallAction::Allow },
+    { "getuid", SyscallAction::Allow },
+    { "fstat", SyscallAction::Allow },
+    { "ioctl", SyscallAction::Allow },
+    { "lseek", SyscallAction::Allow },
+    { "madvise", SyscallAction::Allow },
+    { "mmap", SyscallAction::Allow },
+    { "mprotect", SyscallAction::Allow },
+    { "mremap", SyscallAction::Allow },
+    { "munmap", SyscallAction::Allow },
+    { "nanosleep", SyscallAction::Allow },
+    { "read", SyscallAction::Allow },
+    { "restart_syscall", SyscallAction::Allow },
+    { "rt_sigaction", SyscallAction::Allow },
+    { "rt_sigprocmask", SyscallAction::Allow },
+    { "rt_sigreturn", SyscallAction::Allow },
+    { "sigaction", SyscallAction::Allow },
+    { "sigaltstack", SyscallAction::Allow },
+    { "sigprocmask", SyscallAction::Allow },
+    { "sigreturn", SyscallAction::Allow },
+    { "sysinfo", SyscallAction::Allow },
+    { "time", SyscallAction::Allow },
+    { "write", SyscallAction::Allow },
+    { "writev", SyscallAction::Allow },
+    { "kill", SyscallAction::Deny },
+    { "tkill", SyscallAction::Deny },
+    { "tgkill", SyscallAction::Deny },
+    { "lstat64", SyscallAction::CheckPath },
+    { "lstat", SyscallAction::CheckPath },
+    { "open", SyscallAction::CheckPath },
+    { "openat", SyscallAction::CheckPath },
+    { "stat64", SyscallAction::CheckPath },
+    { "stat", SyscallAction::CheckPath },
+    { "readlink", SyscallAction::CheckPath },
+    { "capget", SyscallAction::Allow },
+    { "clock_nanosleep", SyscallAction::Allow },
+    { "close_range", SyscallAction::Allow },
+    { "clone", SyscallAction::Allow },
+    { "clone3", SyscallAction::Allow },
+    { "epoll_create", SyscallAction::Allow },
+    { "epoll_create1", SyscallAction::Allow },
+    { "epoll_ctl", SyscallAction::Allow },
+    { "epoll_pwait", SyscallAction::Allow },
+    { "epoll_pwait2", SyscallAction::Allow },
+    { "epoll_wait", SyscallAction::Allow },
+    { "eventfd", SyscallAction::Allow },
+    { "eventfd2", SyscallAction::Allow },
+    { "fork", SyscallAction::Allow },
+    { "getegid", SyscallAction::Allow },
+    { "getegid32", SyscallAction::Allow },
+    { "geteuid32", SyscallAction::Allow },
+    { "getgid", SyscallAction::Allow },
+    { "getgid32", SyscallAction::Allow },
+    { "getuid32", SyscallAction::Allow },
+    { "membarrier", SyscallAction::Allow },
+    { "mincore", SyscallAction::Allow },
+    { "pipe", SyscallAction::Allow },
+    { "pipe2", SyscallAction::Allow },
+    { "poll", SyscallAction::Allow },
+    { "ppoll", SyscallAction::Allow },
+    { "pread", SyscallAction::Allow },
+    { "pread64", SyscallAction::Allow },
+    { "preadv", SyscallAction::Allow },
+    { "prlimit64", SyscallAction::Allow },
+    { "readv", SyscallAction::Allow },
+    { "rseq", SyscallAction::Allow },
+    { "sched_getaffinity", SyscallAction::Allow },
+    { "sched_yield", SyscallAction::Allow },
+    { "set_robust_list", SyscallAction::Allow },
+    { "set_tid_address", SyscallAction::Allow },
+    { "ugetrlimit", SyscallAction::Allow },
+    { "uname", SyscallAction::Allow },
+    { "vfork", SyscallAction::Allow },
+    { "wait4", SyscallAction::Allow },
+    { "waitid", SyscallAction::Allow },
+    { "waitpid", SyscallAction::Allow },
+    { "connect", SyscallAction::Deny },
+    { "io_uring_setup", SyscallAction::Deny },
+    { "socket", SyscallAction::Deny },
+    { "faccessat", SyscallAction::CheckPath },
+    { "faccessat2", SyscallAction::CheckPath },
+    { "fstatat64", SyscallAction::CheckPath },
+    { "newfstatat", SyscallAction::CheckPath },
+    { "readlinkat", SyscallAction::CheckPath },
+    { "statx", SyscallAction::CheckPath },
+};
+
+constexpr PathPermission paths[] = {
+    { "/lib/", PathAccess::ReadOnly },
+    { "/lib32/", PathAccess::ReadOnly },
+    { "/lib64/", PathAccess::ReadOnly },
+    { "/usr/lib/", PathAccess::ReadOnly },
+    { "/usr/lib32/", PathAccess::ReadOnly },
+    { "/usr/lib64/", PathAccess::ReadOnly },
+    { "/usr/libexec/", PathAccess::ReadOnly },
+    { "/usr/local/lib/", PathAccess::ReadOnly },
+    { "/usr/local/lib32/", PathAccess::ReadOnly },
+    { "/usr/local/lib64/", PathAccess::ReadOnly },
+    { "/usr/local/libexec/", PathAccess::ReadOnly },
+    { "/usr/share/", PathAccess::ReadOnly },
+    { "/usr/local/share/", PathAccess::ReadOnly },
+    { "/etc/ld.so.preload", PathAccess::ReadOnly },
+    { "/etc/ld.so.cache", PathAccess::ReadOnly },
+    { "/dev/zero", PathAccess::ReadOnly },
+    { "/dev/tty", PathAccess::ReadOnly },
+    { "/dev/urandom", PathAccess::ReadOnly },
+    { "/etc/passwd", PathAccess::ReadOnly },
+    { "/etc/group", PathAccess::ReadOnly },
+    { "/proc/self/", PathAccess::ReadOnly },
+    { "/etc/localtime", PathAccess::ReadOnly },
+    { "/etc/nsswitch.conf", PathAccess::ReadOnly },
+    { "/sys/devices/system/cpu/", PathAccess::ReadOnly },
+    { "/sys/fs/cgroup/", PathAccess::ReadOnly },
+    { "/sys/kernel/mm/transparent_hugepage/", PathAccess::ReadOnly },
+    { "/proc/meminfo", PathAccess::ReadOnly },
+    { "/proc/stat", PathAccess::ReadOnly },
+    { "/proc/cpuinfo", PathAccess::ReadOnly },
+    { "/proc/sys/vm/", PathAccess::ReadOnly },
+    { "/dev/null", PathAccess::ReadWrite },
+    { "/usr/local/go/lib/time/", PathAccess::ReadOnly },
+};
+
+constexpr SyscallAction actions_i386[] = {
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::CheckPath,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Deny,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::CheckPath,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::CheckPath,
+    SyscallAction::CheckPath,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::CheckPath,
+    SyscallAction::CheckPath,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Deny,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Deny,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::CheckPath,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::CheckPath,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::CheckPath,
+    SyscallAction::Unspecified,
+    SyscallAction::CheckPath,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Deny,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Deny,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::CheckPath,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Deny,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::CheckPath,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+};
+
+constexpr SyscallAction actions_x86_64[] = {
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::CheckPath,
+    SyscallAction::Allow,
+    SyscallAction::CheckPath,
+    SyscallAction::Allow,
+    SyscallAction::CheckPath,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Deny,
+    SyscallAction::Deny,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Deny,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::CheckPath,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Deny,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Deny,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::CheckPath,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::CheckPath,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::CheckPath,
+    SyscallAction::Unspecified,
+    SyscallAction::CheckPath,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::CheckPath,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Deny,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+    SyscallAction::Allow,
+    SyscallAction::Unspecified,
+    SyscallAction::Unspecified,
+    SyscallAction::CheckPath,
+    SyscallAction::Unspecified,
+    SyscallAction::Allow,
+};
+
+constexpr ProfileActions actions[] = {
+    { "i386", actions_i386, 442 },
+    { "x86_64", actions_x86_64, 442 },
+};
+
+}
+
+const InvokerProfile linux_go_profile = {
+    "linux_go", SyscallAction::Security, PathAccess::Denied,
+    { syscalls, 108 },
+    { paths, 32 },
+    { actions, 2 },
+    nullptr,
+    256,
+};
@@ -0,0 +1,10 @@
+// This file is generated automatically. Any changes will be lost!
+
+#ifndef _PROFILE_LINUX_JAVA_INCLUDED_
+#define _PROFILE_LINUX_JAVA_INCLUDED_
+
+#include "InvokerProfile.hpp"
+
+extern const InvokerProfile linux_java_profile;
+
+#endif // _PROFILE_LINUX_JAVA_INCLUDED_
@@ -0,0 +1,10 @@
+// This file is generated automatically. Any changes will be lost!
+
+#ifndef _PROFILE_LINUX_NODE_INCLUDED_
+#define _PROFILE_LINUX_NODE_INCLUDED_
+
+#include "InvokerProfile.hpp"
+
+extern const InvokerProfile linux_node_profile;
+
+#endif // _PROFILE_LINUX_NODE_INCLUDED_
@@ -1,10 +1,20 @@
 // This file is generated automatically. Any changes will be lost!
 #include "profiles/linux_nosecurity.hpp"
 
+namespace {
+
+constexpr ProfileActions actions[] = {
+    { "i386", nullptr, 0 },
+    { "x86_64", nullptr, 0 },
+};
+
+}
+
 const InvokerProfile linux_nosecurity_profile = {
     "linux_nosecurity", SyscallAction::Allow, PathAccess::ReadWrite,
-    {
-    },
-    {
-    },
+    { nullptr, 0 },
+    { nullptr, 0 },
+    { actions, 2 },
+    nullptr,
+    0,
 };
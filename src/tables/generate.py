@@ -4,6 +4,52 @@
 tables = ["linux_i386", "linux_x86_64"]
 
 
+def fnv_hash(seed, name):
+    # keep in sync with syscallNameHash() in SyscallTable.hpp
+    h = seed if seed else 0x01000193
+    for c in name.encode():
+        h = ((h * 0x01000193) ^ c) & 0xffffffff
+    return h
+
+
+def perfect_hash(names):
+    # hash and displace: every bucket of the first level hash gets a seed that
+    # moves all of its names into free slots, single name buckets point to a slot directly
+    size = len(names)
+    buckets = [[] for _ in range(size)]
+    for name in names:
+        buckets[fnv_hash(0, name) % size].append(name)
+
+    displacements = [0] * size
+    slots = [None] * size
+
+    order = sorted(range(size), key=lambda b: len(buckets[b]), reverse=True)
+    for b in order:
+        bucket = buckets[b]
+        if len(bucket) <= 1:
+            break
+        seed = 1
+        while True:
+            taken = [fnv_hash(seed, name) % size for name in bucket]
+            if len(set(taken)) == len(taken) and all(slots[s] is None for s in taken):
+                break
+            seed += 1
+        for slot, name in zip(taken, bucket):
+            slots[slot] = name
+        displacements[b] = seed
+
+    free = [s for s in range(size) if slots[s] is None]
+    for b in order:
+        bucket = buckets[b]
+        if len(bucket) != 1:
+            continue
+        slot = free.pop()
+        slots[slot] = bucket[0]
+        displacements[b] = -slot - 1
+
+    return displacements, slots
+
+
 def gen(name):
     table = []
     with open(name + ".tbl") as f:
@@ -11,17 +57,43 @@ def gen(name):
             num, syscall = line.split()
             table.append((int(num), syscall))
 
+    count = max(num for num, _ in table) + 1
+    names = [None] * count
+    numbers = {}
+    for num, syscall in table:
+        names[num] = syscall
+        numbers[syscall] = num
+
+    displacements, slots = perfect_hash(list(numbers))
+
     with open(name + ".cpp", "w") as f:
         print("// This file is generated automatically. Any changes will be lost!", file=f)
         print("#include \"tables/%s.hpp\"" % name, file=f)
         print(file=f)
 
-        print("const SyscallTable %s_table = {" % (name), file=f)
-        for num, syscall in table:
-            print("    { \"%s\", %d }," % (syscall, num), file=f)
+        print("namespace {", file=f)
+        print(file=f)
+        print("constexpr const char *names[] = {", file=f)
+        for syscall in names:
+            print("    %s," % ("\"%s\"" % syscall if syscall else "nullptr"), file=f)
         print("};", file=f)
-
         print(file=f)
+        print("constexpr int32_t hashDisplacements[] = {", file=f)
+        for d in displacements:
+            print("    %d," % d, file=f)
+        print("};", file=f)
+        print(file=f)
+        print("constexpr int16_t hashSlots[] = {", file=f)
+        for syscall in slots:
+            print("    %d, // %s" % (numbers[syscall], syscall), file=f)
+        print("};", file=f)
+        print(file=f)
+        print("}", file=f)
+        print(file=f)
+
+        print("const SyscallTable %s_table = {" % name, file=f)
+        print("    names, %d, hashDisplacements, hashSlots, %d," % (count, len(slots)), file=f)
+        print("};", file=f)
 
     with open(name + ".hpp", "w") as f:
         guard = "_TABLE_{}_INCLUDED_".format(name.upper())
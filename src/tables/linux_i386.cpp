@@ -1,387 +1,1386 @@
 // This file is generated automatically. Any changes will be lost!
 #include "tables/linux_i386.hpp"
 
-const SyscallTable linux_i386_table = {
-    { "restart_syscall", 0 },
-    { "exit", 1 },
-    { "fork", 2 },
-    { "read", 3 },
-    { "write", 4 },
-    { "open", 5 },
-    { "close", 6 },
-    { "waitpid", 7 },
-    { "creat", 8 },
-    { "link", 9 },
-    { "unlink", 10 },
-    { "execve", 11 },
-    { "chdir", 12 },
-    { "time", 13 },
-    { "mknod", 14 },
-    { "chmod", 15 },
-    { "lchown", 16 },
-    { "break", 17 },
-    { "oldstat", 18 },
-    { "lseek", 19 },
-    { "getpid", 20 },
-    { "mount", 21 },
-    { "umount", 22 },
-    { "setuid", 23 },
-    { "getuid", 24 },
-    { "stime", 25 },
-    { "ptrace", 26 },
-    { "alarm", 27 },
-    { "oldfstat", 28 },
-    { "pause", 29 },
-    { "utime", 30 },
-    { "stty", 31 },
-    { "gtty", 32 },
-    { "access", 33 },
-    { "nice", 34 },
-    { "ftime", 35 },
-    { "sync", 36 },
-    { "kill", 37 },
-    { "rename", 38 },
-    { "mkdir", 39 },
-    { "rmdir", 40 },
-    { "dup", 41 },
-    { "pipe", 42 },
-    { "times", 43 },
-    { "prof", 44 },
-    { "brk", 45 },
-    { "setgid", 46 },
-    { "getgid", 47 },
-    { "signal", 48 },
-    { "geteuid", 49 },
-    { "getegid", 50 },
-    { "acct", 51 },
-    { "umount2", 52 },
-    { "lock", 53 },
-    { "ioctl", 54 },
-    { "fcntl", 55 },
-    { "mpx", 56 },
-    { "setpgid", 57 },
-    { "ulimit", 58 },
-    { "oldolduname", 59 },
-    { "umask", 60 },
-    { "chroot", 61 },
-    { "ustat", 62 },
-    { "dup2", 63 },
-    { "getppid", 64 },
-    { "getpgrp", 65 },
-    { "setsid", 66 },
-    { "sigaction", 67 },
-    { "sgetmask", 68 },
-    { "ssetmask", 69 },
-    { "setreuid", 70 },
-    { "setregid", 71 },
-    { "sigsuspend", 72 },
-    { "sigpending", 73 },
-    { "sethostname", 74 },
-    { "setrlimit", 75 },
-    { "getrlimit", 76 },
-    { "getrusage", 77 },
-    { "gettimeofday", 78 },
-    { "settimeofday", 79 },
-    { "getgroups", 80 },
-    { "setgroups", 81 },
-    { "select", 82 },
-    { "symlink", 83 },
-    { "oldlstat", 84 },
-    { "readlink", 85 },
-    { "uselib", 86 },
-    { "swapon", 87 },
-    { "reboot", 88 },
-    { "readdir", 89 },
-    { "mmap", 90 },
-    { "munmap", 91 },
-    { "truncate", 92 },
-    { "ftruncate", 93 },
-    { "fchmod", 94 },
-    { "fchown", 95 },
-    { "getpriority", 96 },
-    { "setpriority", 97 },
-    { "profil", 98 },
-    { "statfs", 99 },
-    { "fstatfs", 100 },
-    { "ioperm", 101 },
-    { "socketcall", 102 },
-    { "syslog", 103 },
-    { "setitimer", 104 },
-    { "getitimer", 105 },
-    { "stat", 106 },
-    { "lstat", 107 },
-    { "fstat", 108 },
-    { "olduname", 109 },
-    { "iopl", 110 },
-    { "vhangup", 111 },
-    { "idle", 112 },
-    { "vm86old", 113 },
-    { "wait4", 114 },
-    { "swapoff", 115 },
-    { "sysinfo", 116 },
-    { "ipc", 117 },
-    { "fsync", 118 },
-    { "sigreturn", 119 },
-    { "clone", 120 },
-    { "setdomainname", 121 },
-    { "uname", 122 },
-    { "modify_ldt", 123 },
-    { "adjtimex", 124 },
-    { "mprotect", 125 },
-    { "sigprocmask", 126 },
-    { "create_module", 127 },
-    { "init_module", 128 },
-    { "delete_module", 129 },
-    { "get_kernel_syms", 130 },
-    { "quotactl", 131 },
-    { "getpgid", 132 },
-    { "fchdir", 133 },
-    { "bdflush", 134 },
-    { "sysfs", 135 },
-    { "personality", 136 },
-    { "afs_syscall", 137 },
-    { "setfsuid", 138 },
-    { "setfsgid", 139 },
-    { "_llseek", 140 },
-    { "getdents", 141 },
-    { "_newselect", 142 },
-    { "flock", 143 },
-    { "msync", 144 },
-    { "readv", 145 },
-    { "writev", 146 },
-    { "getsid", 147 },
-    { "fdatasync", 148 },
-    { "_sysctl", 149 },
-    { "mlock", 150 },
-    { "munlock", 151 },
-    { "mlockall", 152 },
-    { "munlockall", 153 },
-    { "sched_setparam", 154 },
-    { "sched_getparam", 155 },
-    { "sched_setscheduler", 156 },
-    { "sched_getscheduler", 157 },
-    { "sched_yield", 158 },
-    { "sched_get_priority_max", 159 },
-    { "sched_get_priority_min", 160 },
-    { "sched_rr_get_interval", 161 },
-    { "nanosleep", 162 },
-    { "mremap", 163 },
-    { "setresuid", 164 },
-    { "getresuid", 165 },
-    { "vm86", 166 },
-    { "query_module", 167 },
-    { "poll", 168 },
-    { "nfsservctl", 169 },
-    { "setresgid", 170 },
-    { "getresgid", 171 },
-    { "prctl", 172 },
-    { "rt_sigreturn", 173 },
-    { "rt_sigaction", 174 },
-    { "rt_sigprocmask", 175 },
-    { "rt_sigpending", 176 },
-    { "rt_sigtimedwait", 177 },
-    { "rt_sigqueueinfo", 178 },
-    { "rt_sigsuspend", 179 },
-    { "pread64", 180 },
-    { "pwrite64", 181 },
-    { "chown", 182 },
-    { "getcwd", 183 },
-    { "capget", 184 },
-    { "capset", 185 },
-    { "sigaltstack", 186 },
-    { "sendfile", 187 },
-    { "getpmsg", 188 },
-    { "putpmsg", 189 },
-    { "vfork", 190 },
-    { "ugetrlimit", 191 },
-    { "mmap2", 192 },
-    { "truncate64", 193 },
-    { "ftruncate64", 194 },
-    { "stat64", 195 },
-    { "lstat64", 196 },
-    { "fstat64", 197 },
-    { "lchown32", 198 },
-    { "getuid32", 199 },
-    { "getgid32", 200 },
-    { "geteuid32", 201 },
-    { "getegid32", 202 },
-    { "setreuid32", 203 },
-    { "setregid32", 204 },
-    { "getgroups32", 205 },
-    { "setgroups32", 206 },
-    { "fchown32", 207 },
-    { "setresuid32", 208 },
-    { "getresuid32", 209 },
-    { "setresgid32", 210 },
-    { "getresgid32", 211 },
-    { "chown32", 212 },
-    { "setuid32", 213 },
-    { "setgid32", 214 },
-    { "setfsuid32", 215 },
-    { "setfsgid32", 216 },
-    { "pivot_root", 217 },
-    { "mincore", 218 },
-    { "madvise", 219 },
-    { "getdents64", 220 },
-    { "fcntl64", 221 },
-    { "gettid", 224 },
-    { "readahead", 225 },
-    { "setxattr", 226 },
-    { "lsetxattr", 227 },
-    { "fsetxattr", 228 },
-    { "getxattr", 229 },
-    { "lgetxattr", 230 },
-    { "fgetxattr", 231 },
-    { "listxattr", 232 },
-    { "llistxattr", 233 },
-    { "flistxattr", 234 },
-    { "removexattr", 235 },
-    { "lremovexattr", 236 },
-    { "fremovexattr", 237 },
-    { "tkill", 238 },
-    { "sendfile64", 239 },
-    { "futex", 240 },
-    { "sched_setaffinity", 241 },
-    { "sched_getaffinity", 242 },
-    { "set_thread_area", 243 },
-    { "get_thread_area", 244 },
-    { "io_setup", 245 },
-    { "io_destroy", 246 },
-    { "io_getevents", 247 },
-    { "io_submit", 248 },
-    { "io_cancel", 249 },
-    { "fadvise64", 250 },
-    { "exit_group", 252 },
-    { "lookup_dcookie", 253 },
-    { "epoll_create", 254 },
-    { "epoll_ctl", 255 },
-    { "epoll_wait", 256 },
-    { "remap_file_pages", 257 },
-    { "set_tid_address", 258 },
-    { "timer_create", 259 },
-    { "timer_settime", 260 },
-    { "timer_gettime", 261 },
-    { "timer_getoverrun", 262 },
-    { "timer_delete", 263 },
-    { "clock_settime", 264 },
-    { "clock_gettime", 265 },
-    { "clock_getres", 266 },
-    { "clock_nanosleep", 267 },
-    { "statfs64", 268 },
-    { "fstatfs64", 269 },
-    { "tgkill", 270 },
-    { "utimes", 271 },
-    { "fadvise64_64", 272 },
-    { "vserver", 273 },
-    { "mbind", 274 },
-    { "get_mempolicy", 275 },
-    { "set_mempolicy", 276 },
-    { "mq_open", 277 },
-    { "mq_unlink", 278 },
-    { "mq_timedsend", 279 },
-    { "mq_timedreceive", 280 },
-    { "mq_notify", 281 },
-    { "mq_getsetattr", 282 },
-    { "sys_kexec_load", 283 },
-    { "waitid", 284 },
-    { "add_key", 286 },
-    { "request_key", 287 },
-    { "keyctl", 288 },
-    { "ioprio_set", 289 },
-    { "ioprio_get", 290 },
-    { "inotify_init", 291 },
-    { "inotify_add_watch", 292 },
-    { "inotify_rm_watch", 293 },
-    { "migrate_pages", 294 },
-    { "openat", 295 },
-    { "mkdirat", 296 },
-    { "mknodat", 297 },
-    { "fchownat", 298 },
-    { "futimesat", 299 },
-    { "fstatat64", 300 },
-    { "unlinkat", 301 },
-    { "renameat", 302 },
-    { "linkat", 303 },
-    { "symlinkat", 304 },
-    { "readlinkat", 305 },
-    { "fchmodat", 306 },
-    { "faccessat", 307 },
-    { "pselect6", 308 },
-    { "ppoll", 309 },
-    { "unshare", 310 },
-    { "set_robust_list", 311 },
-    { "get_robust_list", 312 },
-    { "splice", 313 },
-    { "sync_file_range", 314 },
-    { "tee", 315 },
-    { "vmsplice", 316 },
-    { "move_pages", 317 },
-    { "getcpu", 318 },
-    { "epoll_pwait", 319 },
-    { "utimensat", 320 },
-    { "signalfd", 321 },
-    { "timerfd", 322 },
-    { "eventfd", 323 },
-    { "fallocate", 324 },
-    { "timerfd_settime", 325 },
-    { "timerfd_gettime", 326 },
-    { "signalfd4", 327 },
-    { "eventfd2", 328 },
-    { "epoll_create1", 329 },
-    { "dup3", 330 },
-    { "pipe2", 331 },
-    { "inotify_init1", 332 },
-    { "preadv", 333 },
-    { "pwritev", 334 },
-    { "rt_tgsigqueueinfo", 335 },
-    { "perf_event_open", 336 },
-    { "recvmmsg", 337 },
-    { "fanotify_init", 338 },
-    { "fanotify_mark", 339 },
-    { "prlimit64", 340 },
-    { "name_to_handle_at", 341 },
-    { "open_by_handle_at", 342 },
-    { "clock_adjtime", 343 },
-    { "syncfs", 344 },
-    { "sendmmsg", 345 },
-    { "setns", 346 },
-    { "process_vm_readv", 347 },
-    { "process_vm_writev", 348 },
-    { "kcmp", 349 },
-    { "finit_module", 350 },
-    { "sched_setattr", 351 },
-    { "sched_getattr", 352 },
-    { "renameat2", 353 },
-    { "seccomp", 354 },
-    { "getrandom", 355 },
-    { "memfd_create", 356 },
-    { "bpf", 357 },
-    { "execveat", 358 },
-    { "socket", 359 },
-    { "socketpair", 360 },
-    { "bind", 361 },
-    { "connect", 362 },
-    { "listen", 363 },
-    { "accept4", 364 },
-    { "getsockopt", 365 },
-    { "setsockopt", 366 },
-    { "getsockname", 367 },
-    { "getpeername", 368 },
-    { "sendto", 369 },
-    { "sendmsg", 370 },
-    { "recvfrom", 371 },
-    { "recvmsg", 372 },
-    { "shutdown", 373 },
-    { "userfaultfd", 374 },
-    { "membarrier", 375 },
-    { "mlock2", 376 },
-    { "copy_file_range", 377 },
-    { "preadv2", 378 },
-    { "pwritev2", 379 },
-    { "pkey_mprotect", 380 },
-    { "pkey_alloc", 381 },
-    { "pkey_free", 382 },
-    { "statx", 383 },
-    { "arch_prctl", 384 },
+namespace {
+
+constexpr const char *names[] = {
+    "restart_syscall",
+    "exit",
+    "fork",
+    "read",
+    "write",
+    "open",
+    "close",
+    "waitpid",
+    "creat",
+    "link",
+    "unlink",
+    "execve",
+    "chdir",
+    "time",
+    "mknod",
+    "chmod",
+    "lchown",
+    "break",
+    "oldstat",
+    "lseek",
+    "getpid",
+    "mount",
+    "umount",
+    "setuid",
+    "getuid",
+    "stime",
+    "ptrace",
+    "alarm",
+    "oldfstat",
+    "pause",
+    "utime",
+    "stty",
+    "gtty",
+    "access",
+    "nice",
+    "ftime",
+    "sync",
+    "kill",
+    "rename",
+    "mkdir",
+    "rmdir",
+    "dup",
+    "pipe",
+    "times",
+    "prof",
+    "brk",
+    "setgid",
+    "getgid",
+    "signal",
+    "geteuid",
+    "getegid",
+    "acct",
+    "umount2",
+    "lock",
+    "ioctl",
+    "fcntl",
+    "mpx",
+    "setpgid",
+    "ulimit",
+    "oldolduname",
+    "umask",
+    "chroot",
+    "ustat",
+    "dup2",
+    "getppid",
+    "getpgrp",
+    "setsid",
+    "sigaction",
+    "sgetmask",
+    "ssetmask",
+    "setreuid",
+    "setregid",
+    "sigsuspend",
+    "sigpending",
+    "sethostname",
+    "setrlimit",
+    "getrlimit",
+    "getrusage",
+    "gettimeofday",
+    "settimeofday",
+    "getgroups",
+    "setgroups",
+    "select",
+    "symlink",
+    "oldlstat",
+    "readlink",
+    "uselib",
+    "swapon",
+    "reboot",
+    "readdir",
+    "mmap",
+    "munmap",
+    "truncate",
+    "ftruncate",
+    "fchmod",
+    "fchown",
+    "getpriority",
+    "setpriority",
+    "profil",
+    "statfs",
+    "fstatfs",
+    "ioperm",
+    "socketcall",
+    "syslog",
+    "setitimer",
+    "getitimer",
+    "stat",
+    "lstat",
+    "fstat",
+    "olduname",
+    "iopl",
+    "vhangup",
+    "idle",
+    "vm86old",
+    "wait4",
+    "swapoff",
+    "sysinfo",
+    "ipc",
+    "fsync",
+    "sigreturn",
+    "clone",
+    "setdomainname",
+    "uname",
+    "modify_ldt",
+    "adjtimex",
+    "mprotect",
+    "sigprocmask",
+    "create_module",
+    "init_module",
+    "delete_module",
+    "get_kernel_syms",
+    "quotactl",
+    "getpgid",
+    "fchdir",
+    "bdflush",
+    "sysfs",
+    "personality",
+    "afs_syscall",
+    "setfsuid",
+    "setfsgid",
+    "_llseek",
+    "getdents",
+    "_newselect",
+    "flock",
+    "msync",
+    "readv",
+    "writev",
+    "getsid",
+    "fdatasync",
+    "_sysctl",
+    "mlock",
+    "munlock",
+    "mlockall",
+    "munlockall",
+    "sched_setparam",
+    "sched_getparam",
+    "sched_setscheduler",
+    "sched_getscheduler",
+    "sched_yield",
+    "sched_get_priority_max",
+    "sched_get_priority_min",
+    "sched_rr_get_interval",
+    "nanosleep",
+    "mremap",
+    "setresuid",
+    "getresuid",
+    "vm86",
+    "query_module",
+    "poll",
+    "nfsservctl",
+    "setresgid",
+    "getresgid",
+    "prctl",
+    "rt_sigreturn",
+    "rt_sigaction",
+    "rt_sigprocmask",
+    "rt_sigpending",
+    "rt_sigtimedwait",
+    "rt_sigqueueinfo",
+    "rt_sigsuspend",
+    "pread64",
+    "pwrite64",
+    "chown",
+    "getcwd",
+    "capget",
+    "capset",
+    "sigaltstack",
+    "sendfile",
+    "getpmsg",
+    "putpmsg",
+    "vfork",
+    "ugetrlimit",
+    "mmap2",
+    "truncate64",
+    "ftruncate64",
+    "stat64",
+    "lstat64",
+    "fstat64",
+    "lchown32",
+    "getuid32",
+    "getgid32",
+    "geteuid32",
+    "getegid32",
+    "setreuid32",
+    "setregid32",
+    "getgroups32",
+    "setgroups32",
+    "fchown32",
+    "setresuid32",
+    "getresuid32",
+    "setresgid32",
+    "getresgid32",
+    "chown32",
+    "setuid32",
+    "setgid32",
+    "setfsuid32",
+    "setfsgid32",
+    "pivot_root",
+    "mincore",
+    "madvise",
+    "getdents64",
+    "fcntl64",
+    nullptr,
+    nullptr,
+    "gettid",
+    "readahead",
+    "setxattr",
+    "lsetxattr",
+    "fsetxattr",
+    "getxattr",
+    "lgetxattr",
+    "fgetxattr",
+    "listxattr",
+    "llistxattr",
+    "flistxattr",
+    "removexattr",
+    "lremovexattr",
+    "fremovexattr",
+    "tkill",
+    "sendfile64",
+    "futex",
+    "sched_setaffinity",
+    "sched_getaffinity",
+    "set_thread_area",
+    "get_thread_area",
+    "io_setup",
+    "io_destroy",
+    "io_getevents",
+    "io_submit",
+    "io_cancel",
+    "fadvise64",
+    nullptr,
+    "exit_group",
+    "lookup_dcookie",
+    "epoll_create",
+    "epoll_ctl",
+    "epoll_wait",
+    "remap_file_pages",
+    "set_tid_address",
+    "timer_create",
+    "timer_settime",
+    "timer_gettime",
+    "timer_getoverrun",
+    "timer_delete",
+    "clock_settime",
+    "clock_gettime",
+    "clock_getres",
+    "clock_nanosleep",
+    "statfs64",
+    "fstatfs64",
+    "tgkill",
+    "utimes",
+    "fadvise64_64",
+    "vserver",
+    "mbind",
+    "get_mempolicy",
+    "set_mempolicy",
+    "mq_open",
+    "mq_unlink",
+    "mq_timedsend",
+    "mq_timedreceive",
+    "mq_notify",
+    "mq_getsetattr",
+    "sys_kexec_load",
+    "waitid",
+    nullptr,
+    "add_key",
+    "request_key",
+    "keyctl",
+    "ioprio_set",
+    "ioprio_get",
+    "inotify_init",
+    "inotify_add_watch",
+    "inotify_rm_watch",
+    "migrate_pages",
+    "openat",
+    "mkdirat",
+    "mknodat",
+    "fchownat",
+    "futimesat",
+    "fstatat64",
+    "unlinkat",
+    "renameat",
+    "linkat",
+    "symlinkat",
+    "readlinkat",
+    "fchmodat",
+    "faccessat",
+    "pselect6",
+    "ppoll",
+    "unshare",
+    "set_robust_list",
+    "get_robust_list",
+    "splice",
+    "sync_file_range",
+    "tee",
+    "vmsplice",
+    "move_pages",
+    "getcpu",
+    "epoll_pwait",
+    "utimensat",
+    "signalfd",
+    "timerfd",
+    "eventfd",
+    "fallocate",
+    "timerfd_settime",
+    "timerfd_gettime",
+    "signalfd4",
+    "eventfd2",
+    "epoll_create1",
+    "dup3",
+    "pipe2",
+    "inotify_init1",
+    "preadv",
+    "pwritev",
+    "rt_tgsigqueueinfo",
+    "perf_event_open",
+    "recvmmsg",
+    "fanotify_init",
+    "fanotify_mark",
+    "prlimit64",
+    "name_to_handle_at",
+    "open_by_handle_at",
+    "clock_adjtime",
+    "syncfs",
+    "sendmmsg",
+    "setns",
+    "process_vm_readv",
+    "process_vm_writev",
+    "kcmp",
+    "finit_module",
+    "sched_setattr",
+    "sched_getattr",
+    "renameat2",
+    "seccomp",
+    "getrandom",
+    "memfd_create",
+    "bpf",
+    "execveat",
+    "socket",
+    "socketpair",
+    "bind",
+    "connect",
+    "listen",
+    "accept4",
+    "getsockopt",
+    "setsockopt",
+    "getsockname",
+    "getpeername",
+    "sendto",
+    "sendmsg",
+    "recvfrom",
+    "recvmsg",
+    "shutdown",
+    "userfaultfd",
+    "membarrier",
+    "mlock2",
+    "copy_file_range",
+    "preadv2",
+    "pwritev2",
+    "pkey_mprotect",
+    "pkey_alloc",
+    "pkey_free",
+    "statx",
+    "arch_prctl",
+    "io_pgetevents",
+    "rseq",
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    "semget",
+    "semctl",
+    "shmget",
+    "shmctl",
+    "shmat",
+    "shmdt",
+    "msgget",
+    "msgsnd",
+    "msgrcv",
+    "msgctl",
+    "clock_gettime64",
+    "clock_settime64",
+    "clock_adjtime64",
+    "clock_getres_time64",
+    "clock_nanosleep_time64",
+    "timer_gettime64",
+    "timer_settime64",
+    "timerfd_gettime64",
+    "timerfd_settime64",
+    "utimensat_time64",
+    "pselect6_time64",
+    "ppoll_time64",
+    nullptr,
+    "io_pgetevents_time64",
+    "recvmmsg_time64",
+    "mq_timedsend_time64",
+    "mq_timedreceive_time64",
+    "semtimedop_time64",
+    "rt_sigtimedwait_time64",
+    "futex_time64",
+    "sched_rr_get_interval_time64",
+    "pidfd_send_signal",
+    "io_uring_setup",
+    "io_uring_enter",
+    "io_uring_register",
+    "open_tree",
+    "move_mount",
+    "fsopen",
+    "fsconfig",
+    "fsmount",
+    "fspick",
+    "pidfd_open",
+    "clone3",
+    "close_range",
+    "openat2",
+    "pidfd_getfd",
+    "faccessat2",
+    "process_madvise",
+    "epoll_pwait2",
+    "mount_setattr",
+    "quotactl_fd",
+    "landlock_create_ruleset",
+    "landlock_add_rule",
+    "landlock_restrict_self",
+    "memfd_secret",
+    "process_mrelease",
+    "futex_waitv",
+    "set_mempolicy_home_node",
+    "cachestat",
+    "fchmodat2",
+    "map_shadow_stack",
+    "futex_wake",
+    "futex_wait",
+    "futex_requeue",
+    "statmount",
+    "listmount",
+    "lsm_get_self_attr",
+    "lsm_set_self_attr",
+    "lsm_list_modules",
+    "mseal",
 };
 
+constexpr int32_t hashDisplacements[] = {
+    1,
+    1,
+    -451,
+    -448,
+    0,
+    0,
+    -440,
+    0,
+    0,
+    0,
+    -435,
+    0,
+    0,
+    1,
+    -433,
+    0,
+    -432,
+    4,
+    0,
+    -428,
+    4,
+    0,
+    0,
+    -427,
+    1,
+    0,
+    0,
+    -425,
+    -422,
+    -419,
+    0,
+    0,
+    0,
+    0,
+    0,
+    -411,
+    -410,
+    -409,
+    -407,
+    -405,
+    -404,
+    -403,
+    2,
+    -395,
+    -393,
+    -389,
+    -384,
+    -379,
+    0,
+    0,
+    0,
+    -377,
+    0,
+    -375,
+    -373,
+    -368,
+    0,
+    1,
+    -366,
+    0,
+    1,
+    0,
+    3,
+    2,
+    -364,
+    -360,
+    0,
+    0,
+    -358,
+    0,
+    1,
+    0,
+    0,
+    0,
+    0,
+    0,
+    1,
+    -357,
+    1,
+    1,
+    -356,
+    1,
+    0,
+    1,
+    1,
+    1,
+    -354,
+    1,
+    0,
+    1,
+    -352,
+    -347,
+    1,
+    0,
+    0,
+    -342,
+    -341,
+    0,
+    -340,
+    1,
+    -335,
+    -326,
+    1,
+    0,
+    0,
+    0,
+    0,
+    3,
+    0,
+    0,
+    0,
+    1,
+    2,
+    -323,
+    0,
+    0,
+    2,
+    -322,
+    0,
+    0,
+    -319,
+    -315,
+    1,
+    1,
+    -314,
+    -313,
+    0,
+    -312,
+    1,
+    -311,
+    0,
+    -310,
+    -308,
+    0,
+    1,
+    0,
+    0,
+    0,
+    0,
+    1,
+    2,
+    0,
+    -304,
+    0,
+    0,
+    2,
+    0,
+    1,
+    2,
+    -302,
+    1,
+    1,
+    0,
+    0,
+    -297,
+    3,
+    -296,
+    -295,
+    0,
+    0,
+    -286,
+    0,
+    -280,
+    1,
+    -279,
+    -277,
+    0,
+    -276,
+    -275,
+    0,
+    0,
+    -273,
+    -272,
+    0,
+    -269,
+    -267,
+    -265,
+    0,
+    -262,
+    3,
+    2,
+    0,
+    0,
+    -261,
+    1,
+    1,
+    2,
+    -260,
+    0,
+    2,
+    -258,
+    4,
+    0,
+    0,
+    0,
+    1,
+    0,
+    0,
+    1,
+    0,
+    0,
+    0,
+    -256,
+    -249,
+    1,
+    -241,
+    -237,
+    7,
+    0,
+    -229,
+    1,
+    1,
+    3,
+    2,
+    2,
+    -227,
+    -226,
+    -224,
+    0,
+    -222,
+    0,
+    0,
+    -221,
+    0,
+    -219,
+    1,
+    2,
+    0,
+    0,
+    2,
+    1,
+    4,
+    -215,
+    -214,
+    0,
+    0,
+    -213,
+    3,
+    -210,
+    1,
+    -207,
+    9,
+    -206,
+    1,
+    0,
+    0,
+    0,
+    -205,
+    -204,
+    0,
+    -200,
+    0,
+    0,
+    -199,
+    -196,
+    0,
+    -194,
+    -191,
+    0,
+    3,
+    -190,
+    -189,
+    0,
+    -184,
+    1,
+    -183,
+    1,
+    0,
+    0,
+    1,
+    2,
+    0,
+    -180,
+    22,
+    0,
+    0,
+    -179,
+    1,
+    0,
+    0,
+    3,
+    0,
+    0,
+    -175,
+    0,
+    0,
+    -174,
+    0,
+    -173,
+    3,
+    -172,
+    0,
+    -171,
+    0,
+    0,
+    0,
+    0,
+    -169,
+    -167,
+    3,
+    -166,
+    0,
+    0,
+    1,
+    0,
+    -165,
+    -157,
+    0,
+    -155,
+    1,
+    0,
+    0,
+    -147,
+    6,
+    2,
+    -146,
+    -141,
+    -140,
+    0,
+    -137,
+    0,
+    -136,
+    0,
+    2,
+    -133,
+    2,
+    0,
+    0,
+    2,
+    13,
+    5,
+    0,
+    -132,
+    0,
+    -131,
+    -128,
+    0,
+    -127,
+    -123,
+    1,
+    2,
+    0,
+    2,
+    -122,
+    -121,
+    8,
+    -120,
+    -119,
+    -114,
+    -112,
+    3,
+    -109,
+    -106,
+    -99,
+    0,
+    0,
+    -96,
+    0,
+    -95,
+    -94,
+    -91,
+    -88,
+    1,
+    0,
+    1,
+    0,
+    0,
+    0,
+    -86,
+    -85,
+    -83,
+    0,
+    7,
+    7,
+    -81,
+    -78,
+    2,
+    2,
+    0,
+    0,
+    -74,
+    -71,
+    1,
+    1,
+    -67,
+    -61,
+    4,
+    0,
+    -60,
+    -59,
+    6,
+    -58,
+    3,
+    0,
+    -56,
+    0,
+    -52,
+    -51,
+    1,
+    2,
+    -50,
+    33,
+    0,
+    -46,
+    -45,
+    3,
+    0,
+    -43,
+    0,
+    -40,
+    1,
+    -39,
+    0,
+    0,
+    -38,
+    -36,
+    0,
+    1,
+    -35,
+    -34,
+    1,
+    14,
+    -31,
+    12,
+    0,
+    0,
+    -29,
+    0,
+    -25,
+    -24,
+    3,
+    -23,
+    -22,
+    -20,
+    -18,
+    0,
+    0,
+    8,
+    0,
+    -17,
+    11,
+    2,
+    5,
+    0,
+    -15,
+    0,
+    22,
+    0,
+    -14,
+    -8,
+    10,
+    -3,
+};
+
+constexpr int16_t hashSlots[] = {
+    36, // sync
+    118, // fsync
+    9, // link
+    348, // process_vm_writev
+    275, // get_mempolicy
+    132, // getpgid
+    294, // migrate_pages
+    96, // getpriority
+    50, // getegid
+    43, // times
+    323, // eventfd
+    112, // idle
+    457, // statmount
+    411, // timerfd_settime64
+    65, // getpgrp
+    376, // mlock2
+    422, // futex_time64
+    454, // futex_wake
+    358, // execveat
+    212, // chown32
+    227, // lsetxattr
+    70, // setreuid
+    400, // msgsnd
+    402, // msgctl
+    155, // sched_getparam
+    130, // get_kernel_syms
+    279, // mq_timedsend
+    413, // pselect6_time64
+    312, // get_robust_list
+    409, // timer_settime64
+    258, // set_tid_address
+    455, // futex_wait
+    233, // llistxattr
+    12, // chdir
+    458, // listmount
+    404, // clock_settime64
+    77, // getrusage
+    225, // readahead
+    5, // open
+    179, // rt_sigsuspend
+    231, // fgetxattr
+    344, // syncfs
+    296, // mkdirat
+    339, // fanotify_mark
+    35, // ftime
+    2, // fork
+    170, // setresgid
+    243, // set_thread_area
+    86, // uselib
+    300, // fstatat64
+    256, // epoll_wait
+    154, // sched_setparam
+    161, // sched_rr_get_interval
+    116, // sysinfo
+    81, // setgroups
+    14, // mknod
+    462, // mseal
+    147, // getsid
+    412, // utimensat_time64
+    405, // clock_adjtime64
+    451, // cachestat
+    67, // sigaction
+    10, // unlink
+    446, // landlock_restrict_self
+    349, // kcmp
+    240, // futex
+    381, // pkey_alloc
+    106, // stat
+    153, // munlockall
+    216, // setfsgid32
+    150, // mlock
+    340, // prlimit64
+    125, // mprotect
+    219, // madvise
+    128, // init_module
+    124, // adjtimex
+    226, // setxattr
+    421, // rt_sigtimedwait_time64
+    250, // fadvise64
+    78, // gettimeofday
+    21, // mount
+    47, // getgid
+    228, // fsetxattr
+    352, // sched_getattr
+    247, // io_getevents
+    423, // sched_rr_get_interval_time64
+    103, // syslog
+    122, // uname
+    34, // nice
+    214, // setgid32
+    142, // _newselect
+    59, // oldolduname
+    119, // sigreturn
+    328, // eventfd2
+    126, // sigprocmask
+    338, // fanotify_init
+    321, // signalfd
+    329, // epoll_create1
+    189, // putpmsg
+    439, // faccessat2
+    440, // process_madvise
+    40, // rmdir
+    316, // vmsplice
+    396, // shmctl
+    79, // settimeofday
+    157, // sched_getscheduler
+    224, // gettid
+    134, // bdflush
+    337, // recvmmsg
+    315, // tee
+    198, // lchown32
+    299, // futimesat
+    64, // getppid
+    246, // io_destroy
+    368, // getpeername
+    113, // vm86old
+    136, // personality
+    75, // setrlimit
+    310, // unshare
+    324, // fallocate
+    303, // linkat
+    37, // kill
+    69, // ssetmask
+    101, // ioperm
+    16, // lchown
+    292, // inotify_add_watch
+    38, // rename
+    383, // statx
+    302, // renameat
+    48, // signal
+    162, // nanosleep
+    111, // vhangup
+    200, // getgid32
+    163, // mremap
+    270, // tgkill
+    259, // timer_create
+    180, // pread64
+    159, // sched_get_priority_max
+    186, // sigaltstack
+    33, // access
+    210, // setresgid32
+    24, // getuid
+    84, // oldlstat
+    447, // memfd_secret
+    188, // getpmsg
+    398, // shmdt
+    20, // getpid
+    100, // fstatfs
+    215, // setfsuid32
+    66, // setsid
+    152, // mlockall
+    313, // splice
+    62, // ustat
+    19, // lseek
+    18, // oldstat
+    254, // epoll_create
+    269, // fstatfs64
+    273, // vserver
+    386, // rseq
+    173, // rt_sigreturn
+    268, // statfs64
+    85, // readlink
+    83, // symlink
+    207, // fchown32
+    298, // fchownat
+    181, // pwrite64
+    429, // move_mount
+    29, // pause
+    144, // msync
+    182, // chown
+    55, // fcntl
+    61, // chroot
+    414, // ppoll_time64
+    94, // fchmod
+    1, // exit
+    253, // lookup_dcookie
+    44, // prof
+    25, // stime
+    367, // getsockname
+    334, // pwritev
+    26, // ptrace
+    248, // io_submit
+    165, // getresuid
+    417, // recvmmsg_time64
+    221, // fcntl64
+    158, // sched_yield
+    167, // query_module
+    245, // io_setup
+    332, // inotify_init1
+    261, // timer_gettime
+    278, // mq_unlink
+    364, // accept4
+    378, // preadv2
+    230, // lgetxattr
+    175, // rt_sigprocmask
+    51, // acct
+    442, // mount_setattr
+    184, // capget
+    274, // mbind
+    28, // oldfstat
+    320, // utimensat
+    425, // io_uring_setup
+    286, // add_key
+    89, // readdir
+    304, // symlinkat
+    236, // lremovexattr
+    217, // pivot_root
+    92, // truncate
+    74, // sethostname
+    283, // sys_kexec_load
+    31, // stty
+    297, // mknodat
+    290, // ioprio_get
+    183, // getcwd
+    156, // sched_setscheduler
+    196, // lstat64
+    333, // preadv
+    135, // sysfs
+    17, // break
+    174, // rt_sigaction
+    408, // timer_gettime64
+    375, // membarrier
+    168, // poll
+    293, // inotify_rm_watch
+    369, // sendto
+    260, // timer_settime
+    327, // signalfd4
+    204, // setregid32
+    97, // setpriority
+    206, // setgroups32
+    131, // quotactl
+    241, // sched_setaffinity
+    399, // msgget
+    234, // flistxattr
+    60, // umask
+    110, // iopl
+    138, // setfsuid
+    403, // clock_gettime64
+    4, // write
+    235, // removexattr
+    276, // set_mempolicy
+    282, // mq_getsetattr
+    56, // mpx
+    341, // name_to_handle_at
+    41, // dup
+    7, // waitpid
+    360, // socketpair
+    137, // afs_syscall
+    354, // seccomp
+    434, // pidfd_open
+    418, // mq_timedsend_time64
+    91, // munmap
+    199, // getuid32
+    436, // close_range
+    277, // mq_open
+    372, // recvmsg
+    308, // pselect6
+    109, // olduname
+    127, // create_module
+    73, // sigpending
+    187, // sendfile
+    342, // open_by_handle_at
+    63, // dup2
+    330, // dup3
+    244, // get_thread_area
+    117, // ipc
+    382, // pkey_free
+    249, // io_cancel
+    68, // sgetmask
+    289, // ioprio_set
+    449, // futex_waitv
+    291, // inotify_init
+    356, // memfd_create
+    371, // recvfrom
+    374, // userfaultfd
+    42, // pipe
+    93, // ftruncate
+    309, // ppoll
+    218, // mincore
+    419, // mq_timedreceive_time64
+    208, // setresuid32
+    335, // rt_tgsigqueueinfo
+    57, // setpgid
+    104, // setitimer
+    255, // epoll_ctl
+    355, // getrandom
+    430, // fsopen
+    426, // io_uring_enter
+    350, // finit_module
+    30, // utime
+    121, // setdomainname
+    141, // getdents
+    176, // rt_sigpending
+    385, // io_pgetevents
+    301, // unlinkat
+    322, // timerfd
+    428, // open_tree
+    171, // getresgid
+    139, // setfsgid
+    401, // msgrcv
+    379, // pwritev2
+    432, // fsmount
+    459, // lsm_get_self_attr
+    343, // clock_adjtime
+    450, // set_mempolicy_home_node
+    359, // socket
+    353, // renameat2
+    263, // timer_delete
+    448, // process_mrelease
+    203, // setreuid32
+    435, // clone3
+    384, // arch_prctl
+    87, // swapon
+    397, // shmat
+    239, // sendfile64
+    220, // getdents64
+    373, // shutdown
+    444, // landlock_create_ruleset
+    370, // sendmsg
+    443, // quotactl_fd
+    257, // remap_file_pages
+    265, // clock_gettime
+    460, // lsm_set_self_attr
+    345, // sendmmsg
+    45, // brk
+    160, // sched_get_priority_min
+    172, // prctl
+    211, // getresgid32
+    76, // getrlimit
+    362, // connect
+    351, // sched_setattr
+    288, // keyctl
+    456, // futex_requeue
+    88, // reboot
+    280, // mq_timedreceive
+    32, // gtty
+    395, // shmget
+    197, // fstat64
+    164, // setresuid
+    420, // semtimedop_time64
+    346, // setns
+    3, // read
+    49, // geteuid
+    115, // swapoff
+    416, // io_pgetevents_time64
+    317, // move_pages
+    194, // ftruncate64
+    192, // mmap2
+    95, // fchown
+    133, // fchdir
+    238, // tkill
+    213, // setuid32
+    149, // _sysctl
+    326, // timerfd_gettime
+    424, // pidfd_send_signal
+    431, // fsconfig
+    264, // clock_settime
+    178, // rt_sigqueueinfo
+    305, // readlinkat
+    108, // fstat
+    271, // utimes
+    394, // semctl
+    105, // getitimer
+    266, // clock_getres
+    72, // sigsuspend
+    90, // mmap
+    242, // sched_getaffinity
+    185, // capset
+    8, // creat
+    311, // set_robust_list
+    357, // bpf
+    314, // sync_file_range
+    461, // lsm_list_modules
+    406, // clock_getres_time64
+    318, // getcpu
+    23, // setuid
+    190, // vfork
+    295, // openat
+    22, // umount
+    410, // timerfd_gettime64
+    0, // restart_syscall
+    377, // copy_file_range
+    262, // timer_getoverrun
+    445, // landlock_add_rule
+    71, // setregid
+    195, // stat64
+    205, // getgroups32
+    169, // nfsservctl
+    306, // fchmodat
+    107, // lstat
+    191, // ugetrlimit
+    287, // request_key
+    237, // fremovexattr
+    331, // pipe2
+    52, // umount2
+    319, // epoll_pwait
+    202, // getegid32
+    148, // fdatasync
+    99, // statfs
+    267, // clock_nanosleep
+    53, // lock
+    145, // readv
+    407, // clock_nanosleep_time64
+    114, // wait4
+    438, // pidfd_getfd
+    11, // execve
+    15, // chmod
+    6, // close
+    433, // fspick
+    39, // mkdir
+    427, // io_uring_register
+    453, // map_shadow_stack
+    347, // process_vm_readv
+    272, // fadvise64_64
+    380, // pkey_mprotect
+    98, // profil
+    27, // alarm
+    123, // modify_ldt
+    80, // getgroups
+    441, // epoll_pwait2
+    54, // ioctl
+    232, // listxattr
+    102, // socketcall
+    166, // vm86
+    201, // geteuid32
+    13, // time
+    252, // exit_group
+    193, // truncate64
+    151, // munlock
+    336, // perf_event_open
+    129, // delete_module
+    365, // getsockopt
+    361, // bind
+    146, // writev
+    307, // faccessat
+    58, // ulimit
+    325, // timerfd_settime
+    284, // waitid
+    393, // semget
+    437, // openat2
+    143, // flock
+    366, // setsockopt
+    177, // rt_sigtimedwait
+    363, // listen
+    209, // getresuid32
+    82, // select
+    229, // getxattr
+    281, // mq_notify
+    140, // _llseek
+    46, // setgid
+    120, // clone
+    452, // fchmodat2
+};
+
+}
+
+const SyscallTable linux_i386_table = {
+    names, 463, hashDisplacements, hashSlots, 452,
+};
@@ -1,339 +1,1230 @@
 // This file is generated automatically. Any changes will be lost!
 #include "tables/linux_x86_64.hpp"
 
-const SyscallTable linux_x86_64_table = {
-    { "read", 0 },
-    { "write", 1 },
-    { "open", 2 },
-    { "close", 3 },
-    { "stat", 4 },
-    { "fstat", 5 },
-    { "lstat", 6 },
-    { "poll", 7 },
-    { "lseek", 8 },
-    { "mmap", 9 },
-    { "mprotect", 10 },
-    { "munmap", 11 },
-    { "brk", 12 },
-    { "rt_sigaction", 13 },
-    { "rt_sigprocmask", 14 },
-    { "rt_sigreturn", 15 },
-    { "ioctl", 16 },
-    { "pread", 17 },
-    { "pwrite", 18 },
-    { "readv", 19 },
-    { "writev", 20 },
-    { "access", 21 },
-    { "pipe", 22 },
-    { "select", 23 },
-    { "sched_yield", 24 },
-    { "mremap", 25 },
-    { "msync", 26 },
-    { "mincore", 27 },
-    { "madvise", 28 },
-    { "shmget", 29 },
-    { "shmat", 30 },
-    { "shmctl", 31 },
-    { "dup", 32 },
-    { "dup2", 33 },
-    { "pause", 34 },
-    { "nanosleep", 35 },
-    { "getitimer", 36 },
-    { "alarm", 37 },
-    { "setitimer", 38 },
-    { "getpid", 39 },
-    { "sendfile", 40 },
-    { "socket", 41 },
-    { "connect", 42 },
-    { "accept", 43 },
-    { "sendto", 44 },
-    { "recvfrom", 45 },
-    { "sendmsg", 46 },
-    { "recvmsg", 47 },
-    { "shutdown", 48 },
-    { "bind", 49 },
-    { "listen", 50 },
-    { "getsockname", 51 },
-    { "getpeername", 52 },
-    { "socketpair", 53 },
-    { "setsockopt", 54 },
-    { "getsockopt", 55 },
-    { "clone", 56 },
-    { "fork", 57 },
-    { "vfork", 58 },
-    { "execve", 59 },
-    { "exit", 60 },
-    { "wait4", 61 },
-    { "kill", 62 },
-    { "uname", 63 },
-    { "semget", 64 },
-    { "semop", 65 },
-    { "semctl", 66 },
-    { "shmdt", 67 },
-    { "msgget", 68 },
-    { "msgsnd", 69 },
-    { "msgrcv", 70 },
-    { "msgctl", 71 },
-    { "fcntl", 72 },
-    { "flock", 73 },
-    { "fsync", 74 },
-    { "fdatasync", 75 },
-    { "truncate", 76 },
-    { "ftruncate", 77 },
-    { "getdents", 78 },
-    { "getcwd", 79 },
-    { "chdir", 80 },
-    { "fchdir", 81 },
-    { "rename", 82 },
-    { "mkdir", 83 },
-    { "rmdir", 84 },
-    { "creat", 85 },
-    { "link", 86 },
-    { "unlink", 87 },
-    { "symlink", 88 },
-    { "readlink", 89 },
-    { "chmod", 90 },
-    { "fchmod", 91 },
-    { "chown", 92 },
-    { "fchown", 93 },
-    { "lchown", 94 },
-    { "umask", 95 },
-    { "gettimeofday", 96 },
-    { "getrlimit", 97 },
-    { "getrusage", 98 },
-    { "sysinfo", 99 },
-    { "times", 100 },
-    { "ptrace", 101 },
-    { "getuid", 102 },
-    { "syslog", 103 },
-    { "getgid", 104 },
-    { "setuid", 105 },
-    { "setgid", 106 },
-    { "geteuid", 107 },
-    { "getegid", 108 },
-    { "setpgid", 109 },
-    { "getppid", 110 },
-    { "getpgrp", 111 },
-    { "setsid", 112 },
-    { "setreuid", 113 },
-    { "setregid", 114 },
-    { "getgroups", 115 },
-    { "setgroups", 116 },
-    { "setresuid", 117 },
-    { "getresuid", 118 },
-    { "setresgid", 119 },
-    { "getresgid", 120 },
-    { "getpgid", 121 },
-    { "setfsuid", 122 },
-    { "setfsgid", 123 },
-    { "getsid", 124 },
-    { "capget", 125 },
-    { "capset", 126 },
-    { "rt_sigpending", 127 },
-    { "rt_sigtimedwait", 128 },
-    { "rt_sigqueueinfo", 129 },
-    { "rt_sigsuspend", 130 },
-    { "sigaltstack", 131 },
-    { "utime", 132 },
-    { "mknod", 133 },
-    { "uselib", 134 },
-    { "personality", 135 },
-    { "ustat", 136 },
-    { "statfs", 137 },
-    { "fstatfs", 138 },
-    { "sysfs", 139 },
-    { "getpriority", 140 },
-    { "setpriority", 141 },
-    { "sched_setparam", 142 },
-    { "sched_getparam", 143 },
-    { "sched_setscheduler", 144 },
-    { "sched_getscheduler", 145 },
-    { "sched_get_priority_max", 146 },
-    { "sched_get_priority_min", 147 },
-    { "sched_rr_get_interval", 148 },
-    { "mlock", 149 },
-    { "munlock", 150 },
-    { "mlockall", 151 },
-    { "munlockall", 152 },
-    { "vhangup", 153 },
-    { "modify_ldt", 154 },
-    { "pivot_root", 155 },
-    { "_sysctl", 156 },
-    { "prctl", 157 },
-    { "arch_prctl", 158 },
-    { "adjtimex", 159 },
-    { "setrlimit", 160 },
-    { "chroot", 161 },
-    { "sync", 162 },
-    { "acct", 163 },
-    { "settimeofday", 164 },
-    { "mount", 165 },
-    { "umount2", 166 },
-    { "swapon", 167 },
-    { "swapoff", 168 },
-    { "reboot", 169 },
-    { "sethostname", 170 },
-    { "setdomainname", 171 },
-    { "iopl", 172 },
-    { "ioperm", 173 },
-    { "create_module", 174 },
-    { "init_module", 175 },
-    { "delete_module", 176 },
-    { "get_kernel_syms", 177 },
-    { "query_module", 178 },
-    { "quotactl", 179 },
-    { "nfsservctl", 180 },
-    { "getpmsg", 181 },
-    { "putpmsg", 182 },
-    { "afs_syscall", 183 },
-    { "tuxcall", 184 },
-    { "security", 185 },
-    { "gettid", 186 },
-    { "readahead", 187 },
-    { "setxattr", 188 },
-    { "lsetxattr", 189 },
-    { "fsetxattr", 190 },
-    { "getxattr", 191 },
-    { "lgetxattr", 192 },
-    { "fgetxattr", 193 },
-    { "listxattr", 194 },
-    { "llistxattr", 195 },
-    { "flistxattr", 196 },
-    { "removexattr", 197 },
-    { "lremovexattr", 198 },
-    { "fremovexattr", 199 },
-    { "tkill", 200 },
-    { "time", 201 },
-    { "futex", 202 },
-    { "sched_setaffinity", 203 },
-    { "sched_getaffinity", 204 },
-    { "set_thread_area", 205 },
-    { "io_setup", 206 },
-    { "io_destroy", 207 },
-    { "io_getevents", 208 },
-    { "io_submit", 209 },
-    { "io_cancel", 210 },
-    { "get_thread_area", 211 },
-    { "lookup_dcookie", 212 },
-    { "epoll_create", 213 },
-    { "epoll_ctl_old", 214 },
-    { "epoll_wait_old", 215 },
-    { "remap_file_pages", 216 },
-    { "getdents64", 217 },
-    { "set_tid_address", 218 },
-    { "restart_syscall", 219 },
-    { "semtimedop", 220 },
-    { "fadvise64", 221 },
-    { "timer_create", 222 },
-    { "timer_settime", 223 },
-    { "timer_gettime", 224 },
-    { "timer_getoverrun", 225 },
-    { "timer_delete", 226 },
-    { "clock_settime", 227 },
-    { "clock_gettime", 228 },
-    { "clock_getres", 229 },
-    { "clock_nanosleep", 230 },
-    { "exit_group", 231 },
-    { "epoll_wait", 232 },
-    { "epoll_ctl", 233 },
-    { "tgkill", 234 },
-    { "utimes", 235 },
-    { "vserver", 236 },
-    { "mbind", 237 },
-    { "set_mempolicy", 238 },
-    { "get_mempolicy", 239 },
-    { "mq_open", 240 },
-    { "mq_unlink", 241 },
-    { "mq_timedsend", 242 },
-    { "mq_timedreceive", 243 },
-    { "mq_notify", 244 },
-    { "mq_getsetattr", 245 },
-    { "kexec_load", 246 },
-    { "waitid", 247 },
-    { "add_key", 248 },
-    { "request_key", 249 },
-    { "keyctl", 250 },
-    { "ioprio_set", 251 },
-    { "ioprio_get", 252 },
-    { "inotify_init", 253 },
-    { "inotify_add_watch", 254 },
-    { "inotify_rm_watch", 255 },
-    { "migrate_pages", 256 },
-    { "openat", 257 },
-    { "mkdirat", 258 },
-    { "mknodat", 259 },
-    { "fchownat", 260 },
-    { "futimesat", 261 },
-    { "newfstatat", 262 },
-    { "unlinkat", 263 },
-    { "renameat", 264 },
-    { "linkat", 265 },
-    { "symlinkat", 266 },
-    { "readlinkat", 267 },
-    { "fchmodat", 268 },
-    { "faccessat", 269 },
-    { "pselect6", 270 },
-    { "ppoll", 271 },
-    { "unshare", 272 },
-    { "set_robust_list", 273 },
-    { "get_robust_list", 274 },
-    { "splice", 275 },
-    { "tee", 276 },
-    { "sync_file_range", 277 },
-    { "vmsplice", 278 },
-    { "move_pages", 279 },
-    { "utimensat", 280 },
-    { "epoll_pwait", 281 },
-    { "signalfd", 282 },
-    { "timerfd", 283 },
-    { "eventfd", 284 },
-    { "fallocate", 285 },
-    { "timerfd_settime", 286 },
-    { "timerfd_gettime", 287 },
-    { "accept4", 288 },
-    { "signalfd4", 289 },
-    { "eventfd2", 290 },
-    { "epoll_create1", 291 },
-    { "dup3", 292 },
-    { "pipe2", 293 },
-    { "inotify_init1", 294 },
-    { "preadv", 295 },
-    { "pwritev", 296 },
-    { "rt_tgsigqueueinfo", 297 },
-    { "perf_event_open", 298 },
-    { "recvmmsg", 299 },
-    { "fanotify_init", 300 },
-    { "fanotify_mark", 301 },
-    { "prlimit64", 302 },
-    { "name_to_handle_at", 303 },
-    { "open_by_handle_at", 304 },
-    { "clock_adjtime", 305 },
-    { "syncfs", 306 },
-    { "sendmmsg", 307 },
-    { "setns", 308 },
-    { "getcpu", 309 },
-    { "process_vm_readv", 310 },
-    { "process_vm_writev", 311 },
-    { "kcmp", 312 },
-    { "finit_module", 313 },
-    { "sched_setattr", 314 },
-    { "sched_getattr", 315 },
-    { "renameat2", 316 },
-    { "seccomp", 317 },
-    { "getrandom", 318 },
-    { "memfd_create", 319 },
-    { "kexec_file_load", 320 },
-    { "bpf", 321 },
-    { "execveat", 322 },
-    { "userfaultfd", 323 },
-    { "membarrier", 324 },
-    { "mlock2", 325 },
-    { "copy_file_range", 326 },
-    { "preadv2", 327 },
-    { "pwritev2", 328 },
-    { "pkey_mprotect", 329 },
-    { "pkey_alloc", 330 },
-    { "pkey_free", 331 },
-    { "statx", 332 },
+namespace {
+
+constexpr const char *names[] = {
+    "read",
+    "write",
+    "open",
+    "close",
+    "stat",
+    "fstat",
+    "lstat",
+    "poll",
+    "lseek",
+    "mmap",
+    "mprotect",
+    "munmap",
+    "brk",
+    "rt_sigaction",
+    "rt_sigprocmask",
+    "rt_sigreturn",
+    "ioctl",
+    "pread",
+    "pwrite",
+    "readv",
+    "writev",
+    "access",
+    "pipe",
+    "select",
+    "sched_yield",
+    "mremap",
+    "msync",
+    "mincore",
+    "madvise",
+    "shmget",
+    "shmat",
+    "shmctl",
+    "dup",
+    "dup2",
+    "pause",
+    "nanosleep",
+    "getitimer",
+    "alarm",
+    "setitimer",
+    "getpid",
+    "sendfile",
+    "socket",
+    "connect",
+    "accept",
+    "sendto",
+    "recvfrom",
+    "sendmsg",
+    "recvmsg",
+    "shutdown",
+    "bind",
+    "listen",
+    "getsockname",
+    "getpeername",
+    "socketpair",
+    "setsockopt",
+    "getsockopt",
+    "clone",
+    "fork",
+    "vfork",
+    "execve",
+    "exit",
+    "wait4",
+    "kill",
+    "uname",
+    "semget",
+    "semop",
+    "semctl",
+    "shmdt",
+    "msgget",
+    "msgsnd",
+    "msgrcv",
+    "msgctl",
+    "fcntl",
+    "flock",
+    "fsync",
+    "fdatasync",
+    "truncate",
+    "ftruncate",
+    "getdents",
+    "getcwd",
+    "chdir",
+    "fchdir",
+    "rename",
+    "mkdir",
+    "rmdir",
+    "creat",
+    "link",
+    "unlink",
+    "symlink",
+    "readlink",
+    "chmod",
+    "fchmod",
+    "chown",
+    "fchown",
+    "lchown",
+    "umask",
+    "gettimeofday",
+    "getrlimit",
+    "getrusage",
+    "sysinfo",
+    "times",
+    "ptrace",
+    "getuid",
+    "syslog",
+    "getgid",
+    "setuid",
+    "setgid",
+    "geteuid",
+    "getegid",
+    "setpgid",
+    "getppid",
+    "getpgrp",
+    "setsid",
+    "setreuid",
+    "setregid",
+    "getgroups",
+    "setgroups",
+    "setresuid",
+    "getresuid",
+    "setresgid",
+    "getresgid",
+    "getpgid",
+    "setfsuid",
+    "setfsgid",
+    "getsid",
+    "capget",
+    "capset",
+    "rt_sigpending",
+    "rt_sigtimedwait",
+    "rt_sigqueueinfo",
+    "rt_sigsuspend",
+    "sigaltstack",
+    "utime",
+    "mknod",
+    "uselib",
+    "personality",
+    "ustat",
+    "statfs",
+    "fstatfs",
+    "sysfs",
+    "getpriority",
+    "setpriority",
+    "sched_setparam",
+    "sched_getparam",
+    "sched_setscheduler",
+    "sched_getscheduler",
+    "sched_get_priority_max",
+    "sched_get_priority_min",
+    "sched_rr_get_interval",
+    "mlock",
+    "munlock",
+    "mlockall",
+    "munlockall",
+    "vhangup",
+    "modify_ldt",
+    "pivot_root",
+    "_sysctl",
+    "prctl",
+    "arch_prctl",
+    "adjtimex",
+    "setrlimit",
+    "chroot",
+    "sync",
+    "acct",
+    "settimeofday",
+    "mount",
+    "umount2",
+    "swapon",
+    "swapoff",
+    "reboot",
+    "sethostname",
+    "setdomainname",
+    "iopl",
+    "ioperm",
+    "create_module",
+    "init_module",
+    "delete_module",
+    "get_kernel_syms",
+    "query_module",
+    "quotactl",
+    "nfsservctl",
+    "getpmsg",
+    "putpmsg",
+    "afs_syscall",
+    "tuxcall",
+    "security",
+    "gettid",
+    "readahead",
+    "setxattr",
+    "lsetxattr",
+    "fsetxattr",
+    "getxattr",
+    "lgetxattr",
+    "fgetxattr",
+    "listxattr",
+    "llistxattr",
+    "flistxattr",
+    "removexattr",
+    "lremovexattr",
+    "fremovexattr",
+    "tkill",
+    "time",
+    "futex",
+    "sched_setaffinity",
+    "sched_getaffinity",
+    "set_thread_area",
+    "io_setup",
+    "io_destroy",
+    "io_getevents",
+    "io_submit",
+    "io_cancel",
+    "get_thread_area",
+    "lookup_dcookie",
+    "epoll_create",
+    "epoll_ctl_old",
+    "epoll_wait_old",
+    "remap_file_pages",
+    "getdents64",
+    "set_tid_address",
+    "restart_syscall",
+    "semtimedop",
+    "fadvise64",
+    "timer_create",
+    "timer_settime",
+    "timer_gettime",
+    "timer_getoverrun",
+    "timer_delete",
+    "clock_settime",
+    "clock_gettime",
+    "clock_getres",
+    "clock_nanosleep",
+    "exit_group",
+    "epoll_wait",
+    "epoll_ctl",
+    "tgkill",
+    "utimes",
+    "vserver",
+    "mbind",
+    "set_mempolicy",
+    "get_mempolicy",
+    "mq_open",
+    "mq_unlink",
+    "mq_timedsend",
+    "mq_timedreceive",
+    "mq_notify",
+    "mq_getsetattr",
+    "kexec_load",
+    "waitid",
+    "add_key",
+    "request_key",
+    "keyctl",
+    "ioprio_set",
+    "ioprio_get",
+    "inotify_init",
+    "inotify_add_watch",
+    "inotify_rm_watch",
+    "migrate_pages",
+    "openat",
+    "mkdirat",
+    "mknodat",
+    "fchownat",
+    "futimesat",
+    "newfstatat",
+    "unlinkat",
+    "renameat",
+    "linkat",
+    "symlinkat",
+    "readlinkat",
+    "fchmodat",
+    "faccessat",
+    "pselect6",
+    "ppoll",
+    "unshare",
+    "set_robust_list",
+    "get_robust_list",
+    "splice",
+    "tee",
+    "sync_file_range",
+    "vmsplice",
+    "move_pages",
+    "utimensat",
+    "epoll_pwait",
+    "signalfd",
+    "timerfd",
+    "eventfd",
+    "fallocate",
+    "timerfd_settime",
+    "timerfd_gettime",
+    "accept4",
+    "signalfd4",
+    "eventfd2",
+    "epoll_create1",
+    "dup3",
+    "pipe2",
+    "inotify_init1",
+    "preadv",
+    "pwritev",
+    "rt_tgsigqueueinfo",
+    "perf_event_open",
+    "recvmmsg",
+    "fanotify_init",
+    "fanotify_mark",
+    "prlimit64",
+    "name_to_handle_at",
+    "open_by_handle_at",
+    "clock_adjtime",
+    "syncfs",
+    "sendmmsg",
+    "setns",
+    "getcpu",
+    "process_vm_readv",
+    "process_vm_writev",
+    "kcmp",
+    "finit_module",
+    "sched_setattr",
+    "sched_getattr",
+    "renameat2",
+    "seccomp",
+    "getrandom",
+    "memfd_create",
+    "kexec_file_load",
+    "bpf",
+    "execveat",
+    "userfaultfd",
+    "membarrier",
+    "mlock2",
+    "copy_file_range",
+    "preadv2",
+    "pwritev2",
+    "pkey_mprotect",
+    "pkey_alloc",
+    "pkey_free",
+    "statx",
+    "io_pgetevents",
+    "rseq",
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    "pidfd_send_signal",
+    "io_uring_setup",
+    "io_uring_enter",
+    "io_uring_register",
+    "open_tree",
+    "move_mount",
+    "fsopen",
+    "fsconfig",
+    "fsmount",
+    "fspick",
+    "pidfd_open",
+    "clone3",
+    "close_range",
+    "openat2",
+    "pidfd_getfd",
+    "faccessat2",
+    "process_madvise",
+    "epoll_pwait2",
+    "mount_setattr",
+    "quotactl_fd",
+    "landlock_create_ruleset",
+    "landlock_add_rule",
+    "landlock_restrict_self",
+    "memfd_secret",
+    "process_mrelease",
+    "futex_waitv",
+    "set_mempolicy_home_node",
+    "cachestat",
+    "fchmodat2",
+    "map_shadow_stack",
+    "futex_wake",
+    "futex_wait",
+    "futex_requeue",
+    "statmount",
+    "listmount",
+    "lsm_get_self_attr",
+    "lsm_set_self_attr",
+    "lsm_list_modules",
+    "mseal",
 };
 
+constexpr int32_t hashDisplacements[] = {
+    0,
+    1,
+    1,
+    0,
+    1,
+    -373,
+    0,
+    1,
+    -371,
+    0,
+    2,
+    -367,
+    1,
+    1,
+    0,
+    0,
+    0,
+    0,
+    1,
+    0,
+    1,
+    1,
+    -363,
+    -358,
+    0,
+    3,
+    3,
+    -355,
+    0,
+    0,
+    1,
+    -352,
+    2,
+    1,
+    -350,
+    1,
+    0,
+    -348,
+    -347,
+    0,
+    0,
+    -346,
+    0,
+    -345,
+    0,
+    0,
+    0,
+    4,
+    0,
+    1,
+    0,
+    -339,
+    2,
+    1,
+    0,
+    1,
+    -338,
+    -332,
+    -331,
+    0,
+    1,
+    0,
+    -329,
+    1,
+    0,
+    0,
+    0,
+    1,
+    2,
+    1,
+    0,
+    0,
+    7,
+    0,
+    3,
+    2,
+    0,
+    1,
+    -328,
+    -325,
+    1,
+    -324,
+    -321,
+    0,
+    -319,
+    -318,
+    0,
+    -314,
+    4,
+    -313,
+    1,
+    8,
+    0,
+    2,
+    1,
+    1,
+    0,
+    2,
+    0,
+    0,
+    -308,
+    -307,
+    0,
+    0,
+    0,
+    0,
+    3,
+    0,
+    -304,
+    2,
+    -303,
+    -300,
+    1,
+    0,
+    4,
+    0,
+    0,
+    0,
+    -296,
+    -295,
+    1,
+    0,
+    -291,
+    3,
+    1,
+    0,
+    -289,
+    0,
+    0,
+    4,
+    -287,
+    -282,
+    1,
+    -269,
+    -266,
+    1,
+    1,
+    0,
+    -265,
+    1,
+    2,
+    0,
+    0,
+    -264,
+    1,
+    0,
+    0,
+    0,
+    6,
+    1,
+    -263,
+    2,
+    -258,
+    0,
+    0,
+    -256,
+    -255,
+    -253,
+    -249,
+    -248,
+    -247,
+    1,
+    1,
+    0,
+    0,
+    -243,
+    7,
+    -242,
+    0,
+    1,
+    3,
+    -240,
+    1,
+    0,
+    0,
+    0,
+    -238,
+    2,
+    -230,
+    -228,
+    -226,
+    -224,
+    0,
+    -219,
+    -216,
+    -213,
+    1,
+    1,
+    -212,
+    0,
+    4,
+    1,
+    -209,
+    -203,
+    -200,
+    0,
+    0,
+    17,
+    0,
+    -197,
+    -194,
+    -193,
+    -192,
+    0,
+    2,
+    4,
+    0,
+    0,
+    1,
+    13,
+    0,
+    0,
+    0,
+    3,
+    -190,
+    -188,
+    0,
+    -185,
+    0,
+    7,
+    0,
+    0,
+    -183,
+    2,
+    0,
+    -182,
+    0,
+    -179,
+    0,
+    0,
+    1,
+    2,
+    0,
+    3,
+    0,
+    0,
+    6,
+    0,
+    -175,
+    -174,
+    0,
+    0,
+    -173,
+    -172,
+    -170,
+    -164,
+    -159,
+    -158,
+    1,
+    0,
+    3,
+    0,
+    -154,
+    -150,
+    -147,
+    -145,
+    1,
+    1,
+    0,
+    0,
+    0,
+    -144,
+    0,
+    -134,
+    0,
+    0,
+    -132,
+    -131,
+    0,
+    -128,
+    0,
+    -126,
+    -123,
+    0,
+    0,
+    1,
+    0,
+    0,
+    -119,
+    -118,
+    -117,
+    -116,
+    0,
+    -115,
+    -113,
+    0,
+    0,
+    0,
+    4,
+    2,
+    -112,
+    0,
+    -110,
+    -107,
+    0,
+    0,
+    1,
+    4,
+    -104,
+    2,
+    -102,
+    -101,
+    5,
+    0,
+    3,
+    0,
+    0,
+    0,
+    -94,
+    0,
+    1,
+    0,
+    -93,
+    -89,
+    -81,
+    -79,
+    -78,
+    -76,
+    0,
+    9,
+    -75,
+    -74,
+    0,
+    4,
+    -65,
+    -63,
+    0,
+    0,
+    -59,
+    0,
+    -58,
+    0,
+    2,
+    -57,
+    0,
+    0,
+    0,
+    8,
+    0,
+    -56,
+    -54,
+    0,
+    -53,
+    0,
+    -36,
+    -34,
+    -33,
+    0,
+    11,
+    -30,
+    -29,
+    0,
+    2,
+    3,
+    0,
+    0,
+    -27,
+    0,
+    0,
+    16,
+    -24,
+    11,
+    0,
+    9,
+    5,
+    16,
+    -21,
+    -16,
+    -12,
+    1,
+    -8,
+    -4,
+    2,
+    0,
+};
+
+constexpr int16_t hashSlots[] = {
+    17, // pread
+    438, // pidfd_getfd
+    322, // execveat
+    320, // kexec_file_load
+    431, // fsconfig
+    134, // uselib
+    207, // io_destroy
+    273, // set_robust_list
+    92, // chown
+    215, // epoll_wait_old
+    199, // fremovexattr
+    133, // mknod
+    314, // sched_setattr
+    462, // mseal
+    157, // prctl
+    206, // io_setup
+    284, // eventfd
+    125, // capget
+    181, // getpmsg
+    104, // getgid
+    197, // removexattr
+    327, // preadv2
+    27, // mincore
+    33, // dup2
+    187, // readahead
+    279, // move_pages
+    190, // fsetxattr
+    311, // process_vm_writev
+    155, // pivot_root
+    295, // preadv
+    205, // set_thread_area
+    140, // getpriority
+    18, // pwrite
+    447, // memfd_secret
+    271, // ppoll
+    201, // time
+    221, // fadvise64
+    308, // setns
+    182, // putpmsg
+    242, // mq_timedsend
+    99, // sysinfo
+    174, // create_module
+    448, // process_mrelease
+    84, // rmdir
+    212, // lookup_dcookie
+    121, // getpgid
+    64, // semget
+    13, // rt_sigaction
+    69, // msgsnd
+    59, // execve
+    159, // adjtimex
+    446, // landlock_restrict_self
+    267, // readlinkat
+    110, // getppid
+    266, // symlinkat
+    173, // ioperm
+    258, // mkdirat
+    20, // writev
+    171, // setdomainname
+    88, // symlink
+    278, // vmsplice
+    170, // sethostname
+    435, // clone3
+    21, // access
+    136, // ustat
+    26, // msync
+    256, // migrate_pages
+    128, // rt_sigtimedwait
+    47, // recvmsg
+    277, // sync_file_range
+    249, // request_key
+    180, // nfsservctl
+    175, // init_module
+    255, // inotify_rm_watch
+    97, // getrlimit
+    204, // sched_getaffinity
+    168, // swapoff
+    24, // sched_yield
+    62, // kill
+    123, // setfsgid
+    220, // semtimedop
+    130, // rt_sigsuspend
+    149, // mlock
+    2, // open
+    263, // unlinkat
+    191, // getxattr
+    265, // linkat
+    245, // mq_getsetattr
+    222, // timer_create
+    152, // munlockall
+    142, // sched_setparam
+    325, // mlock2
+    313, // finit_module
+    107, // geteuid
+    91, // fchmod
+    275, // splice
+    444, // landlock_create_ruleset
+    269, // faccessat
+    58, // vfork
+    443, // quotactl_fd
+    4, // stat
+    154, // modify_ldt
+    131, // sigaltstack
+    72, // fcntl
+    101, // ptrace
+    426, // io_uring_enter
+    77, // ftruncate
+    162, // sync
+    316, // renameat2
+    93, // fchown
+    429, // move_mount
+    439, // faccessat2
+    179, // quotactl
+    35, // nanosleep
+    238, // set_mempolicy
+    239, // get_mempolicy
+    195, // llistxattr
+    459, // lsm_get_self_attr
+    226, // timer_delete
+    22, // pipe
+    113, // setreuid
+    333, // io_pgetevents
+    143, // sched_getparam
+    321, // bpf
+    216, // remap_file_pages
+    309, // getcpu
+    211, // get_thread_area
+    254, // inotify_add_watch
+    148, // sched_rr_get_interval
+    200, // tkill
+    63, // uname
+    52, // getpeername
+    95, // umask
+    329, // pkey_mprotect
+    81, // fchdir
+    268, // fchmodat
+    272, // unshare
+    141, // setpriority
+    94, // lchown
+    7, // poll
+    225, // timer_getoverrun
+    433, // fspick
+    194, // listxattr
+    34, // pause
+    280, // utimensat
+    172, // iopl
+    315, // sched_getattr
+    288, // accept4
+    234, // tgkill
+    260, // fchownat
+    118, // getresuid
+    116, // setgroups
+    442, // mount_setattr
+    456, // futex_requeue
+    122, // setfsuid
+    243, // mq_timedreceive
+    103, // syslog
+    297, // rt_tgsigqueueinfo
+    458, // listmount
+    287, // timerfd_gettime
+    219, // restart_syscall
+    73, // flock
+    324, // membarrier
+    112, // setsid
+    203, // sched_setaffinity
+    301, // fanotify_mark
+    38, // setitimer
+    436, // close_range
+    445, // landlock_add_rule
+    223, // timer_settime
+    251, // ioprio_set
+    6, // lstat
+    32, // dup
+    250, // keyctl
+    430, // fsopen
+    71, // msgctl
+    68, // msgget
+    49, // bind
+    147, // sched_get_priority_min
+    60, // exit
+    248, // add_key
+    80, // chdir
+    428, // open_tree
+    164, // settimeofday
+    232, // epoll_wait
+    67, // shmdt
+    124, // getsid
+    259, // mknodat
+    108, // getegid
+    300, // fanotify_init
+    257, // openat
+    151, // mlockall
+    276, // tee
+    330, // pkey_alloc
+    31, // shmctl
+    74, // fsync
+    158, // arch_prctl
+    307, // sendmmsg
+    304, // open_by_handle_at
+    461, // lsm_list_modules
+    135, // personality
+    169, // reboot
+    119, // setresgid
+    120, // getresgid
+    202, // futex
+    244, // mq_notify
+    302, // prlimit64
+    331, // pkey_free
+    192, // lgetxattr
+    53, // socketpair
+    440, // process_madvise
+    98, // getrusage
+    66, // semctl
+    270, // pselect6
+    161, // chroot
+    184, // tuxcall
+    290, // eventfd2
+    310, // process_vm_readv
+    23, // select
+    96, // gettimeofday
+    188, // setxattr
+    105, // setuid
+    214, // epoll_ctl_old
+    317, // seccomp
+    318, // getrandom
+    61, // wait4
+    246, // kexec_load
+    294, // inotify_init1
+    12, // brk
+    55, // getsockopt
+    176, // delete_module
+    236, // vserver
+    224, // timer_gettime
+    282, // signalfd
+    289, // signalfd4
+    208, // io_getevents
+    235, // utimes
+    165, // mount
+    424, // pidfd_send_signal
+    78, // getdents
+    196, // flistxattr
+    303, // name_to_handle_at
+    167, // swapon
+    109, // setpgid
+    230, // clock_nanosleep
+    432, // fsmount
+    1, // write
+    8, // lseek
+    298, // perf_event_open
+    292, // dup3
+    19, // readv
+    293, // pipe2
+    57, // fork
+    42, // connect
+    210, // io_cancel
+    11, // munmap
+    14, // rt_sigprocmask
+    262, // newfstatat
+    41, // socket
+    115, // getgroups
+    65, // semop
+    241, // mq_unlink
+    264, // renameat
+    76, // truncate
+    328, // pwritev2
+    163, // acct
+    323, // userfaultfd
+    137, // statfs
+    425, // io_uring_setup
+    227, // clock_settime
+    0, // read
+    183, // afs_syscall
+    178, // query_module
+    319, // memfd_create
+    305, // clock_adjtime
+    332, // statx
+    150, // munlock
+    326, // copy_file_range
+    129, // rt_sigqueueinfo
+    43, // accept
+    40, // sendfile
+    79, // getcwd
+    51, // getsockname
+    334, // rseq
+    253, // inotify_init
+    111, // getpgrp
+    39, // getpid
+    291, // epoll_create1
+    90, // chmod
+    87, // unlink
+    56, // clone
+    117, // setresuid
+    286, // timerfd_settime
+    144, // sched_setscheduler
+    228, // clock_gettime
+    160, // setrlimit
+    449, // futex_waitv
+    48, // shutdown
+    457, // statmount
+    166, // umount2
+    209, // io_submit
+    299, // recvmmsg
+    145, // sched_getscheduler
+    138, // fstatfs
+    281, // epoll_pwait
+    54, // setsockopt
+    460, // lsm_set_self_attr
+    252, // ioprio_get
+    114, // setregid
+    15, // rt_sigreturn
+    85, // creat
+    451, // cachestat
+    132, // utime
+    102, // getuid
+    274, // get_robust_list
+    5, // fstat
+    83, // mkdir
+    217, // getdents64
+    285, // fallocate
+    229, // clock_getres
+    46, // sendmsg
+    247, // waitid
+    296, // pwritev
+    306, // syncfs
+    45, // recvfrom
+    189, // lsetxattr
+    283, // timerfd
+    450, // set_mempolicy_home_node
+    218, // set_tid_address
+    186, // gettid
+    30, // shmat
+    10, // mprotect
+    434, // pidfd_open
+    437, // openat2
+    37, // alarm
+    9, // mmap
+    237, // mbind
+    198, // lremovexattr
+    261, // futimesat
+    126, // capset
+    36, // getitimer
+    82, // rename
+    70, // msgrcv
+    185, // security
+    100, // times
+    139, // sysfs
+    16, // ioctl
+    29, // shmget
+    50, // listen
+    153, // vhangup
+    193, // fgetxattr
+    3, // close
+    455, // futex_wait
+    156, // _sysctl
+    89, // readlink
+    86, // link
+    312, // kcmp
+    231, // exit_group
+    75, // fdatasync
+    427, // io_uring_register
+    28, // madvise
+    127, // rt_sigpending
+    240, // mq_open
+    441, // epoll_pwait2
+    233, // epoll_ctl
+    146, // sched_get_priority_max
+    452, // fchmodat2
+    44, // sendto
+    454, // futex_wake
+    453, // map_shadow_stack
+    177, // get_kernel_syms
+    213, // epoll_create
+    25, // mremap
+    106, // setgid
+};
+
+}
+
+const SyscallTable linux_x86_64_table = {
+    names, 463, hashDisplacements, hashSlots, 374,
+};